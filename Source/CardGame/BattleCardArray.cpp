@@ -0,0 +1,78 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "BattleCardArray.h"
+
+void FBattleCardArray::AddCard(int32 PlayerId, int32 CardValue)
+{
+	FBattleCardItem& Item = Items.AddDefaulted_GetRef();
+	Item.PlayerId = (uint8)PlayerId;
+	Item.CardValue = (uint8)CardValue;
+	MarkItemDirty(Item);
+}
+
+bool FBattleCardArray::RemoveCard(int32 CardValue)
+{
+	const int32 Index = Items.IndexOfByPredicate([CardValue](const FBattleCardItem& Item) { return Item.CardValue == CardValue; });
+	if (Index == INDEX_NONE)
+	{
+		return false;
+	}
+
+	// 刪除時不保留順序，只送出一個刪除項目
+	Items.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	MarkArrayDirty();
+	return true;
+}
+
+void FBattleCardArray::ResetCards()
+{
+	if (Items.Num() > 0)
+	{
+		Items.Reset();
+		MarkArrayDirty();
+	}
+}
+
+void FBattleCardArray::SyncHand(int32 PlayerId, const FCardHand& Hand)
+{
+	const uint32 Current = GetHand().GetBits();
+	const uint32 Target = Hand.GetBits();
+
+	// 先刪除已打出的牌，再加入新拿到的牌
+	for (uint32 Removed = Current & ~Target; Removed != 0; Removed &= Removed - 1u)
+	{
+		RemoveCard((int32)FMath::CountTrailingZeros(Removed));
+	}
+
+	for (uint32 Added = Target & ~Current; Added != 0; Added &= Added - 1u)
+	{
+		AddCard(PlayerId, (int32)FMath::CountTrailingZeros(Added));
+	}
+}
+
+FCardHand FBattleCardArray::GetHand() const
+{
+	FCardHand Hand;
+	for (const FBattleCardItem& Item : Items)
+	{
+		Hand.Add(Item.CardValue);
+	}
+	return Hand;
+}
+
+void FBattleCardArray::GetCards(int32 PlayerId, TArray<FCard>& OutCards) const
+{
+	OutCards.Reset();
+	for (const FBattleCardItem& Item : Items)
+	{
+		if (PlayerId == INDEX_NONE || Item.PlayerId == PlayerId)
+		{
+			OutCards.Add(FCard(Item.CardValue));
+		}
+	}
+}
+
+void FBattleCardArray::PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters)
+{
+	ReplicatedEvent.Broadcast();
+}
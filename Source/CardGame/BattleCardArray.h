@@ -0,0 +1,82 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Net/Serialization/FastArraySerializer.h"
+#include "Card.h"
+#include "Sim/CardHand.h"
+#include "BattleCardArray.generated.h"
+
+/**
+ * FBattleCardItem - 複製陣列中的一張牌
+ */
+USTRUCT()
+struct FBattleCardItem : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	// 出牌的玩家 (手牌中為持有者)
+	UPROPERTY()
+	uint8 PlayerId = 0;
+
+	UPROPERTY()
+	uint8 CardValue = 0;
+};
+
+/**
+ * FBattleCardArray - 以 FFastArraySerializer 複製的卡牌列表 (手牌或出牌歷史)
+ * 每次出牌只會送出一個新增或刪除的項目，不會重送整個陣列。
+ * 客戶端每收到一批變更廣播一次 OnReplicated。
+ */
+USTRUCT()
+struct CARDGAME_API FBattleCardArray : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	// 加入一張牌 (伺服器)
+	void AddCard(int32 PlayerId, int32 CardValue);
+
+	// 移除一張牌，回傳是否存在 (伺服器)
+	bool RemoveCard(int32 CardValue);
+
+	// 清空 (伺服器)
+	void ResetCards();
+
+	// 與規則核心的手牌同步，只新增或刪除有差異的牌 (伺服器)
+	void SyncHand(int32 PlayerId, const FCardHand& Hand);
+
+	// 以位元遮罩取得所有牌 (手牌顯示時依 CardValue 排序)
+	FCardHand GetHand() const;
+
+	// 依加入順序取得某位玩家的牌 (PlayerId 為 INDEX_NONE 時取得全部)
+	void GetCards(int32 PlayerId, TArray<FCard>& OutCards) const;
+
+	int32 Num() const { return Items.Num(); }
+
+	// 客戶端收到變更後
+	FSimpleMulticastDelegate& OnReplicated() { return ReplicatedEvent; }
+
+	// FFastArraySerializer
+	void PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters);
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FBattleCardItem, FBattleCardArray>(Items, DeltaParms, *this);
+	}
+
+private:
+	UPROPERTY()
+	TArray<FBattleCardItem> Items;
+
+	FSimpleMulticastDelegate ReplicatedEvent;
+};
+
+template<>
+struct TStructOpsTypeTraits<FBattleCardArray> : public TStructOpsTypeTraitsBase2<FBattleCardArray>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
@@ -12,7 +12,7 @@ UBattlePlayer::UBattlePlayer()
 void UBattlePlayer::Initialize(int32 PlayerId)
 {
 	PlayerID = PlayerId;
-	Hand.Empty();
+	Hand.Reset();
 	Score = 0;
 }
 
@@ -28,28 +28,29 @@ void UBattlePlayer::DrawCardsToHand(int32 NumberOfCards)
 		return;
 	}
 
-	TArray<FCard> DrawnCards;
-	Deck->DrawCards(NumberOfCards, DrawnCards);
-	Hand.Append(DrawnCards);
+	for (const FCard& Card : Deck->DrawCards(NumberOfCards))
+	{
+		Hand.Add(Card.CardValue);
+	}
 }
 
-FCard UBattlePlayer::PlayCard(int32 CardIndex)
+void UBattlePlayer::GetOrderedHand(TArray<FCard>& OutCards) const
 {
-	if (CardIndex >= 0 && CardIndex < Hand.Num())
-	{
-		FCard PlayedCard = Hand[CardIndex];
-		Hand.RemoveAt(CardIndex);
-		return PlayedCard;
-	}
+	OutCards.SetNumUninitialized(Hand.Num());
+	Hand.CopyTo(OutCards.GetData());
+}
 
-	return FCard(0);
+FCard UBattlePlayer::PlayCard(int32 CardIndex)
+{
+	// 超出範圍時回傳無效牌
+	return Hand.RemoveAt(CardIndex);
 }
 
-FCard UBattlePlayer::PlayCardRandom()
+FCard UBattlePlayer::PlayCardRandom(FRandomStream& Random)
 {
-	if (Hand.Num() > 0)
+	if (!Hand.IsEmpty())
 	{
-		int32 RandomIndex = FMath::RandRange(0, Hand.Num() - 1);
+		int32 RandomIndex = Random.RandRange(0, Hand.Num() - 1);
 		return PlayCard(RandomIndex);
 	}
 
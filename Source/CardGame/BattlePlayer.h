@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
 #include "Card.h"
+#include "Sim/CardHand.h"
 #include "BattlePlayer.generated.h"
 
 /**
@@ -27,17 +28,23 @@ public:
 	// 設置玩家的牌組
 	void SetDeck(UCardDeck* InDeck);
 
-	// 獲取手牌
-	const TArray<FCard>& GetHand() const { return Hand; }
+	// 獲取手牌 (位元遮罩，依 CardValue 排序)
+	const FCardHand& GetHand() const { return Hand; }
+
+	// 依排序寫出手牌 (UI 顯示用)
+	void GetOrderedHand(TArray<FCard>& OutCards) const;
+
+	// 是否持有該牌
+	bool HasCard(int32 CardValue) const { return Hand.Contains(CardValue); }
 
 	// 從牌組抽牌到手牌
 	void DrawCardsToHand(int32 NumberOfCards);
 
-	// 出牌 - 根據索引從手牌中移除並返回該卡牌
+	// 出牌 - 根據排序後的索引從手牌中移除並返回該卡牌
 	FCard PlayCard(int32 CardIndex);
 
-	// 隨機出牌 - 系統自動從手牌隨機選擇一張
-	FCard PlayCardRandom();
+	// 隨機出牌 - 系統自動從手牌隨機選擇一張 (使用對戰的亂數流)
+	FCard PlayCardRandom(FRandomStream& Random);
 
 	// 獲取手牌數量
 	int32 GetHandSize() const { return Hand.Num(); }
@@ -52,7 +59,7 @@ public:
 	void ResetScore() { Score = 0; }
 
 	// 檢查是否還有手牌
-	bool HasCards() const { return Hand.Num() > 0; }
+	bool HasCards() const { return !Hand.IsEmpty(); }
 
 private:
 	// 玩家ID (0 或 1)
@@ -63,7 +70,7 @@ private:
 	UCardDeck* Deck;
 
 	// 玩家的手牌
-	TArray<FCard> Hand;
+	FCardHand Hand;
 
 	// 玩家的累計分數
 	int32 Score;
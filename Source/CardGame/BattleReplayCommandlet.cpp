@@ -0,0 +1,111 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "BattleReplayCommandlet.h"
+#include "Sim/BattleReplay.h"
+#include "Sim/BattleTournament.h"
+#include "Engine/DataTable.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+
+UBattleReplayCommandlet::UBattleReplayCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UBattleReplayCommandlet::Main(const FString& Params)
+{
+	int32 NumGenerate = 0;
+	FParse::Value(*Params, TEXT("Generate="), NumGenerate);
+
+	// 產生的模擬對戰寫到獨立的檔案，不能覆寫 ACardBattle 持續附加的實際對戰紀錄
+	FString FilePath = NumGenerate > 0
+		? FPaths::ProjectSavedDir() / TEXT("Replays") / FString::Printf(TEXT("Generated_%s.cardreplay"), *FDateTime::Now().ToString())
+		: FBattleReplay::GetDefaultArchivePath();
+	FParse::Value(*Params, TEXT("File="), FilePath);
+
+	FString TablePath(TEXT("/Game/DataTable/DT_CardData.DT_CardData"));
+	FParse::Value(*Params, TEXT("Table="), TablePath);
+
+	// 與 ACardBattle 相同的牌組與 Power 表
+	FBattleTournamentSettings Settings;
+	if (const UDataTable* DataTable = LoadObject<UDataTable>(nullptr, *TablePath))
+	{
+		FBattleTournament::ConfigureFromDataTable(Settings, DataTable);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("BattleReplay: Could not load DataTable '%s', using default cards"), *TablePath);
+	}
+
+	if (Settings.DeckCards.Num() == 0)
+	{
+		FBattleSimCore::GetDefaultDeck(Settings.DeckCards);
+	}
+
+	if (NumGenerate > 0)
+	{
+		if (FPaths::IsSamePath(FilePath, FBattleReplay::GetDefaultArchivePath()))
+		{
+			UE_LOG(LogTemp, Error, TEXT("BattleReplay: -Generate would overwrite the match archive '%s', pass a different -File"), *FilePath);
+			return 1;
+		}
+
+		int32 Seed = 0;
+		FParse::Value(*Params, TEXT("Seed="), Seed);
+
+		// 每局的種子由主亂數流產生，出牌使用該局種子之後的亂數
+		FRandomStream SeedStream(Seed);
+		FBattleSimCore Game = Settings.Prototype;
+		FBattleReplay Replay;
+		TArray<uint8> Data;
+		Data.Reserve(NumGenerate * 32);
+
+		for (int32 GameIndex = 0; GameIndex < NumGenerate; ++GameIndex)
+		{
+			const int32 GameSeed = SeedStream.RandHelper(MAX_int32 - 1) + 1;
+			FRandomStream Random(GameSeed);
+			Game.Reset();
+			Game.DealHands(Settings.DeckCards, Random);
+			Game.Start(Random.RandRange(0, 1));
+
+			Replay.Reset(GameSeed);
+			while (Game.IsWaitingForPlay())
+			{
+				const FCard PlayedCard = Game.PlayRandomCard(Random);
+				if (!PlayedCard.IsValid())
+				{
+					break;
+				}
+				Replay.AddMove(PlayedCard);
+			}
+			Replay.SetResult(Game);
+			Replay.SerializeRecord(Data);
+		}
+
+		if (!FFileHelper::SaveArrayToFile(Data, *FilePath))
+		{
+			UE_LOG(LogTemp, Error, TEXT("BattleReplay: Could not write '%s'"), *FilePath);
+			return 1;
+		}
+
+		UE_LOG(LogTemp, Display, TEXT("BattleReplay: Generated %d replays (%d bytes, %.1f bytes/game) into '%s'"),
+			NumGenerate, Data.Num(), (double)Data.Num() / (double)NumGenerate, *FilePath);
+	}
+
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *FilePath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("BattleReplay: Could not read '%s'"), *FilePath);
+		return 1;
+	}
+
+	const FBattleReplayVerifyResult Result = FBattleReplayVerifier::VerifyRecords(Data, Settings.Prototype, Settings.DeckCards);
+	Result.LogReport();
+
+	return Result.AllMatched() ? 0 : 1;
+}
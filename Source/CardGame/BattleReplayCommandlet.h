@@ -0,0 +1,24 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "BattleReplayCommandlet.generated.h"
+
+/**
+ * UBattleReplayCommandlet - 以目前的 DataTable 與規則重新驗證對戰紀錄
+ * 用法: UnrealEditor-Cmd CardGame.uproject -run=BattleReplay [-File=Saved/Replays/Matches.cardreplay] [-Table=/Game/DataTable/DT_CardData.DT_CardData]
+ *       加上 -Generate=1000000 -Seed=1 會先以隨機出牌產生紀錄再驗證 (用於量測重播速度)；
+ *       產生的紀錄寫到 -File (預設 Saved/Replays/Generated_<時間>.cardreplay)，不會寫入實際對戰紀錄
+ */
+UCLASS()
+class CARDGAME_API UBattleReplayCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UBattleReplayCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
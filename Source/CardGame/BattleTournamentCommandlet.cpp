@@ -0,0 +1,45 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "BattleTournamentCommandlet.h"
+#include "Sim/BattleTournament.h"
+#include "Engine/DataTable.h"
+#include "Misc/Parse.h"
+
+UBattleTournamentCommandlet::UBattleTournamentCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UBattleTournamentCommandlet::Main(const FString& Params)
+{
+	FBattleTournamentSettings Settings;
+	FParse::Value(*Params, TEXT("Games="), Settings.NumGames);
+	FParse::Value(*Params, TEXT("Seed="), Settings.Seed);
+	FParse::Value(*Params, TEXT("Batch="), Settings.GamesPerBatch);
+
+	FString TablePath(TEXT("/Game/DataTable/DT_CardData.DT_CardData"));
+	FParse::Value(*Params, TEXT("Table="), TablePath);
+
+	if (const UDataTable* DataTable = LoadObject<UDataTable>(nullptr, *TablePath))
+	{
+		FBattleTournament::ConfigureFromDataTable(Settings, DataTable);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("BattleTournament: Could not load DataTable '%s', using default cards"), *TablePath);
+	}
+
+	if (Settings.NumGames <= 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("BattleTournament: -Games must be positive"));
+		return 1;
+	}
+
+	const FBattleTournamentResult Result = FBattleTournament::Run(Settings);
+	Result.LogReport();
+
+	return 0;
+}
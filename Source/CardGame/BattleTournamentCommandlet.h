@@ -0,0 +1,22 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "BattleTournamentCommandlet.generated.h"
+
+/**
+ * UBattleTournamentCommandlet - 在命令列批次模擬大量對戰
+ * 用法: UnrealEditor-Cmd CardGame.uproject -run=BattleTournament -Games=1000000 -Seed=1 [-Table=/Game/DataTable/DT_CardData.DT_CardData]
+ */
+UCLASS()
+class CARDGAME_API UBattleTournamentCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UBattleTournamentCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
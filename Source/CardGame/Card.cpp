@@ -2,6 +2,7 @@
 
 #include "Card.h"
 #include "Data/DT_CardData.h"
+#include "Sim/BattleSimCore.h"
 #include "Engine/DataTable.h"
 
 FCard::FCard()
@@ -24,73 +25,71 @@ UCardDeck::UCardDeck()
 {
 }
 
-void UCardDeck::Initialize()
+void UCardDeck::Initialize(FRandomStream& Random)
 {
-	Deck.Empty();
+	Deck.Reset();
 	
 	// 創建30張卡牌 (1-30)
-	for (int32 i = 1; i <= 30; ++i)
+	for (int32 i = 1; i <= MaxDeckSize; ++i)
 	{
 		Deck.Add(FCard(i));
 	}
 
-	ShuffleDeck();
+	ShuffleDeck(Random);
 	CurrentIndex = 0;
 }
 
-void UCardDeck::InitializeFromDataTable(UDataTable* DataTable)
+void UCardDeck::InitializeFromDataTable(UDataTable* DataTable, FRandomStream& Random)
 {
-	Deck.Empty();
+	// 與 UCardCatalogSubsystem、FBattleSimCore::DealHands 使用同一份牌組，直接寫入內嵌的儲存空間
+	Deck.SetNumUninitialized(MaxDeckSize, EAllowShrinking::No);
+	Deck.SetNum(FBattleSimCore::BuildDeck(DataTable, Deck.GetData(), MaxDeckSize), EAllowShrinking::No);
 
-	if (DataTable)
-	{
-		// 獲取所有 Row Names
-		TArray<FName> RowNames = DataTable->GetRowNames();
-
-		for (const FName& RowName : RowNames)
-		{
-			// 將 RowName 轉換為整數 ID
-			FString RowString = RowName.ToString();
-			if (RowString.IsNumeric())
-			{
-				int32 CardID = FCString::Atoi(*RowString);
-				Deck.Add(FCard(CardID));
-			}
-		}
-	}
-
-	// 如果 DataTable 為空或讀取失敗，回退到預設邏輯
+	// DataTable 為空或讀取失敗時回退到預設牌組
 	if (Deck.Num() == 0)
 	{
-		Initialize();
+		Initialize(Random);
 		return;
 	}
 
-	ShuffleDeck();
+	ShuffleDeck(Random);
 	CurrentIndex = 0;
 }
 
-void UCardDeck::DrawCards(int32 NumberOfCards, TArray<FCard>& OutCards)
+void UCardDeck::InitializeFromCards(TConstArrayView<FCard> Cards, FRandomStream& Random)
 {
-	OutCards.Empty();
-
-	for (int32 i = 0; i < NumberOfCards && CurrentIndex < Deck.Num(); ++i)
+	if (Cards.Num() == 0)
 	{
-		OutCards.Add(Deck[CurrentIndex]);
-		CurrentIndex++;
+		Initialize(Random);
+		return;
 	}
+
+	// 與 DealHands 相同只取前 MaxDeckSize 張，也不會超出內嵌的儲存空間
+	Deck.Reset();
+	Deck.Append(Cards.GetData(), FMath::Min(Cards.Num(), MaxDeckSize));
+	ShuffleDeck(Random);
+	CurrentIndex = 0;
+}
+
+TConstArrayView<FCard> UCardDeck::DrawCards(int32 NumberOfCards)
+{
+	// 牌組已洗好，依序抽出的牌就是連續的一段
+	const int32 NumDrawn = FMath::Clamp(NumberOfCards, 0, Deck.Num() - CurrentIndex);
+	const TConstArrayView<FCard> Drawn(Deck.GetData() + CurrentIndex, NumDrawn);
+	CurrentIndex += NumDrawn;
+	return Drawn;
 }
 
-void UCardDeck::Reset()
+void UCardDeck::Reset(FRandomStream& Random)
 {
-	Initialize();
+	Initialize(Random);
 }
 
-void UCardDeck::ShuffleDeck()
+void UCardDeck::ShuffleDeck(FRandomStream& Random)
 {
 	for (int32 i = Deck.Num() - 1; i > 0; --i)
 	{
-		int32 RandomIndex = FMath::RandRange(0, i);
+		int32 RandomIndex = Random.RandRange(0, i);
 		Deck.Swap(i, RandomIndex);
 	}
 }
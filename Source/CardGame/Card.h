@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
+#include "Sim/CardPowerTable.h"
 #include "Card.generated.h"
 
 /**
@@ -36,29 +37,37 @@ class CARDGAME_API UCardDeck : public UObject
 public:
 	UCardDeck();
 
-	// 初始化牌組
-	void Initialize();
+	// 牌組最多的卡牌數：Catalog 的牌組每個數值最多一張 (FBattleSimCore::BuildDeck)，所以等於卡牌數值上限
+	// 牌組直接存放在物件內，不需要配置堆積記憶體
+	static constexpr int32 MaxDeckSize = FCardPowerTable::MaxCardValue;
+	using FCardArray = TArray<FCard, TInlineAllocator<MaxDeckSize>>;
+
+	// 初始化牌組 (以 Random 洗牌)
+	void Initialize(FRandomStream& Random);
 
 	// 從 DataTable 初始化牌組
-	void InitializeFromDataTable(class UDataTable* DataTable);
+	void InitializeFromDataTable(class UDataTable* DataTable, FRandomStream& Random);
+
+	// 以指定的卡牌初始化牌組 (例如 UCardCatalogSubsystem::GetDeckCards)
+	// 洗牌方式與 FBattleSimCore::DealHands 相同，同一亂數流會得到相同的手牌
+	void InitializeFromCards(TConstArrayView<FCard> Cards, FRandomStream& Random);
 
-	// 從牌組中抽取指定數量的卡牌
-	void DrawCards(int32 NumberOfCards, TArray<FCard>& OutCards);
+	// 從牌組中抽取指定數量的卡牌 (回傳的 View 指向牌組內部，下次初始化前有效)
+	TConstArrayView<FCard> DrawCards(int32 NumberOfCards);
 
 	// 獲取剩餘的卡牌數量
-	int32 GetRemainingCardsCount() const { return Deck.Num(); }
+	int32 GetRemainingCardsCount() const { return Deck.Num() - CurrentIndex; }
 
 	// 重置牌組
-	void Reset();
+	void Reset(FRandomStream& Random);
 
 private:
-	// 牌組中的所有卡牌
-	UPROPERTY()
-	TArray<FCard> Deck;
+	// 牌組中的所有卡牌 (只有數值，不需要 UPROPERTY；重新開局時沿用同一塊儲存空間)
+	FCardArray Deck;
 
 	// 當前位置
 	int32 CurrentIndex;
 
 	// 打亂牌組
-	void ShuffleDeck();
+	void ShuffleDeck(FRandomStream& Random);
 };
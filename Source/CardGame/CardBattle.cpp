@@ -1,28 +1,114 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "CardBattle.h"
+#include "CardGame.h"
 #include "CardGamePlayer.h"
 #include "CardGameHUD.h"
+#include "CardBattleGameState.h"
+#include "CardBattlePlayerState.h"
 #include "Data/DT_CardData.h"
+#include "Data/CardCatalogSubsystem.h"
 #include "Blueprint/UserWidget.h"
 #include "Kismet/GameplayStatics.h"
 #include "Camera/CameraComponent.h"
 #include "GameFramework/PlayerController.h"
 #include "GameFramework/MovementComponent.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "Sim/BattleBatchSim.h"
+#include "Sim/BattleTrace.h"
+
+static FAutoConsoleCommandWithWorldAndArgs GBattleAIBenchCommand(
+	TEXT("CardGame.AIBench"),
+	TEXT("Benchmark the search AI on random positions. Usage: CardGame.AIBench [Positions=1000] [Seed=1] [NodeBudget=500000] [TimeBudgetMs=20]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		const int32 NumPositions = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 1000;
+		const int32 Seed = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 1;
+
+		FBattleSearchSettings Settings;
+		Settings.MaxNodes = Args.Num() > 2 ? FCString::Atoi64(*Args[2]) : Settings.MaxNodes;
+		Settings.MaxSeconds = Args.Num() > 3 ? FCString::Atod(*Args[3]) / 1000.0 : Settings.MaxSeconds;
+
+		// 使用目前對戰的 Power 與牌組
+		FBattleSimCore Prototype;
+		TConstArrayView<FCard> DeckCards;
+		if (const ACardBattle* Battle = World ? World->GetAuthGameMode<ACardBattle>() : nullptr)
+		{
+			Prototype.SetPowerTable(Battle->GetSimCore().GetSharedPowerTable());
+		}
+		if (const UCardCatalogSubsystem* Catalog = UCardCatalogSubsystem::Get(World))
+		{
+			DeckCards = Catalog->GetDeckCards();
+		}
+
+		FBattleSearchAI::RunBenchmark(Prototype, DeckCards, NumPositions, Seed, Settings);
+	}));
+
+static FAutoConsoleCommandWithWorldAndArgs GBattleMCTSBenchCommand(
+	TEXT("CardGame.MCTSBench"),
+	TEXT("Benchmark concurrent ISMCTS searches on the shared AI worker pool. Usage: CardGame.MCTSBench [Searches=16] [BudgetMs=100] [Seed=1]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		const int32 NumJobs = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 16;
+		const double BudgetSeconds = (Args.Num() > 1 ? FCString::Atod(*Args[1]) : 100.0) / 1000.0;
+		const int32 Seed = Args.Num() > 2 ? FCString::Atoi(*Args[2]) : 1;
+
+		FBattleSimCore Prototype;
+		TConstArrayView<FCard> DeckCards;
+		if (const ACardBattle* Battle = World ? World->GetAuthGameMode<ACardBattle>() : nullptr)
+		{
+			Prototype.SetPowerTable(Battle->GetSimCore().GetSharedPowerTable());
+		}
+		if (const UCardCatalogSubsystem* Catalog = UCardCatalogSubsystem::Get(World))
+		{
+			DeckCards = Catalog->GetDeckCards();
+		}
+
+		FBattleAIWorkerPool::RunBenchmark(Prototype, DeckCards, NumJobs, BudgetSeconds, Seed);
+	}));
+
+static FAutoConsoleCommandWithWorldAndArgs GBattleBatchSimBenchCommand(
+	TEXT("CardGame.BatchSimBench"),
+	TEXT("Compare the SIMD lockstep batch simulator with FBattleSimCore on random-play games. Usage: CardGame.BatchSimBench [Games=1000000] [Seed=1]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		const int32 NumGames = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 1000000;
+		const int32 Seed = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 1;
+
+		FCardPowerTable PowerTable;
+		TConstArrayView<FCard> DeckCards;
+		if (const ACardBattle* Battle = World ? World->GetAuthGameMode<ACardBattle>() : nullptr)
+		{
+			PowerTable = Battle->GetSimCore().GetPowerTable();
+		}
+		if (const UCardCatalogSubsystem* Catalog = UCardCatalogSubsystem::Get(World))
+		{
+			DeckCards = Catalog->GetDeckCards();
+		}
+
+		FBattleBatchSim::RunBenchmark(PowerTable, DeckCards, NumGames, Seed);
+	}));
+
+static FAutoConsoleCommandWithWorld GBattleAIStatsCommand(
+	TEXT("CardGame.AIStats"),
+	TEXT("Print AI response latency percentiles for the current battle."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const ACardBattle* Battle = World ? World->GetAuthGameMode<ACardBattle>() : nullptr)
+		{
+			Battle->LogAIStats();
+		}
+	}));
 
 ACardBattle::ACardBattle()
-	: CurrentState(EBattleState::Idle)
-	, CurrentTurnPlayerId(0)
-	, CurrentTurnRemainingTime(0.0f)
+	: CurrentTurnRemainingTime(0.0f)
 	, TurnTimeLimit(5.0f)  // 5 秒回合時間
-	, Winner(-1)
-	, bPlayer0CardPlayed(false)
-	, bPlayer1CardPlayed(false)
-	, CurrentRoundPlayer0Card(FCard(0))
-	, CurrentRoundPlayer1Card(FCard(0))
 {
 	PrimaryActorTick.bCanEverTick = true;
 	DefaultPawnClass = ACardGamePlayer::StaticClass();
+	GameStateClass = ACardBattleGameState::StaticClass();
+	PlayerStateClass = ACardBattlePlayerState::StaticClass();
 }
 
 UClass* ACardBattle::GetDefaultPawnClassForController_Implementation(AController* InController)
@@ -89,137 +175,144 @@ void ACardBattle::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
-	if (CurrentState == EBattleState::WaitingForPlayer0 || CurrentState == EBattleState::WaitingForPlayer1)
+	if (Sim.IsWaitingForPlay())
 	{
 		HandleTurnTimer(DeltaTime);
 	}
+
+	// 真人玩家離開後，空出的座位由 AI 接手
+	ScheduleAIMoveIfNeeded();
+
+	// AI 的結果在之後的 Tick 才排入，遊戲執行緒從不等待 AI
+	UpdatePendingAIMove();
+
+	// 本幀收到的所有出牌指令 (含逾時代打) 在這裡一次處理
+	ProcessPendingActions();
+
+	if (Sim.IsWaitingForPlay())
+	{
+		TurnTimerTickEvent.Broadcast(GetRemainingTurnTime());
+	}
 }
 
-void ACardBattle::StartGame()
+void ACardBattle::StartGame(int32 Seed)
 {
-	if (CurrentState != EBattleState::Idle)
+	if (Sim.GetState() != EBattleState::Idle)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("Game is already started or in progress"));
 		return;
 	}
 
+	// 牌組 (FBattleSimCore::BuildDeck) 與洗牌順序 (玩家 0、玩家 1、先手) 與 FBattleSimCore::DealHands + Start 相同，
+	// 同一個種子可以在規則核心中完整重現
+	MatchSeed = Seed != 0 ? Seed : GenerateMatchSeed();
+	MatchRandom.Initialize(MatchSeed);
+	FBattleTrace::Record(EBattleTraceEvent::MatchStarted, MatchSeed);
+	MatchReplay.Reset(MatchSeed);
+
 	ResetGame();
 	InitializeGame();
 
 	// 隨機決定先手
-	DetermineFirstPlayer();
+	Sim.Start(DetermineFirstPlayer());
+	CurrentTurnRemainingTime = TurnTimeLimit;
+	BroadcastFullState();
 
-	CurrentState = EBattleState::Started;
-	GoToNextTurn();
+	// 如果是 AI 座位先手，立刻自動出牌
+	ScheduleAIMoveIfNeeded();
 }
 
 void ACardBattle::EndGame()
 {
-	CurrentState = EBattleState::Idle;
 	ResetGame();
+	BroadcastFullState();
 }
 
 void ACardBattle::PlayerPlayCard(int32 PlayerId, int32 CardIndex)
 {
-	// 檢查是否是當前玩家的回合
-	if (CurrentState != EBattleState::WaitingForPlayer0 && CurrentState != EBattleState::WaitingForPlayer1)
-	{
-		return;
-	}
+	CARDGAME_SCOPE_CYCLE_COUNTER(PlayerPlayCard);
 
-	if (CurrentTurnPlayerId != PlayerId)
+	if (PlayerId < 0 || PlayerId > 1)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Not player %d's turn"), PlayerId);
 		return;
 	}
 
-	if (!Players[PlayerId])
+	// 手牌索引在提交時轉成卡牌數值，排隊期間手牌變動也不會打錯牌
+	const FCard Card = Sim.GetHand(PlayerId).GetCard(CardIndex);
+	if (!Card.IsValid())
 	{
+		FBattleTrace::Record(EBattleTraceEvent::InvalidCardIndex, PlayerId, CardIndex);
 		return;
 	}
 
-	// 玩家出牌
-	FCard PlayedCard = Players[PlayerId]->PlayCard(CardIndex);
+	SubmitAction(FBattleAction::MakePlayCard(PlayerId, Card.CardValue, EBattleActionSource::Input));
+}
 
-	if (!PlayedCard.IsValid())
-	{
-		UE_LOG(LogTemp, Warning, TEXT("Invalid card played by player %d"), PlayerId);
-		return;
-	}
+void ACardBattle::SubmitAction(const FBattleAction& Action)
+{
+	PendingActions.Add(Action);
+}
 
-	// 記錄出牌並立刻加分
-	if (PlayerId == 0)
-	{
-		CurrentRoundPlayer0Card = PlayedCard;
-		bPlayer0CardPlayed = true;
-		
-		// 使用 DataTable 中的 Power 作為分數
-		int32 ScoreToAdd = GetCardPower(PlayedCard.CardValue);
-		Players[0]->AddScore(ScoreToAdd);
-		
-		Player0PlayedCards.Add(PlayedCard);  // 加入歷史記錄
-		UE_LOG(LogTemp, Warning, TEXT("Player 0 played %d (Power: %d), score now: %d"), PlayedCard.CardValue, ScoreToAdd, Players[0]->GetScore());
-	}
-	else
-	{
-		CurrentRoundPlayer1Card = PlayedCard;
-		bPlayer1CardPlayed = true;
-		
-		// 使用 DataTable 中的 Power 作為分數
-		int32 ScoreToAdd = GetCardPower(PlayedCard.CardValue);
-		Players[1]->AddScore(ScoreToAdd);
-		
-		Player1PlayedCards.Add(PlayedCard);  // 加入歷史記錄
-		UE_LOG(LogTemp, Warning, TEXT("Player 1 played %d (Power: %d), score now: %d"), PlayedCard.CardValue, ScoreToAdd, Players[1]->GetScore());
-	}
+void ACardBattle::ProcessPendingActions()
+{
+	CARDGAME_SCOPE_CYCLE_COUNTER(ProcessActions);
 
-	// 如果雙方都出牌了，結算本回合
-	if (bPlayer0CardPlayed && bPlayer1CardPlayed)
+	// 以索引走訪：執行期間排入的指令 (AI 回應) 接在後面同一輪處理；
+	// 事件處理中重置遊戲時佇列會被清空，迴圈自然結束
+	for (int32 ActionIndex = 0; ActionIndex < PendingActions.Num(); ++ActionIndex)
 	{
-		ResolveRound(CurrentRoundPlayer0Card, CurrentRoundPlayer1Card);
+		FBattleActionResult Result;
+		Result.Action = PendingActions[ActionIndex];
 
-		// 檢查遊戲是否結束
-		if (!CheckGameOver())
+		// 真人玩家坐著的座位不接受 AI 的出牌 (AI 在真人坐下前排入的結果)
+		if (Result.Action.Source != EBattleActionSource::AI || IsAISeat(Result.Action.PlayerId))
 		{
-			// 進入下一回合
-			GoToNextTurn();
+			Result.PlayedCard = FBattleActionExecutor::Apply(Sim, Result.Action, MatchRandom);
+		}
+
+		if (Result.IsAccepted())
+		{
+			OnCardCommitted(Result.Action, Result.PlayedCard);
 		}
 		else
 		{
-			DetermineWinner();
-			CurrentState = EBattleState::GameOver;
+			FBattleTrace::Record(EBattleTraceEvent::ActionRejected, Result.Action.PlayerId, (int32)Result.Action.Type, Result.Action.CardValue, (int32)Result.Action.Source);
 		}
+
+		ActionProcessedEvent.Broadcast(Result);
 	}
-	else
+
+	PendingActions.Reset();
+}
+
+TArray<FCard> ACardBattle::GetPlayerHand(int32 PlayerId) const
+{
+	return TArray<FCard>(GetPlayerHandView(PlayerId));
+}
+
+TConstArrayView<FCard> ACardBattle::GetPlayerHandView(int32 PlayerId) const
+{
+	if (PlayerId >= 0 && PlayerId < 2)
 	{
-		// 切換到另一玩家的回合
-		CurrentTurnPlayerId = 1 - CurrentTurnPlayerId;
-		CurrentState = CurrentTurnPlayerId == 0 ? EBattleState::WaitingForPlayer0 : EBattleState::WaitingForPlayer1;
-		CurrentTurnRemainingTime = TurnTimeLimit;
-		
-		// 如果切換到 AI（Player 1）的回合，立刻自動出牌
-		if (CurrentTurnPlayerId == 1)
-		{
-			AIPlayCard();
-		}
+		return TConstArrayView<FCard>(HandDisplay[PlayerId], HandDisplayNum[PlayerId]);
 	}
+	return TConstArrayView<FCard>();
 }
 
-const TArray<FCard>& ACardBattle::GetPlayerHand(int32 PlayerId) const
+TConstArrayView<FCard> ACardBattle::GetPlayedCardsView(int32 PlayerId) const
 {
-	static TArray<FCard> EmptyHand;
-	if (PlayerId >= 0 && PlayerId < 2 && Players[PlayerId])
+	if (PlayerId >= 0 && PlayerId < 2)
 	{
-		return Players[PlayerId]->GetHand();
+		return Sim.GetPlayedCards(PlayerId);
 	}
-	return EmptyHand;
+	return TConstArrayView<FCard>();
 }
 
 int32 ACardBattle::GetPlayerScore(int32 PlayerId) const
 {
-	if (PlayerId >= 0 && PlayerId < 2 && Players[PlayerId])
+	if (PlayerId >= 0 && PlayerId < 2)
 	{
-		return Players[PlayerId]->GetScore();
+		return Sim.GetScore(PlayerId);
 	}
 	return 0;
 }
@@ -231,95 +324,93 @@ float ACardBattle::GetRemainingTurnTime() const
 
 void ACardBattle::InitializeGame()
 {
-	// 創建玩家和牌組
-	for (int32 i = 0; i < 2; ++i)
+	// 卡牌資料由共用的 Catalog 載入，GameMode 上設定的 DataTable 作為資料來源
+	UCardCatalogSubsystem* Catalog = UCardCatalogSubsystem::Get(this);
+	if (Catalog)
 	{
-		if (!Players[i])
+		if (CardDataTable)
 		{
-			Players[i] = NewObject<UBattlePlayer>();
-			Players[i]->Initialize(i);
+			Catalog->SetSourceTable(CardDataTable);
 		}
 
+		// Catalog 重建時 (編輯器中修改 DataTable) 同步更新數值表
+		if (!CatalogChangedHandle.IsValid())
+		{
+			CatalogChangedHandle = Catalog->OnCatalogChanged().AddUObject(this, &ACardBattle::RebuildPowerTable);
+		}
+	}
+
+	// 以 CardValue 索引的數值表，出牌時只需一次陣列讀取
+	RebuildPowerTable();
+
+	// 創建牌組並發牌 (牌組物件與其內嵌的儲存空間在每局之間重複使用)
+	for (int32 i = 0; i < 2; ++i)
+	{
 		if (!PlayerDecks[i])
 		{
-			PlayerDecks[i] = NewObject<UCardDeck>();
+			PlayerDecks[i] = NewObject<UCardDeck>(this);
 		}
 
-		if (CardDataTable)
+		if (Catalog)
 		{
-			PlayerDecks[i]->InitializeFromDataTable(CardDataTable);
+			PlayerDecks[i]->InitializeFromCards(Catalog->GetDeckCards(), MatchRandom);
+		}
+		else if (CardDataTable)
+		{
+			PlayerDecks[i]->InitializeFromDataTable(CardDataTable, MatchRandom);
 		}
 		else
 		{
-			PlayerDecks[i]->Initialize();
+			PlayerDecks[i]->Initialize(MatchRandom);
 		}
 
-		Players[i]->SetDeck(PlayerDecks[i]);
-
 		// 每個玩家抽10張牌
-		Players[i]->DrawCardsToHand(10);
+		Sim.SetHand(i, PlayerDecks[i]->DrawCards(FBattleSimCore::HandSize));
+		RefreshHandDisplay(i);
 	}
 
-	CurrentState = EBattleState::Idle;
-	CurrentTurnPlayerId = 0;
 	CurrentTurnRemainingTime = TurnTimeLimit;
-	Winner = -1;
-	bPlayer0CardPlayed = false;
-	bPlayer1CardPlayed = false;
 
-	UE_LOG(LogTemp, Warning, TEXT("Game initialized. Player 0 hand size: %d, Player 1 hand size: %d"),
-		Players[0]->GetHandSize(), Players[1]->GetHandSize());
+	FBattleTrace::Record(EBattleTraceEvent::HandsDealt, Sim.GetHandNum(0), Sim.GetHandNum(1));
 }
 
 void ACardBattle::ResetGame()
 {
-	for (int32 i = 0; i < 2; ++i)
-	{
-		if (Players[i])
-		{
-			Players[i]->ResetScore();
-		}
-	}
-
-	CurrentState = EBattleState::Idle;
-	CurrentTurnPlayerId = 0;
+	// 清空分數、手牌、已出牌歷史、回合狀態與尚未執行的指令
+	Sim.Reset();
+	PendingActions.Reset();
+	CancelPendingAIMove();
+	RefreshHandDisplay(0);
+	RefreshHandDisplay(1);
 	CurrentTurnRemainingTime = TurnTimeLimit;
-	Winner = -1;
-	bPlayer0CardPlayed = false;
-	bPlayer1CardPlayed = false;
-	CurrentRoundPlayer0Card = FCard(0);
-	CurrentRoundPlayer1Card = FCard(0);
-	
-	// 清空已出牌歷史
-	Player0PlayedCards.Empty();
-	Player1PlayedCards.Empty();
 }
 
-void ACardBattle::DetermineFirstPlayer()
+void ACardBattle::RefreshHandDisplay(int32 PlayerId)
 {
-	CurrentTurnPlayerId = FMath::RandRange(0, 1);
-	UE_LOG(LogTemp, Warning, TEXT("Player %d goes first"), CurrentTurnPlayerId);
+	HandDisplayNum[PlayerId] = Sim.GetHand(PlayerId).CopyTo(HandDisplay[PlayerId]);
 }
 
-void ACardBattle::GoToNextTurn()
+int32 ACardBattle::DetermineFirstPlayer()
 {
-	// 切換讓另一位玩家開始新的一回合 (避免同一人連續出牌：結束上一局又開始下一局)
-	CurrentTurnPlayerId = 1 - CurrentTurnPlayerId;
+	const int32 FirstPlayerId = MatchRandom.RandRange(0, 1);
+	FBattleTrace::Record(EBattleTraceEvent::FirstPlayer, FirstPlayerId);
+	return FirstPlayerId;
+}
 
-	// 重置本回合的出牌狀態
-	bPlayer0CardPlayed = false;
-	bPlayer1CardPlayed = false;
-	CurrentRoundPlayer0Card = FCard(0);
-	CurrentRoundPlayer1Card = FCard(0);
-	CurrentTurnRemainingTime = TurnTimeLimit;
+int32 ACardBattle::GenerateMatchSeed()
+{
+	const int32 NewSeed = (int32)GetTypeHash(FPlatformTime::Cycles64());
+	return NewSeed != 0 ? NewSeed : 1;
+}
 
-	CurrentState = CurrentTurnPlayerId == 0 ? EBattleState::WaitingForPlayer0 : EBattleState::WaitingForPlayer1;
-	
-	// 如果是 AI（Player 1）的回合，立刻自動出牌
-	if (CurrentTurnPlayerId == 1)
+int32 ACardBattle::PickRandomCardIndex(int32 PlayerId)
+{
+	if (PlayerId < 0 || PlayerId > 1 || !Sim.HasCards(PlayerId))
 	{
-		AIPlayCard();
+		return INDEX_NONE;
 	}
+
+	return MatchRandom.RandRange(0, Sim.GetHandNum(PlayerId) - 1);
 }
 
 void ACardBattle::HandleTurnTimer(float DeltaTime)
@@ -331,157 +422,279 @@ void ACardBattle::HandleTurnTimer(float DeltaTime)
 		CurrentTurnRemainingTime = 0.0f;
 
 		// 系統隨機出牌
-		UE_LOG(LogTemp, Warning, TEXT("Player %d time's up, system plays random card"), CurrentTurnPlayerId);
-
-		FCard RandomCard = Players[CurrentTurnPlayerId]->PlayCardRandom();
+		const int32 PlayerId = Sim.GetCurrentTurnPlayerId();
+		FBattleTrace::Record(EBattleTraceEvent::TurnTimeout, PlayerId);
 
-		if (RandomCard.IsValid())
+		if (Sim.HasCards(PlayerId))
 		{
-			if (CurrentTurnPlayerId == 0)
-			{
-				CurrentRoundPlayer0Card = RandomCard;
-				bPlayer0CardPlayed = true;
-				
-				int32 ScoreToAdd = GetCardPower(RandomCard.CardValue);
-				Players[0]->AddScore(ScoreToAdd);
-				Player0PlayedCards.Add(RandomCard);  // 加入歷史記錄
-				UE_LOG(LogTemp, Warning, TEXT("Player 0 auto-played %d (Power: %d), score now: %d"), 
-					RandomCard.CardValue, ScoreToAdd, Players[0]->GetScore());
-			}
-			else
-			{
-				CurrentRoundPlayer1Card = RandomCard;
-				bPlayer1CardPlayed = true;
-				
-				int32 ScoreToAdd = GetCardPower(RandomCard.CardValue);
-				Players[1]->AddScore(ScoreToAdd);
-				Player1PlayedCards.Add(RandomCard);  // 加入歷史記錄
-				UE_LOG(LogTemp, Warning, TEXT("Player 1 auto-played %d (Power: %d), score now: %d"), 
-					RandomCard.CardValue, ScoreToAdd, Players[1]->GetScore());
-			}
+			SubmitAction(FBattleAction::MakePlayRandom(PlayerId, EBattleActionSource::Timeout));
+		}
+	}
+}
 
-			// 如果雙方都出牌了，結算本回合
-			if (bPlayer0CardPlayed && bPlayer1CardPlayed)
-			{
-				ResolveRound(CurrentRoundPlayer0Card, CurrentRoundPlayer1Card);
-
-				// 檢查遊戲是否結束
-				if (!CheckGameOver())
-				{
-					// 進入下一回合
-					GoToNextTurn();
-				}
-				else
-				{
-					DetermineWinner();
-					CurrentState = EBattleState::GameOver;
-				}
-			}
-			else
-			{
-				// 切換到另一玩家的回合
-				CurrentTurnPlayerId = 1 - CurrentTurnPlayerId;
-				CurrentState = CurrentTurnPlayerId == 0 ? EBattleState::WaitingForPlayer0 : EBattleState::WaitingForPlayer1;
-				CurrentTurnRemainingTime = TurnTimeLimit;
-			}
+void ACardBattle::OnCardCommitted(const FBattleAction& Action, FCard PlayedCard)
+{
+	CARDGAME_SCOPE_CYCLE_COUNTER(CardCommitted);
+
+	const int32 PlayerId = Action.PlayerId;
+	FBattleTrace::Record(EBattleTraceEvent::CardCommitted,
+		PlayerId, (int32)Action.Source, PlayedCard.CardValue, Sim.GetCardPower(PlayedCard.CardValue), Sim.GetScore(PlayerId));
+
+	// 新的出牌回合，重置計時
+	CurrentTurnRemainingTime = TurnTimeLimit;
+
+	RefreshHandDisplay(PlayerId);
+	MatchReplay.AddMove(PlayedCard);
+
+	HandChangedEvent.Broadcast(PlayerId);
+	ScoreChangedEvent.Broadcast(PlayerId, Sim.GetScore(PlayerId));
+	CardPlayedEvent.Broadcast(PlayerId, PlayedCard);
+	BattleStateChangedEvent.Broadcast(Sim.GetState());
+	TurnTimerTickEvent.Broadcast(GetRemainingTurnTime());
+
+	// 雙方出牌數相同表示本回合已結算
+	if (Sim.GetPlayedCards(0).Num() == Sim.GetPlayedCards(1).Num())
+	{
+		const FRoundInfo& LastRound = Sim.GetLastRoundInfo();
+		FBattleTrace::Record(EBattleTraceEvent::RoundResolved,
+			LastRound.Player0Card.CardValue, LastRound.Player1Card.CardValue, Sim.GetScore(0), Sim.GetScore(1));
+	}
+
+	if (Sim.GetState() == EBattleState::GameOver)
+	{
+		FBattleTrace::Record(EBattleTraceEvent::GameOver, Sim.GetScore(0), Sim.GetScore(1), Sim.GetWinner());
+
+		MatchReplay.SetResult(Sim);
+		if (bSaveReplays)
+		{
+			SaveMatchReplay();
 		}
+		return;
 	}
+
+	// 如果切換到 AI 座位的回合，立刻自動出牌
+	ScheduleAIMoveIfNeeded();
 }
 
-void ACardBattle::ResolveRound(FCard Card0, FCard Card1)
+void ACardBattle::SaveMatchReplay()
 {
-	UE_LOG(LogTemp, Warning, TEXT("Round completed: Player0 played %d, Player1 played %d"), Card0.CardValue, Card1.CardValue);
+	if (!ReplayArchive)
+	{
+		const FString Path = ReplayArchivePath.IsEmpty() ? FBattleReplay::GetDefaultArchivePath() : ReplayArchivePath;
+		ReplayArchive.Reset(IFileManager::Get().CreateFileWriter(*Path, FILEWRITE_Append | FILEWRITE_AllowRead));
+		if (!ReplayArchive)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("CardBattle: Could not open replay archive '%s'"), *Path);
+			return;
+		}
+	}
 
-	LastRoundInfo.Player0Card = Card0;
-	LastRoundInfo.Player1Card = Card1;
-	LastRoundInfo.WinnerID = -1;  // 不再判定回合勝負
-	
-	UE_LOG(LogTemp, Warning, TEXT("Current scores - Player 0: %d, Player 1: %d"), Players[0]->GetScore(), Players[1]->GetScore());
+	if (!MatchReplay.AppendTo(*ReplayArchive, ReplayRecordBuffer))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("CardBattle: Failed to append replay, closing the archive"));
+		ReplayArchive.Reset();
+	}
+}
+
+void ACardBattle::SetReplayArchivePath(const FString& InPath)
+{
+	ReplayArchive.Reset();
+	ReplayArchivePath = InPath;
 }
 
-bool ACardBattle::CheckGameOver()
+bool ACardBattle::IsAISeat(int32 SeatId) const
 {
-	// 如果雙方都沒有手牌，遊戲結束
-	if (!Players[0]->HasCards() && !Players[1]->HasCards())
+	if (SeatId < 0 || SeatId > 1)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Both players out of cards, game over"));
-		return true;
+		return false;
 	}
 
-	return false;
+	// 沒有 GameState 時 (不經過登入流程) 維持單機的配置：玩家 0 是人類玩家
+	const ACardBattleGameState* BattleGameState = GetGameState<ACardBattleGameState>();
+	return BattleGameState ? !BattleGameState->IsSeatHuman(SeatId) : SeatId == 1;
 }
 
-void ACardBattle::DetermineWinner()
+void ACardBattle::ScheduleAIMoveIfNeeded()
 {
-	int32 Player0Score = Players[0]->GetScore();
-	int32 Player1Score = Players[1]->GetScore();
+	if (Sim.IsWaitingForPlay() && !PendingAIMove.bActive && IsAISeat(Sim.GetCurrentTurnPlayerId()))
+	{
+		AIPlayCard();
+	}
+}
 
-	UE_LOG(LogTemp, Warning, TEXT("Final scores - Player 0: %d, Player 1: %d"), Player0Score, Player1Score);
+void ACardBattle::AIPlayCard()
+{
+	CARDGAME_SCOPE_CYCLE_COUNTER(AIPlayCard);
 
-	if (Player0Score > Player1Score)
+	const int32 PlayerId = Sim.GetCurrentTurnPlayerId();
+	if (!IsAISeat(PlayerId) || !Sim.HasCards(PlayerId))
 	{
-		Winner = 0;
-		UE_LOG(LogTemp, Warning, TEXT("Player 0 wins the game!"));
+		return;
 	}
-	else if (Player1Score > Player0Score)
+
+	FBattleTrace::Record(EBattleTraceEvent::AIRequested, (int32)AIType);
+
+	CancelPendingAIMove();
+
+	PendingAIMove.bActive = true;
+	PendingAIMove.RequestTime = FPlatformTime::Seconds();
+	PendingAIMove.PlayerId = PlayerId;
+	PendingAIMove.MatchSeed = MatchSeed;
+	PendingAIMove.NumPlayedCards = Sim.GetPlayedCards(0).Num() + Sim.GetPlayedCards(1).Num();
+
+	if (AIType == EBattleAIType::Random)
 	{
-		Winner = 1;
-		UE_LOG(LogTemp, Warning, TEXT("Player 1 wins the game!"));
+		// 隨機出牌不需要工作執行緒，只等待最短思考時間
+		return;
 	}
-	else
+
+	if (AIType == EBattleAIType::ISMCTS)
+	{
+		// 與其他對戰共用有上限的工作池；搜尋只會看到 AI 自己的手牌
+		TConstArrayView<FCard> DeckCards;
+		if (const UCardCatalogSubsystem* Catalog = UCardCatalogSubsystem::Get(this))
+		{
+			DeckCards = Catalog->GetDeckCards();
+		}
+
+		const int32 Seed = (int32)MatchRandom.GetUnsignedInt();
+		if (MCTSJob && MCTSJob.IsUnique())
+		{
+			MCTSJob->Restart(Sim, DeckCards, Seed, AISearchTimeBudgetMs / 1000.0, AISearchNodeBudget);
+		}
+		else
+		{
+			// 上一個被取消的搜尋還在工作池中，改用新的實例 (不等待)
+			MCTSJob = MakeShared<FBattleAIJob, ESPMode::ThreadSafe>(Sim, DeckCards, Seed, AISearchTimeBudgetMs / 1000.0, AISearchNodeBudget);
+		}
+
+		PendingAIMove.Job = MCTSJob;
+		FBattleAIWorkerPool::Get().Submit(MCTSJob.ToSharedRef());
+		return;
+	}
+
+	// 上一個被取消的工作還在使用置換表時，改用新的實例 (不等待)
+	if (!SearchAI || !SearchAI.IsUnique())
 	{
-		Winner = -1;
-		UE_LOG(LogTemp, Warning, TEXT("Game is a draw!"));
+		SearchAI = MakeShared<FSearchAIContext, ESPMode::ThreadSafe>();
 	}
+	SearchAI->bCancelled.store(false, std::memory_order_relaxed);
+
+	FBattleSearchSettings Settings;
+	Settings.MaxNodes = AISearchNodeBudget;
+	Settings.MaxSeconds = AISearchTimeBudgetMs / 1000.0;
+
+	// 工作只持有規則核心的拷貝與共用指標，不碰這個 Actor
+	PendingAIMove.Task = UE::Tasks::Launch(UE_SOURCE_LOCATION,
+		[SearchAI = SearchAI, Snapshot = Sim, Settings]() mutable
+		{
+			Settings.CancelFlag = &SearchAI->bCancelled;
+			return SearchAI->AI.ChooseMove(Snapshot, Settings);
+		});
 }
 
-void ACardBattle::AIPlayCard()
+void ACardBattle::UpdatePendingAIMove()
 {
-	if (CurrentTurnPlayerId != 1 || !Players[1])
+	if (!PendingAIMove.bActive)
+	{
+		return;
+	}
+
+	// 局面已改變 (逾時代打、重新開局或真人玩家坐進這個座位)，結果作廢
+	const int32 PlayerId = PendingAIMove.PlayerId;
+	const int32 NumPlayedCards = Sim.GetPlayedCards(0).Num() + Sim.GetPlayedCards(1).Num();
+	if (!Sim.IsWaitingForPlay() || Sim.GetCurrentTurnPlayerId() != PlayerId || !IsAISeat(PlayerId)
+		|| PendingAIMove.MatchSeed != MatchSeed || PendingAIMove.NumPlayedCards != NumPlayedCards)
 	{
+		CancelPendingAIMove();
 		return;
 	}
 
-	UE_LOG(LogTemp, Warning, TEXT("AI (Player 1) plays a card"));
+	const bool bHasTask = PendingAIMove.Task.IsValid();
+	const bool bHasJob = PendingAIMove.Job.IsValid();
+	if ((bHasTask && !PendingAIMove.Task.IsCompleted()) || (bHasJob && !PendingAIMove.Job->IsDone()))
+	{
+		return;
+	}
 
-	// AI 隨機出牌
-	FCard AICard = Players[1]->PlayCardRandom();
+	const double Now = FPlatformTime::Seconds();
+	if ((bHasTask || bHasJob) && !PendingAIMove.bLatencyRecorded)
+	{
+		// 只在第一次看到完成時記錄 (之後每幀只是在等最短思考時間)
+		PendingAIMove.bLatencyRecorded = true;
+		AIResponseLatency.Add(Now - PendingAIMove.RequestTime);
+		SET_FLOAT_STAT(STAT_CardGame_AIThinkTimeMs, (Now - PendingAIMove.RequestTime) * 1000.0);
+		TRACE_COUNTER_SET(CardGame_AIThinkTimeMs, (Now - PendingAIMove.RequestTime) * 1000.0);
+		AISearchLatency.Add(bHasTask ? PendingAIMove.Task.GetResult().ElapsedSeconds : PendingAIMove.Job->GetResult().ElapsedSeconds);
+	}
 
-	if (AICard.IsValid())
+	if (Now - PendingAIMove.RequestTime < AIMinThinkTime)
 	{
-		CurrentRoundPlayer1Card = AICard;
-		bPlayer1CardPlayed = true;
-		
-		int32 ScoreToAdd = GetCardPower(AICard.CardValue);
-		Players[1]->AddScore(ScoreToAdd);
-		Player1PlayedCards.Add(AICard);  // 加入歷史記錄
-		UE_LOG(LogTemp, Warning, TEXT("AI played %d (Power: %d), score now: %d"), AICard.CardValue, ScoreToAdd, Players[1]->GetScore());
+		return;
+	}
 
-		// 如果雙方都出牌了，結算本回合
-		if (bPlayer0CardPlayed && bPlayer1CardPlayed)
+	FBattleAction Action = FBattleAction::MakePlayRandom(PlayerId, EBattleActionSource::AI);
+	if (bHasTask)
+	{
+		const FBattleSearchResult& Result = PendingAIMove.Task.GetResult();
+		if (Result.CardValue > 0)
 		{
-			ResolveRound(CurrentRoundPlayer0Card, CurrentRoundPlayer1Card);
+			FBattleTrace::Record(EBattleTraceEvent::AISearchDone,
+				Result.CardValue, FMath::RoundToInt(Result.ExpectedScoreDelta * 100.0f), Result.Depth * 2 + (Result.bExact ? 1 : 0),
+				(int32)FMath::Min<int64>(Result.Nodes, MAX_int32), FMath::RoundToInt(Result.ElapsedSeconds * 1000000.0));
 
-			// 檢查遊戲是否結束
-			if (!CheckGameOver())
-			{
-				// 進入下一回合
-				GoToNextTurn();
-			}
-			else
-			{
-				DetermineWinner();
-				CurrentState = EBattleState::GameOver;
-			}
+			Action = FBattleAction::MakePlayCard(PlayerId, Result.CardValue, EBattleActionSource::AI);
 		}
-		else
+	}
+	else if (bHasJob)
+	{
+		const FBattleAIJobResult& Result = PendingAIMove.Job->GetResult();
+		if (Result.CardValue > 0)
 		{
-			// 切換到玩家 0 的回合
-			CurrentTurnPlayerId = 0;
-			CurrentState = EBattleState::WaitingForPlayer0;
-			CurrentTurnRemainingTime = TurnTimeLimit;
+			FBattleTrace::Record(EBattleTraceEvent::AIMCTSDone,
+				Result.CardValue, FMath::RoundToInt(Result.WinRate * 1000.0f), (int32)FMath::Min<int64>(Result.Iterations, MAX_int32),
+				Result.NumSlices, FMath::RoundToInt(Result.ElapsedSeconds * 1000000.0));
+
+			Action = FBattleAction::MakePlayCard(PlayerId, Result.CardValue, EBattleActionSource::AI);
 		}
 	}
+
+	PendingAIMove = FPendingAIMove();
+	SubmitAction(Action);
+}
+
+void ACardBattle::CancelPendingAIMove()
+{
+	if (PendingAIMove.Task.IsValid() && !PendingAIMove.Task.IsCompleted())
+	{
+		SearchAI->bCancelled.store(true, std::memory_order_relaxed);
+	}
+
+	if (PendingAIMove.Job)
+	{
+		PendingAIMove.Job->Cancel();
+	}
+
+	// 放開工作的參照即可；工作結束後自行釋放
+	PendingAIMove = FPendingAIMove();
+}
+
+void ACardBattle::LogAIStats() const
+{
+	AIResponseLatency.LogPercentiles(TEXT("AI response latency"));
+	AISearchLatency.LogPercentiles(TEXT("AI search time"));
+}
+
+void ACardBattle::BroadcastFullState()
+{
+	for (int32 PlayerId = 0; PlayerId < 2; ++PlayerId)
+	{
+		HandChangedEvent.Broadcast(PlayerId);
+		ScoreChangedEvent.Broadcast(PlayerId, Sim.GetScore(PlayerId));
+	}
+
+	BattleStateChangedEvent.Broadcast(Sim.GetState());
+	TurnTimerTickEvent.Broadcast(GetRemainingTurnTime());
 }
 
 void ACardBattle::CreateHUD()
@@ -494,16 +707,7 @@ void ACardBattle::CreateHUD()
 		return;
 	}
 
-	// 啟用滑鼠游標和 UI 點擊
-	PC->bShowMouseCursor = true;
-	PC->bEnableClickEvents = true;
-	PC->bEnableMouseOverEvents = true;
-	
-	// 設置輸入模式為 UI 和遊戲都可以控制
-	FInputModeGameAndUI InputMode;
-	InputMode.SetLockMouseToViewportBehavior(EMouseLockMode::DoNotLock);
-	InputMode.SetHideCursorDuringCapture(false);
-	PC->SetInputMode(InputMode);
+	SetupHUDInput(PC);
 
 	// 創建 HUD Widget
 	if (HUDWidgetClass)
@@ -526,24 +730,57 @@ void ACardBattle::CreateHUD()
 	}
 }
 
-int32 ACardBattle::GetCardPower(int32 CardValue) const
+void ACardBattle::SetupHUDInput(APlayerController* PC)
 {
+	// 啟用滑鼠游標和 UI 點擊
+	PC->bShowMouseCursor = true;
+	PC->bEnableClickEvents = true;
+	PC->bEnableMouseOverEvents = true;
+	
+	// 設置輸入模式為 UI 和遊戲都可以控制
+	FInputModeGameAndUI InputMode;
+	InputMode.SetLockMouseToViewportBehavior(EMouseLockMode::DoNotLock);
+	InputMode.SetHideCursorDuringCapture(false);
+	PC->SetInputMode(InputMode);
+}
+
+void ACardBattle::RebuildPowerTable()
+{
+	if (const UCardCatalogSubsystem* Catalog = UCardCatalogSubsystem::Get(this))
+	{
+		Sim.SetPowerTable(Catalog->GetPowerTable());
+		return;
+	}
+
 	if (!CardDataTable)
 	{
-		// 如果沒有設定 DataTable，預設回傳 CardValue
-		return CardValue;
+		Sim.SetPowerTable(FCardPowerTable::GetDefault());
+		LocalPowerTableSource.Reset();
+		return;
+	}
+
+	if (LocalPowerTableSource == CardDataTable)
+	{
+		return;
 	}
 
-	// 假設 RowName 就是 CardValue 的字串形式
-	FName RowName = FName(*FString::FromInt(CardValue));
-	static const FString ContextString(TEXT("GetCardPower"));
-	FCardData* CardData = CardDataTable->FindRow<FCardData>(RowName, ContextString);
+	TSharedRef<FCardPowerTable, ESPMode::ThreadSafe> PowerTable = MakeShared<FCardPowerTable, ESPMode::ThreadSafe>();
+	PowerTable->Build(CardDataTable);
+	Sim.SetPowerTable(PowerTable);
+	LocalPowerTableSource = CardDataTable;
+}
 
-	if (CardData)
+void ACardBattle::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	CancelPendingAIMove();
+	LogAIStats();
+	ReplayArchive.Reset();
+
+	if (UCardCatalogSubsystem* Catalog = UCardCatalogSubsystem::Get(this))
 	{
-		return CardData->Power;
+		Catalog->OnCatalogChanged().Remove(CatalogChangedHandle);
 	}
+	CatalogChangedHandle.Reset();
 
-	// 找不到資料時回傳 0
-	return 0;
+	Super::EndPlay(EndPlayReason);
 }
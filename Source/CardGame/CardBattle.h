@@ -5,45 +5,31 @@
 #include "CoreMinimal.h"
 #include "GameFramework/GameModeBase.h"
 #include "Card.h"
-#include "BattlePlayer.h"
+#include "Sim/BattleSimCore.h"
+#include "Sim/BattleReplay.h"
+#include "Sim/BattleAction.h"
+#include "Sim/BattleSearchAI.h"
+#include "Sim/LatencySamples.h"
+#include "Sim/BattleAIWorkerPool.h"
+#include "Tasks/Task.h"
 #include "CardBattle.generated.h"
 
-
-// 遊戲狀態枚舉
+// AI 選牌方式 (難度)
 UENUM(BlueprintType)
-enum class EBattleState : uint8
+enum class EBattleAIType : uint8
 {
-	Idle = 0,			// 空閒
-	Started = 1,		// 遊戲已開始
-	WaitingForPlayer0 = 2,	// 等待玩家0出牌
-	WaitingForPlayer1 = 3,	// 等待玩家1出牌
-	RoundEnd = 4,		// 回合結束
-	GameOver = 5		// 遊戲結束
+	Random,		// 隨機出牌
+	Expectimax,	// 完整資訊的 Expectimax 搜尋
+	ISMCTS,		// 不看對手手牌的資訊集 MCTS (共用工作池)
 };
 
-// 回合信息
-USTRUCT(BlueprintType)
-struct FRoundInfo
-{
-	GENERATED_BODY()
-
-public:
-	UPROPERTY(BlueprintReadWrite)
-	FCard Player0Card;
-
-	UPROPERTY(BlueprintReadWrite)
-	FCard Player1Card;
-
-	UPROPERTY(BlueprintReadWrite)
-	int32 WinnerID; // 0, 1 或 -1 (平手)
-
-	FRoundInfo()
-		: Player0Card(FCard(0))
-		, Player1Card(FCard(0))
-		, WinnerID(-1)
-	{
-	}
-};
+// UI 事件 (HUD 只更新受影響的部分)
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnBattleScoreChanged, int32 /*PlayerId*/, int32 /*NewScore*/);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnBattleHandChanged, int32 /*PlayerId*/);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnBattleCardPlayed, int32 /*PlayerId*/, FCard /*PlayedCard*/);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnBattleStateChanged, EBattleState /*NewState*/);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnBattleTurnTimerTick, float /*RemainingTime*/);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnBattleActionProcessed, const FBattleActionResult& /*Result*/);
 
 /**
  * ACardBattle - 卡牌對戰的核心遊戲模式
@@ -57,33 +43,55 @@ public:
 	ACardBattle();
 
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void Tick(float DeltaTime) override;
 	virtual void PostLogin(APlayerController* NewPlayer) override;
 	virtual UClass* GetDefaultPawnClassForController_Implementation(AController* InController) override;
 
-	// 開始遊戲
+	// 開始遊戲 - 洗牌、先手與隨機出牌都使用以 Seed 建立的亂數流
+	// Seed 為 0 時自動產生新的種子 (可由 GetMatchSeed 取得以重現這局)
 	UFUNCTION(BlueprintCallable, Category = "Battle")
-	void StartGame();
+	void StartGame(int32 Seed = 0);
+
+	// 獲取這局的亂數種子
+	UFUNCTION(BlueprintCallable, Category = "Battle")
+	int32 GetMatchSeed() const { return MatchSeed; }
+
+	// 以這局的亂數流隨機選一張手牌的索引 (沒有手牌時回傳 INDEX_NONE)
+	int32 PickRandomCardIndex(int32 PlayerId);
 
 	// 結束遊戲
 	UFUNCTION(BlueprintCallable, Category = "Battle")
 	void EndGame();
 
-	// 玩家出牌 (由玩家輸入調用)
+	// 玩家出牌 (由玩家輸入調用) - 轉成出牌指令排入佇列，在本幀的 Tick 中執行
 	UFUNCTION(BlueprintCallable, Category = "Battle")
 	void PlayerPlayCard(int32 PlayerId, int32 CardIndex);
 
+	// 排入一個出牌指令 (玩家輸入、AI、逾時與網路層共用)
+	// 佇列在 Tick 中依序執行，執行期間新排入的指令 (例如 AI 回應) 也在同一幀處理
+	void SubmitAction(const FBattleAction& Action);
+
+	// 立刻執行佇列中的所有指令
+	void ProcessPendingActions();
+
+	// 座位由 AI 代打 (沒有真人玩家的 ACardBattlePlayerState 坐在這個座位)
+	bool IsAISeat(int32 SeatId) const;
+
 	// 獲取當前遊戲狀態
 	UFUNCTION(BlueprintCallable, Category = "Battle")
-	EBattleState GetBattleState() const { return CurrentState; }
+	EBattleState GetBattleState() const { return Sim.GetState(); }
 
 	// 獲取當前回合的玩家ID
 	UFUNCTION(BlueprintCallable, Category = "Battle")
-	int32 GetCurrentTurnPlayerId() const { return CurrentTurnPlayerId; }
+	int32 GetCurrentTurnPlayerId() const { return Sim.GetCurrentTurnPlayerId(); }
 
-	// 獲取玩家的手牌
+	// 獲取玩家的手牌 (Blueprint 用，回傳拷貝)
 	UFUNCTION(BlueprintCallable, Category = "Battle")
-	const TArray<FCard>& GetPlayerHand(int32 PlayerId) const;
+	TArray<FCard> GetPlayerHand(int32 PlayerId) const;
+
+	// 獲取玩家手牌的唯讀視圖 (C++ 用，不複製；依 CardValue 排序，索引與 PlayerPlayCard 一致)
+	TConstArrayView<FCard> GetPlayerHandView(int32 PlayerId) const;
 
 	// 獲取玩家的分數
 	UFUNCTION(BlueprintCallable, Category = "Battle")
@@ -93,33 +101,85 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Battle")
 	float GetRemainingTurnTime() const;
 
+	// 獲取每回合的時間限制
+	UFUNCTION(BlueprintCallable, Category = "Battle")
+	float GetTurnTimeLimit() const { return TurnTimeLimit; }
+
+	// HUD Widget 類別 (客戶端從 GameMode 類別預設值建立 HUD)
+	TSubclassOf<class UCardGameHUD> GetHUDWidgetClass() const { return HUDWidgetClass; }
+
+	// 啟用滑鼠游標與 UI 點擊，輸入模式設為 UI 和遊戲都可以控制
+	static void SetupHUDInput(APlayerController* PC);
+
 	// 獲取當前回合已出的牌
 	UFUNCTION(BlueprintCallable, Category = "Battle")
-	FCard GetCurrentPlayer0Card() const { return CurrentRoundPlayer0Card; }
+	FCard GetCurrentPlayer0Card() const { return Sim.GetCurrentRoundCard(0); }
 	
 	UFUNCTION(BlueprintCallable, Category = "Battle")
-	FCard GetCurrentPlayer1Card() const { return CurrentRoundPlayer1Card; }
+	FCard GetCurrentPlayer1Card() const { return Sim.GetCurrentRoundCard(1); }
 	
 	UFUNCTION(BlueprintCallable, Category = "Battle")
-	bool HasPlayer0PlayedCard() const { return bPlayer0CardPlayed; }
+	bool HasPlayer0PlayedCard() const { return Sim.HasPlayedThisRound(0); }
 	
 	UFUNCTION(BlueprintCallable, Category = "Battle")
-	bool HasPlayer1PlayedCard() const { return bPlayer1CardPlayed; }
+	bool HasPlayer1PlayedCard() const { return Sim.HasPlayedThisRound(1); }
 
 	// 獲取所有已出的牌（歷史記錄）
 	UFUNCTION(BlueprintCallable, Category = "Battle")
-	const TArray<FCard>& GetPlayer0PlayedCards() const { return Player0PlayedCards; }
+	TArray<FCard> GetPlayer0PlayedCards() const { return TArray<FCard>(Sim.GetPlayedCards(0)); }
 	
 	UFUNCTION(BlueprintCallable, Category = "Battle")
-	const TArray<FCard>& GetPlayer1PlayedCards() const { return Player1PlayedCards; }
+	TArray<FCard> GetPlayer1PlayedCards() const { return TArray<FCard>(Sim.GetPlayedCards(1)); }
+
+	// 獲取已出牌歷史的唯讀視圖 (C++ 用，不複製)
+	TConstArrayView<FCard> GetPlayedCardsView(int32 PlayerId) const;
 
 	// 獲取上一回合的信息
 	UFUNCTION(BlueprintCallable, Category = "Battle")
-	const FRoundInfo& GetLastRoundInfo() const { return LastRoundInfo; }
+	const FRoundInfo& GetLastRoundInfo() const { return Sim.GetLastRoundInfo(); }
 
 	// 獲取遊戲獲勝者 (只在遊戲結束時有效)
 	UFUNCTION(BlueprintCallable, Category = "Battle")
-	int32 GetWinner() const { return Winner; }
+	int32 GetWinner() const { return Sim.GetWinner(); }
+
+	// 輸出 AI 的思考延遲統計
+	void LogAIStats() const;
+
+	// 這局的出牌紀錄 (遊戲結束後包含最終分數)
+	const FBattleReplay& GetReplay() const { return MatchReplay; }
+
+	// 設定 AI 選牌方式 (下一步開始生效)
+	void SetAIType(EBattleAIType InAIType) { AIType = InAIType; }
+
+	// 設定附加紀錄的檔案 (空字串使用預設路徑；已開啟的檔案會被關閉)
+	void SetReplayArchivePath(const FString& InPath);
+
+	// 獲取規則核心 (唯讀)
+	const FBattleSimCore& GetSimCore() const { return Sim; }
+
+	// 獲取卡牌資料表
+	UDataTable* GetCardDataTable() const { return CardDataTable; }
+
+	// 本機玩家的 HUD (尚未建立時為 nullptr)
+	class UCardGameHUD* GetGameHUD() const { return GameHUD; }
+
+	// 分數改變
+	FOnBattleScoreChanged& OnScoreChanged() { return ScoreChangedEvent; }
+
+	// 手牌改變
+	FOnBattleHandChanged& OnHandChanged() { return HandChangedEvent; }
+
+	// 有玩家出牌 (已加入歷史記錄)
+	FOnBattleCardPlayed& OnCardPlayed() { return CardPlayedEvent; }
+
+	// 遊戲狀態或當前回合玩家改變
+	FOnBattleStateChanged& OnBattleStateChanged() { return BattleStateChangedEvent; }
+
+	// 每幀回合計時 (只在等待出牌時)
+	FOnBattleTurnTimerTick& OnTurnTimerTick() { return TurnTimerTickEvent; }
+
+	// 每個出牌指令執行後 (包含被拒絕的指令)
+	FOnBattleActionProcessed& OnActionProcessed() { return ActionProcessedEvent; }
 
 private:
 	// 初始化遊戲
@@ -129,45 +189,131 @@ private:
 	void ResetGame();
 
 	// 隨機決定先手玩家
-	void DetermineFirstPlayer();
+	int32 DetermineFirstPlayer();
 
-	// 進入下一個回合
-	void GoToNextTurn();
+	// 產生新的對戰種子 (不為 0)
+	static int32 GenerateMatchSeed();
 
 	// 處理當前回合時間
 	void HandleTurnTimer(float DeltaTime);
 
-	// 根據卡牌數值比較，決定本回合的勝者並計算分數
-	void ResolveRound(FCard Card0, FCard Card1);
+	// 出牌成功後的後續處理 (記錄、重置計時、輪到 AI 座位時讓 AI 出牌)
+	void OnCardCommitted(const FBattleAction& Action, FCard PlayedCard);
 
-	// 結算遊戲 - 檢查遊戲是否結束
-	bool CheckGameOver();
+	// 輪到 AI 座位且還沒有 AI 在計算時開始計算 (開局、出牌後與座位有人進出時)
+	void ScheduleAIMoveIfNeeded();
 
-	// 確定最終獲勝者
-	void DetermineWinner();
-
-	// AI 出牌
+	// AI 為目前回合的座位出牌 - 在工作執行緒上選牌，之後的 Tick 再把結果排入指令
 	void AIPlayCard();
 
+	// 檢查 AI 是否已選好牌 (每幀)
+	void UpdatePendingAIMove();
+
+	// 放棄還在計算的 AI 結果 (不等待工作執行緒)
+	void CancelPendingAIMove();
+
+	// AI 選牌方式
+	UPROPERTY(EditAnywhere, Category = "AI")
+	EBattleAIType AIType = EBattleAIType::Expectimax;
+
+	// AI 每步的搜尋節點上限 (ISMCTS 為迭代上限)
+	UPROPERTY(EditAnywhere, Category = "AI", meta = (EditCondition = "AIType != EBattleAIType::Random", ClampMin = "1"))
+	int32 AISearchNodeBudget = 500000;
+
+	// AI 每步的搜尋時間上限 (毫秒；ISMCTS 的排隊時間也算在內)
+	UPROPERTY(EditAnywhere, Category = "AI", meta = (EditCondition = "AIType != EBattleAIType::Random", ClampMin = "0.1"))
+	float AISearchTimeBudgetMs = 20.0f;
+
+	// AI 最短思考時間 (秒)，讓 AI 不會在玩家出牌的同一幀就回應
+	UPROPERTY(EditAnywhere, Category = "AI", meta = (ClampMin = "0"))
+	float AIMinThinkTime = 0.5f;
+
+	// Expectimax 搜尋與它的取消旗標 (一起重複使用，每步不需要配置)
+	struct FSearchAIContext
+	{
+		FBattleSearchAI AI;
+		std::atomic<bool> bCancelled { false };
+	};
+
+	// 搜尋 AI (第一次使用時建立，置換表在各局之間沿用)
+	// 由工作執行緒共用；被取消的工作還在執行時，下一次會建立新的實例
+	TSharedPtr<FSearchAIContext, ESPMode::ThreadSafe> SearchAI;
+
+	// ISMCTS 的搜尋 (同上：工作池不再持有時重複使用)
+	TSharedPtr<FBattleAIJob, ESPMode::ThreadSafe> MCTSJob;
+
+	// 正在計算的 AI 出牌
+	struct FPendingAIMove
+	{
+		// Expectimax 的工作
+		UE::Tasks::TTask<FBattleSearchResult> Task;
+
+		// ISMCTS 在共用工作池中的搜尋
+		TSharedPtr<FBattleAIJob, ESPMode::ThreadSafe> Job;
+
+		// 發出請求的時間、座位與當時的局面 (局面改變時丟棄結果)
+		double RequestTime = 0.0;
+		int32 PlayerId = INDEX_NONE;
+		int32 MatchSeed = 0;
+		int32 NumPlayedCards = 0;
+
+		bool bActive = false;
+		bool bLatencyRecorded = false;
+	};
+	FPendingAIMove PendingAIMove;
+
+	// 從請求到結果可用的延遲 (含排程) 與搜尋本身的時間
+	FLatencySamples AIResponseLatency;
+	FLatencySamples AISearchLatency;
+
+	// 等待執行的出牌指令
+	TArray<FBattleAction, TInlineAllocator<16>> PendingActions;
+
+	// 廣播所有 UI 事件 (開始或重置遊戲時)
+	void BroadcastFullState();
+
 	// 創建 HUD
 	void CreateHUD();
 
-	// 玩家列表
-	UPROPERTY()
-	UBattlePlayer* Players[2];
+	// 對戰規則核心 (手牌、分數、歷史與回合狀態)
+	FBattleSimCore Sim;
+
+	// 手牌的排序陣列 (只供 UI 顯示；規則核心使用位元遮罩)
+	FCard HandDisplay[2][FBattleSimCore::HandSize];
+	int32 HandDisplayNum[2] = { 0, 0 };
+
+	// 從規則核心更新手牌顯示陣列
+	void RefreshHandDisplay(int32 PlayerId);
+
+	// 這局的亂數種子與亂數流 (每局獨立，不使用全域亂數)
+	UPROPERTY(VisibleInstanceOnly, Category = "Battle")
+	int32 MatchSeed = 0;
+
+	FRandomStream MatchRandom;
+
+	// 出牌紀錄 (種子 + 依序打出的牌)
+	FBattleReplay MatchReplay;
+
+	// 遊戲結束時是否把紀錄附加到 Saved/Replays
+	UPROPERTY(EditAnywhere, Category = "Battle")
+	bool bSaveReplays = true;
+
+	// 附加紀錄的檔案 (空字串使用 FBattleReplay::GetDefaultArchivePath)
+	FString ReplayArchivePath;
+
+	// 第一次寫入時開啟，之後每局沿用 (EndPlay 時關閉)
+	TUniquePtr<FArchive> ReplayArchive;
+
+	// 序列化一筆紀錄的暫存 (每局重複使用)
+	TArray<uint8> ReplayRecordBuffer;
+
+	// 把這局的紀錄附加到檔案
+	void SaveMatchReplay();
 
 	// 玩家牌組
 	UPROPERTY()
 	UCardDeck* PlayerDecks[2];
 
-	// 當前遊戲狀態
-	UPROPERTY(BlueprintReadOnly, Category = "Battle", meta = (AllowPrivateAccess = "true"))
-	EBattleState CurrentState;
-
-	// 當前回合的玩家ID
-	UPROPERTY(BlueprintReadOnly, Category = "Battle", meta = (AllowPrivateAccess = "true"))
-	int32 CurrentTurnPlayerId;
-
 	// 當前回合剩餘時間 (秒)
 	UPROPERTY(BlueprintReadOnly, Category = "Battle", meta = (AllowPrivateAccess = "true"))
 	float CurrentTurnRemainingTime;
@@ -176,24 +322,6 @@ private:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Battle", meta = (AllowPrivateAccess = "true"))
 	float TurnTimeLimit;
 
-	// 上一回合的結果
-	FRoundInfo LastRoundInfo;
-
-	// 最終獲勝者 (-1 表示平手或遊戲未結束)
-	int32 Winner;
-
-	// 是否已出牌標誌
-	bool bPlayer0CardPlayed;
-	bool bPlayer1CardPlayed;
-
-	// 本回合出牌
-	FCard CurrentRoundPlayer0Card;
-	FCard CurrentRoundPlayer1Card;
-
-	// 已出牌歷史記錄
-	TArray<FCard> Player0PlayedCards;
-	TArray<FCard> Player1PlayedCards;
-
 	// HUD Widget
 	UPROPERTY()
 	TObjectPtr<class UCardGameHUD> GameHUD;
@@ -202,10 +330,23 @@ private:
 	UPROPERTY(EditDefaultsOnly, Category = "UI")
 	TSubclassOf<class UCardGameHUD> HUDWidgetClass;
 
-	// 卡牌資料表 (用於查詢 Power)
+	// 卡牌資料表 (設定給 UCardCatalogSubsystem 作為資料來源)
 	UPROPERTY(EditDefaultsOnly, Category = "Data")
 	TObjectPtr<class UDataTable> CardDataTable;
 
-	// 獲取卡牌的 Power 數值 (從 DataTable)
-	int32 GetCardPower(int32 CardValue) const;
+	// 從卡牌 Catalog 重建規則核心的數值表
+	void RebuildPowerTable();
+
+	// 沒有 Catalog 時從哪個資料表建立了數值表 (同一個資料表每局沿用，不重建)
+	TWeakObjectPtr<UDataTable> LocalPowerTableSource;
+
+	// Catalog 變更通知
+	FDelegateHandle CatalogChangedHandle;
+
+	FOnBattleScoreChanged ScoreChangedEvent;
+	FOnBattleHandChanged HandChangedEvent;
+	FOnBattleCardPlayed CardPlayedEvent;
+	FOnBattleStateChanged BattleStateChangedEvent;
+	FOnBattleTurnTimerTick TurnTimerTickEvent;
+	FOnBattleActionProcessed ActionProcessedEvent;
 };
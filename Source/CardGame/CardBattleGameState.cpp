@@ -0,0 +1,348 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CardBattleGameState.h"
+#include "CardBattle.h"
+#include "CardBattlePlayerState.h"
+#include "CardGameHUD.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "Net/UnrealNetwork.h"
+
+static FAutoConsoleCommandWithWorld GBattleNetStatsCommand(
+	TEXT("CardGame.NetStats"),
+	TEXT("Print replication bandwidth of the current battle (server only)."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const ACardBattleGameState* GameState = World ? World->GetGameState<ACardBattleGameState>() : nullptr)
+		{
+			GameState->LogNetStats();
+		}
+	}));
+
+ACardBattleGameState::ACardBattleGameState()
+{
+	SeatPlayers[0] = nullptr;
+	SeatPlayers[1] = nullptr;
+}
+
+void ACardBattleGameState::BeginPlay()
+{
+	Super::BeginPlay();
+
+	PlayedCards.OnReplicated().AddUObject(this, &ACardBattleGameState::OnRep_BattleState);
+
+	if (!HasAuthority())
+	{
+		CreateClientHUD();
+		return;
+	}
+
+	// GameMode 先於 GameState 開始遊戲，綁定後先完整同步一次
+	ACardBattle* Battle = GetWorld()->GetAuthGameMode<ACardBattle>();
+	if (!Battle)
+	{
+		return;
+	}
+
+	BattleMode = Battle;
+	HandChangedHandle = Battle->OnHandChanged().AddUObject(this, &ACardBattleGameState::HandleHandChanged);
+	ScoreChangedHandle = Battle->OnScoreChanged().AddUObject(this, &ACardBattleGameState::HandleScoreChanged);
+	CardPlayedHandle = Battle->OnCardPlayed().AddUObject(this, &ACardBattleGameState::HandleCardPlayed);
+	StateChangedHandle = Battle->OnBattleStateChanged().AddUObject(this, &ACardBattleGameState::HandleBattleStateChanged);
+
+	SyncFromBattle();
+}
+
+void ACardBattleGameState::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (ACardBattle* Battle = BattleMode.Get())
+	{
+		Battle->OnHandChanged().Remove(HandChangedHandle);
+		Battle->OnScoreChanged().Remove(ScoreChangedHandle);
+		Battle->OnCardPlayed().Remove(CardPlayedHandle);
+		Battle->OnBattleStateChanged().Remove(StateChangedHandle);
+	}
+	BattleMode.Reset();
+
+	if (ClientHUD)
+	{
+		ClientHUD->RemoveFromParent();
+		ClientHUD = nullptr;
+	}
+
+	PlayedCards.OnReplicated().RemoveAll(this);
+	ReplicatedStateChangedEvent.Clear();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ACardBattleGameState::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(ACardBattleGameState, BattleState);
+	DOREPLIFETIME(ACardBattleGameState, CurrentTurnPlayerId);
+	DOREPLIFETIME(ACardBattleGameState, Scores);
+	DOREPLIFETIME(ACardBattleGameState, HandCounts);
+	DOREPLIFETIME(ACardBattleGameState, TurnDeadlineServerTime);
+	DOREPLIFETIME(ACardBattleGameState, PlayedCards);
+}
+
+void ACardBattleGameState::AddPlayerState(APlayerState* PlayerState)
+{
+	Super::AddPlayerState(PlayerState);
+
+	if (HasAuthority())
+	{
+		AssignSeat(Cast<ACardBattlePlayerState>(PlayerState));
+	}
+}
+
+void ACardBattleGameState::RemovePlayerState(APlayerState* PlayerState)
+{
+	for (int32 SeatId = 0; SeatId < 2; ++SeatId)
+	{
+		if (SeatPlayers[SeatId] == PlayerState)
+		{
+			SeatPlayers[SeatId] = nullptr;
+		}
+	}
+
+	Super::RemovePlayerState(PlayerState);
+}
+
+void ACardBattleGameState::AssignSeat(ACardBattlePlayerState* PlayerState)
+{
+	if (!PlayerState || PlayerState->IsInactive())
+	{
+		return;
+	}
+
+	for (int32 SeatId = 0; SeatId < 2; ++SeatId)
+	{
+		if (!SeatPlayers[SeatId])
+		{
+			SeatPlayers[SeatId] = PlayerState;
+			PlayerState->SetSeatId(SeatId);
+
+			if (const ACardBattle* Battle = BattleMode.Get())
+			{
+				PlayerState->SyncHand(Battle->GetSimCore().GetHand(SeatId));
+			}
+			return;
+		}
+	}
+}
+
+void ACardBattleGameState::CreateClientHUD()
+{
+	// 客戶端沒有 GameMode 實例，HUD 類別取自複製的 GameMode 類別預設值
+	const ACardBattle* DefaultBattle = GetDefaultGameMode<ACardBattle>();
+	APlayerController* PC = GetWorld()->GetFirstPlayerController();
+	if (!DefaultBattle || !DefaultBattle->GetHUDWidgetClass() || !PC)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Cannot create client HUD: missing GameMode class, HUDWidgetClass or PlayerController"));
+		return;
+	}
+
+	ACardBattle::SetupHUDInput(PC);
+
+	ClientHUD = CreateWidget<UCardGameHUD>(PC, DefaultBattle->GetHUDWidgetClass());
+	if (ClientHUD)
+	{
+		ClientHUD->InitializeHUDFromReplicatedState(this);
+		ClientHUD->AddToViewport();
+	}
+}
+
+bool ACardBattleGameState::IsSeatHuman(int32 SeatId) const
+{
+	const ACardBattlePlayerState* PlayerState = GetSeatPlayerState(SeatId);
+	return PlayerState && !PlayerState->IsABot() && !PlayerState->IsInactive();
+}
+
+ACardBattlePlayerState* ACardBattleGameState::GetSeatPlayerState(int32 SeatId) const
+{
+	if (SeatId < 0 || SeatId > 1)
+	{
+		return nullptr;
+	}
+
+	if (HasAuthority())
+	{
+		return SeatPlayers[SeatId];
+	}
+
+	// 客戶端從 PlayerArray 找 (SeatPlayers 不複製)
+	for (APlayerState* PlayerState : PlayerArray)
+	{
+		ACardBattlePlayerState* BattlePlayerState = Cast<ACardBattlePlayerState>(PlayerState);
+		if (BattlePlayerState && BattlePlayerState->GetSeatId() == SeatId)
+		{
+			return BattlePlayerState;
+		}
+	}
+	return nullptr;
+}
+
+float ACardBattleGameState::GetRemainingTurnTime() const
+{
+	return FMath::Max(0.0f, (float)(TurnDeadlineServerTime - GetServerWorldTimeSeconds()));
+}
+
+void ACardBattleGameState::HandleHandChanged(int32 PlayerId)
+{
+	const ACardBattle* Battle = BattleMode.Get();
+	if (!Battle || PlayerId < 0 || PlayerId > 1)
+	{
+		return;
+	}
+
+	const FCardHand& Hand = Battle->GetSimCore().GetHand(PlayerId);
+	HandCounts[PlayerId] = Hand.Num();
+
+	if (SeatPlayers[PlayerId])
+	{
+		SeatPlayers[PlayerId]->SyncHand(Hand);
+	}
+}
+
+void ACardBattleGameState::HandleScoreChanged(int32 PlayerId, int32 NewScore)
+{
+	if (PlayerId >= 0 && PlayerId < 2)
+	{
+		Scores[PlayerId] = NewScore;
+	}
+}
+
+void ACardBattleGameState::HandleCardPlayed(int32 PlayerId, FCard PlayedCard)
+{
+	PlayedCards.AddCard(PlayerId, PlayedCard.CardValue);
+}
+
+void ACardBattleGameState::HandleBattleStateChanged(EBattleState NewState)
+{
+	const ACardBattle* Battle = BattleMode.Get();
+	if (!Battle)
+	{
+		return;
+	}
+
+	const EBattleState PreviousState = BattleState;
+	BattleState = NewState;
+	CurrentTurnPlayerId = Battle->GetCurrentTurnPlayerId();
+
+	// 每次出牌或開局後計時都會重置，只在這時送出新的截止時間
+	TurnDeadlineServerTime = GetServerWorldTimeSeconds() + Battle->GetRemainingTurnTime();
+
+	// 重新開局時歷史已清空
+	const FBattleSimCore& Sim = Battle->GetSimCore();
+	if (PlayedCards.Num() > Sim.GetPlayedCards(0).Num() + Sim.GetPlayedCards(1).Num())
+	{
+		SyncFromBattle();
+	}
+
+	if (PreviousState == EBattleState::Idle && NewState != EBattleState::Idle)
+	{
+		MatchStartOutBytes = GetTotalClientOutBytes();
+		MatchStartTime = GetWorld()->GetTimeSeconds();
+	}
+	else if (PreviousState != EBattleState::GameOver && NewState == EBattleState::GameOver)
+	{
+		LastMatchOutBytes = GetTotalClientOutBytes() - MatchStartOutBytes;
+		LogNetStats();
+	}
+}
+
+void ACardBattleGameState::SyncFromBattle()
+{
+	const ACardBattle* Battle = BattleMode.Get();
+	if (!Battle)
+	{
+		return;
+	}
+
+	const FBattleSimCore& Sim = Battle->GetSimCore();
+	BattleState = Sim.GetState();
+	CurrentTurnPlayerId = Sim.GetCurrentTurnPlayerId();
+	TurnDeadlineServerTime = GetServerWorldTimeSeconds() + Battle->GetRemainingTurnTime();
+
+	PlayedCards.ResetCards();
+	for (int32 PlayerId = 0; PlayerId < 2; ++PlayerId)
+	{
+		Scores[PlayerId] = Sim.GetScore(PlayerId);
+		HandCounts[PlayerId] = Sim.GetHandNum(PlayerId);
+
+		for (const FCard& Card : Sim.GetPlayedCards(PlayerId))
+		{
+			PlayedCards.AddCard(PlayerId, Card.CardValue);
+		}
+
+		if (SeatPlayers[PlayerId])
+		{
+			SeatPlayers[PlayerId]->SyncHand(Sim.GetHand(PlayerId));
+		}
+	}
+}
+
+int64 ACardBattleGameState::GetTotalClientOutBytes() const
+{
+	const UNetDriver* NetDriver = GetWorld() ? GetWorld()->GetNetDriver() : nullptr;
+	if (!NetDriver)
+	{
+		return 0;
+	}
+
+	int64 TotalBytes = 0;
+	for (const UNetConnection* Connection : NetDriver->ClientConnections)
+	{
+		if (Connection)
+		{
+			TotalBytes += (int64)Connection->OutTotalBytes;
+		}
+	}
+	return TotalBytes;
+}
+
+int32 ACardBattleGameState::GetNumClientConnections() const
+{
+	const UNetDriver* NetDriver = GetWorld() ? GetWorld()->GetNetDriver() : nullptr;
+	return NetDriver ? NetDriver->ClientConnections.Num() : 0;
+}
+
+void ACardBattleGameState::LogNetStats() const
+{
+	const UNetDriver* NetDriver = GetWorld() ? GetWorld()->GetNetDriver() : nullptr;
+	if (!NetDriver || !HasAuthority())
+	{
+		UE_LOG(LogTemp, Display, TEXT("CardGame.NetStats: no server net driver (run on a listen or dedicated server)"));
+		return;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("========== BATTLE NET STATS =========="));
+	for (const UNetConnection* Connection : NetDriver->ClientConnections)
+	{
+		if (Connection)
+		{
+			UE_LOG(LogTemp, Display, TEXT("  %s: out %lld bytes, in %lld bytes"),
+				*Connection->LowLevelGetRemoteAddress(true), (int64)Connection->OutTotalBytes, (int64)Connection->InTotalBytes);
+		}
+	}
+
+	const int64 MatchBytes = GetTotalClientOutBytes() - MatchStartOutBytes;
+	const int32 NumClients = FMath::Max(1, NetDriver->ClientConnections.Num());
+	const int32 NumPlays = PlayedCards.Num();
+	const double MatchSeconds = FMath::Max(GetWorld()->GetTimeSeconds() - MatchStartTime, 1e-3);
+
+	// 包含連線本身的固定開銷 (心跳、時間同步)，與沒有出牌的閒置時段比較即可得到對戰本身的頻寬
+	UE_LOG(LogTemp, Display, TEXT("This match: %lld bytes to %d clients (%lld per client), %d plays (%.0f bytes/play/client), %.0f bytes/s/client"),
+		MatchBytes, NumClients, MatchBytes / NumClients, NumPlays,
+		NumPlays > 0 ? (double)MatchBytes / NumClients / NumPlays : 0.0, (double)MatchBytes / NumClients / MatchSeconds);
+	UE_LOG(LogTemp, Display, TEXT("======================================"));
+}
+
+void ACardBattleGameState::OnRep_BattleState()
+{
+	ReplicatedStateChangedEvent.Broadcast();
+}
@@ -0,0 +1,123 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/GameStateBase.h"
+#include "Sim/BattleTypes.h"
+#include "BattleCardArray.h"
+#include "CardBattleGameState.generated.h"
+
+/**
+ * ACardBattleGameState - 複製給所有客戶端的對戰狀態
+ * 伺服器上監聽 ACardBattle 的事件並同步：狀態、回合、分數、雙方手牌張數與出牌歷史
+ * (FFastArraySerializer，每次出牌只送一個項目)。手牌內容由各自的 ACardBattlePlayerState 只複製給擁有者。
+ * 回合計時只在換手時送出截止時間，客戶端以伺服器時間自行倒數。
+ * 客戶端在 BeginPlay 建立由這些複製狀態驅動的 UCardGameHUD。
+ */
+UCLASS()
+class CARDGAME_API ACardBattleGameState : public AGameStateBase
+{
+	GENERATED_BODY()
+
+public:
+	ACardBattleGameState();
+
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	virtual void AddPlayerState(APlayerState* PlayerState) override;
+	virtual void RemovePlayerState(APlayerState* PlayerState) override;
+
+	EBattleState GetBattleState() const { return BattleState; }
+	int32 GetCurrentTurnPlayerId() const { return CurrentTurnPlayerId; }
+	int32 GetScore(int32 PlayerId) const { return (PlayerId >= 0 && PlayerId < 2) ? Scores[PlayerId] : 0; }
+	int32 GetHandCount(int32 PlayerId) const { return (PlayerId >= 0 && PlayerId < 2) ? HandCounts[PlayerId] : 0; }
+
+	// 以伺服器時間計算的回合剩餘時間
+	float GetRemainingTurnTime() const;
+
+	// 某位玩家已出的牌 (依出牌順序)
+	void GetPlayedCards(int32 PlayerId, TArray<FCard>& OutCards) const { PlayedCards.GetCards(PlayerId, OutCards); }
+
+	// 坐在該座位的玩家 (沒有真人玩家時為 nullptr，例如 AI)
+	class ACardBattlePlayerState* GetSeatPlayerState(int32 SeatId) const;
+
+	// 座位上坐著真人玩家 (伺服器以此決定 AI 代打哪些座位)
+	bool IsSeatHuman(int32 SeatId) const;
+
+	// 客戶端收到狀態、分數或出牌歷史的變更
+	FSimpleMulticastDelegate& OnReplicatedStateChanged() { return ReplicatedStateChangedEvent; }
+
+	// 輸出每個客戶端連線目前的傳送量與本局的平均值
+	void LogNetStats() const;
+
+	// 上一局 (開局到遊戲結束) 送給所有客戶端的位元組 (伺服器；還沒有結束的對戰時為 INDEX_NONE)
+	int64 GetLastMatchOutBytes() const { return LastMatchOutBytes; }
+
+	// 目前連線的客戶端數 (伺服器)
+	int32 GetNumClientConnections() const;
+
+private:
+	// ACardBattle 事件 (伺服器)
+	void HandleHandChanged(int32 PlayerId);
+	void HandleScoreChanged(int32 PlayerId, int32 NewScore);
+	void HandleCardPlayed(int32 PlayerId, FCard PlayedCard);
+	void HandleBattleStateChanged(EBattleState NewState);
+
+	// 從 GameMode 重新同步全部狀態 (伺服器)
+	void SyncFromBattle();
+
+	// 建立讀取複製狀態的 HUD (客戶端)
+	void CreateClientHUD();
+
+	// 分配空的座位 (伺服器)
+	void AssignSeat(class ACardBattlePlayerState* PlayerState);
+
+	// 所有客戶端連線已送出的位元組總和
+	int64 GetTotalClientOutBytes() const;
+
+	UFUNCTION()
+	void OnRep_BattleState();
+
+	UPROPERTY(ReplicatedUsing = OnRep_BattleState)
+	EBattleState BattleState = EBattleState::Idle;
+
+	UPROPERTY(ReplicatedUsing = OnRep_BattleState)
+	int32 CurrentTurnPlayerId = 0;
+
+	UPROPERTY(ReplicatedUsing = OnRep_BattleState)
+	int32 Scores[2] = { 0, 0 };
+
+	UPROPERTY(ReplicatedUsing = OnRep_BattleState)
+	int32 HandCounts[2] = { 0, 0 };
+
+	// 回合截止的伺服器時間
+	UPROPERTY(ReplicatedUsing = OnRep_BattleState)
+	double TurnDeadlineServerTime = 0.0;
+
+	UPROPERTY(Replicated)
+	FBattleCardArray PlayedCards;
+
+	// 各座位的玩家 (伺服器)
+	UPROPERTY(Transient)
+	TObjectPtr<class ACardBattlePlayerState> SeatPlayers[2];
+
+	TWeakObjectPtr<class ACardBattle> BattleMode;
+
+	// 客戶端的 HUD
+	UPROPERTY(Transient)
+	TObjectPtr<class UCardGameHUD> ClientHUD;
+
+	FDelegateHandle HandChangedHandle;
+	FDelegateHandle ScoreChangedHandle;
+	FDelegateHandle CardPlayedHandle;
+	FDelegateHandle StateChangedHandle;
+
+	// 本局開始時的傳送量 (用於計算每局頻寬)
+	int64 MatchStartOutBytes = 0;
+	double MatchStartTime = 0.0;
+	int64 LastMatchOutBytes = INDEX_NONE;
+
+	FSimpleMulticastDelegate ReplicatedStateChangedEvent;
+};
@@ -0,0 +1,31 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CardBattlePlayerState.h"
+#include "CardBattle.h"
+#include "Engine/World.h"
+#include "Net/UnrealNetwork.h"
+#include "Sim/BattleAction.h"
+
+void ACardBattlePlayerState::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(ACardBattlePlayerState, SeatId);
+
+	// 對手的手牌內容永遠不離開伺服器
+	DOREPLIFETIME_CONDITION(ACardBattlePlayerState, Hand, COND_OwnerOnly);
+}
+
+void ACardBattlePlayerState::ServerPlayCard_Implementation(int32 CardValue)
+{
+	// 觀戰者沒有座位；輪到誰與手牌是否有這張牌由規則核心檢查
+	if (SeatId < 0 || SeatId > 1)
+	{
+		return;
+	}
+
+	if (ACardBattle* Battle = GetWorld()->GetAuthGameMode<ACardBattle>())
+	{
+		Battle->SubmitAction(FBattleAction::MakePlayCard(SeatId, CardValue, EBattleActionSource::Network));
+	}
+}
@@ -0,0 +1,47 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/PlayerState.h"
+#include "BattleCardArray.h"
+#include "CardBattlePlayerState.generated.h"
+
+/**
+ * ACardBattlePlayerState - 玩家的座位與手牌
+ * 手牌內容只複製給擁有者 (COND_OwnerOnly)，對手只能從 ACardBattleGameState 得知張數。
+ */
+UCLASS()
+class CARDGAME_API ACardBattlePlayerState : public APlayerState
+{
+	GENERATED_BODY()
+
+public:
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	// 座位 (0 或 1；觀戰者為 INDEX_NONE)
+	int32 GetSeatId() const { return SeatId; }
+
+	// 設定座位 (伺服器)
+	void SetSeatId(int32 InSeatId) { SeatId = InSeatId; }
+
+	// 與規則核心的手牌同步 (伺服器)
+	void SyncHand(const FCardHand& InHand) { Hand.SyncHand(SeatId, InHand); }
+
+	// 手牌 (只有擁有者與伺服器有內容)
+	FCardHand GetHand() const { return Hand.GetHand(); }
+
+	// 客戶端收到手牌變更
+	FSimpleMulticastDelegate& OnHandReplicated() { return Hand.OnReplicated(); }
+
+	// 客戶端要求出牌 (以牌值指定，由伺服器的 ACardBattle 驗證)
+	UFUNCTION(Server, Reliable)
+	void ServerPlayCard(int32 CardValue);
+
+private:
+	UPROPERTY(Replicated)
+	int32 SeatId = INDEX_NONE;
+
+	UPROPERTY(Replicated)
+	FBattleCardArray Hand;
+};
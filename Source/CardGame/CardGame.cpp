@@ -2,5 +2,54 @@
 
 #include "CardGame.h"
 #include "Modules/ModuleManager.h"
+#include "Misc/CoreDelegates.h"
+#include "Sim/BattleTrace.h"
 
-IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, CardGame, "CardGame" );
+DEFINE_STAT(STAT_CardGame_ProcessActions);
+DEFINE_STAT(STAT_CardGame_PlayerPlayCard);
+DEFINE_STAT(STAT_CardGame_CardCommitted);
+DEFINE_STAT(STAT_CardGame_UpdateUI);
+DEFINE_STAT(STAT_CardGame_UpdatePlayerHand);
+DEFINE_STAT(STAT_CardGame_UpdatePlayedCards);
+DEFINE_STAT(STAT_CardGame_UpdateCardDisplay);
+DEFINE_STAT(STAT_CardGame_WidgetsCreated);
+DEFINE_STAT(STAT_CardGame_WidgetsReused);
+DEFINE_STAT(STAT_CardGame_WidgetsPooled);
+DEFINE_STAT(STAT_CardGame_TextureLoads);
+DEFINE_STAT(STAT_CardGame_TextureResidentHits);
+DEFINE_STAT(STAT_CardGame_AIPlayCard);
+DEFINE_STAT(STAT_CardGame_AISearch);
+DEFINE_STAT(STAT_CardGame_AISlice);
+DEFINE_STAT(STAT_CardGame_AIThinkTimeMs);
+
+UE_TRACE_CHANNEL_DEFINE(CardGameChannel);
+
+TRACE_DECLARE_INT_COUNTER(CardGame_WidgetsCreated, TEXT("CardGame/Widgets Created"));
+TRACE_DECLARE_INT_COUNTER(CardGame_WidgetsReused, TEXT("CardGame/Widgets Reused"));
+TRACE_DECLARE_INT_COUNTER(CardGame_WidgetsPooled, TEXT("CardGame/Widgets Pooled"));
+TRACE_DECLARE_INT_COUNTER(CardGame_TextureLoads, TEXT("CardGame/Texture Loads"));
+TRACE_DECLARE_INT_COUNTER(CardGame_TextureResidentHits, TEXT("CardGame/Texture Resident Hits"));
+TRACE_DECLARE_FLOAT_COUNTER(CardGame_AIThinkTimeMs, TEXT("CardGame/AI Think Time (ms)"));
+
+/**
+ * FCardGameModule - 遊戲主模組
+ * 崩潰時輸出最近的對戰事件紀錄 (FBattleTrace)。
+ */
+class FCardGameModule : public FDefaultGameModuleImpl
+{
+public:
+	virtual void StartupModule() override
+	{
+		SystemErrorHandle = FCoreDelegates::OnHandleSystemError.AddStatic(&FBattleTrace::DumpOnCrash);
+	}
+
+	virtual void ShutdownModule() override
+	{
+		FCoreDelegates::OnHandleSystemError.Remove(SystemErrorHandle);
+	}
+
+private:
+	FDelegateHandle SystemErrorHandle;
+};
+
+IMPLEMENT_PRIMARY_GAME_MODULE( FCardGameModule, CardGame, "CardGame" );
@@ -3,4 +3,51 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CountersTrace.h"
 
+// stat cardgame：規則、HUD 對帳、卡牌元件、貼圖載入與 AI 思考時間
+DECLARE_STATS_GROUP(TEXT("CardGame"), STATGROUP_CardGame, STATCAT_Advanced);
+
+// 規則
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Rules: Process Actions"), STAT_CardGame_ProcessActions, STATGROUP_CardGame, CARDGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Rules: PlayerPlayCard"), STAT_CardGame_PlayerPlayCard, STATGROUP_CardGame, CARDGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Rules: Card Committed"), STAT_CardGame_CardCommitted, STATGROUP_CardGame, CARDGAME_API);
+
+// HUD
+DECLARE_CYCLE_STAT_EXTERN(TEXT("HUD: UpdateUI"), STAT_CardGame_UpdateUI, STATGROUP_CardGame, CARDGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("HUD: UpdatePlayerHand"), STAT_CardGame_UpdatePlayerHand, STATGROUP_CardGame, CARDGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("HUD: UpdatePlayedCards"), STAT_CardGame_UpdatePlayedCards, STATGROUP_CardGame, CARDGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("HUD: UpdateCardDisplay"), STAT_CardGame_UpdateCardDisplay, STATGROUP_CardGame, CARDGAME_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Widgets Created"), STAT_CardGame_WidgetsCreated, STATGROUP_CardGame, CARDGAME_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Widgets Reused"), STAT_CardGame_WidgetsReused, STATGROUP_CardGame, CARDGAME_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Widgets Pooled (free)"), STAT_CardGame_WidgetsPooled, STATGROUP_CardGame, CARDGAME_API);
+
+// 貼圖
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Texture Loads Requested"), STAT_CardGame_TextureLoads, STATGROUP_CardGame, CARDGAME_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Texture Resident Hits"), STAT_CardGame_TextureResidentHits, STATGROUP_CardGame, CARDGAME_API);
+
+// AI
+DECLARE_CYCLE_STAT_EXTERN(TEXT("AI: AIPlayCard"), STAT_CardGame_AIPlayCard, STATGROUP_CardGame, CARDGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("AI: Expectimax Search"), STAT_CardGame_AISearch, STATGROUP_CardGame, CARDGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("AI: ISMCTS Slice"), STAT_CardGame_AISlice, STATGROUP_CardGame, CARDGAME_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("AI Think Time (ms)"), STAT_CardGame_AIThinkTimeMs, STATGROUP_CardGame, CARDGAME_API);
+
+// Insights：-trace=cpu,counters,cardgame
+UE_TRACE_CHANNEL_EXTERN(CardGameChannel, CARDGAME_API);
+
+TRACE_DECLARE_INT_COUNTER_EXTERN(CardGame_WidgetsCreated);
+TRACE_DECLARE_INT_COUNTER_EXTERN(CardGame_WidgetsReused);
+TRACE_DECLARE_INT_COUNTER_EXTERN(CardGame_WidgetsPooled);
+TRACE_DECLARE_INT_COUNTER_EXTERN(CardGame_TextureLoads);
+TRACE_DECLARE_INT_COUNTER_EXTERN(CardGame_TextureResidentHits);
+TRACE_DECLARE_FLOAT_COUNTER_EXTERN(CardGame_AIThinkTimeMs);
+
+// 計時區段只送出一個事件：有 STATS 時 stat 區段在 -trace=cpu 下本身就會出現在 Insights，
+// 沒有 STATS 的組態 (Test/Shipping) 才改用 CardGame 頻道的 CPU 事件
+#if STATS
+#define CARDGAME_SCOPE_CYCLE_COUNTER(Name) SCOPE_CYCLE_COUNTER(STAT_CardGame_##Name)
+#else
+#define CARDGAME_SCOPE_CYCLE_COUNTER(Name) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(CardGame_##Name, CardGameChannel)
+#endif
@@ -1,8 +1,13 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "CardGameHUD.h"
+#include "CardGame.h"
+#include "CardBattleGameState.h"
+#include "CardBattlePlayerState.h"
 #include "UI/CardWidget.h"
+#include "UI/CardWidgetPool.h"
 #include "Data/DT_CardData.h"
+#include "Data/CardCatalogSubsystem.h"
 #include "Components/TextBlock.h"
 #include "Components/Button.h"
 #include "Components/HorizontalBox.h"
@@ -14,16 +19,17 @@
 #include "Kismet/GameplayStatics.h"
 #include "UI/CardDragDropOperation.h"
 
+// 檯面上卡牌的縮放
+static constexpr float BoardCardScale = 0.8f;
+
 void UCardGameHUD::NativeConstruct()
 {
 	Super::NativeConstruct();
 
 	// 自動尋找 GameMode
-	if (!BattleGameMode)
-	{
-		AGameModeBase* GameMode = UGameplayStatics::GetGameMode(GetWorld());
-		BattleGameMode = Cast<ACardBattle>(GameMode);
-	}
+	ACardBattle* GameMode = BattleGameMode ? BattleGameMode.Get() : Cast<ACardBattle>(UGameplayStatics::GetGameMode(GetWorld()));
+	BindBattleEvents(GameMode);
+	BindCardCatalog();
 
 	// 嘗試將手牌容器置中
 	if (Player0HandBox)
@@ -68,71 +74,552 @@ void UCardGameHUD::NativeConstruct()
 		Player1CardBoardBorder->SetPadding(FMargin(2.0f));
 		Player1CardBoardBorder->SetBrushColor(FLinearColor(1.0f, 1.0f, 1.0f, 0.0f));
 	}
+
+	// 套用檯面初始外觀
+	UpdateBoardHover(0, Player0CardBoard, true);
+	UpdateBoardHover(1, Player1CardBoard, true);
+
+	// 重新加入畫面時做一次完整刷新
+	UpdateUI();
+}
+
+void UCardGameHUD::NativeDestruct()
+{
+	UnbindBattleEvents();
+	UnbindReplicatedState();
+
+	if (CardWidgetPool)
+	{
+		CardWidgetPool->LogStats();
+	}
+
+	if (CardCatalog)
+	{
+		CardCatalog->OnCatalogChanged().Remove(CatalogChangedHandle);
+		CatalogChangedHandle.Reset();
+		CardCatalog = nullptr;
+	}
+
+	Super::NativeDestruct();
 }
 
 void UCardGameHUD::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
 {
 	Super::NativeTick(MyGeometry, InDeltaTime);
 
-	// 每幀更新 UI
-	UpdateUI();
+	// 其他 UI 都由 ACardBattle (或複製狀態) 的事件驅動更新，這裡只追蹤檯面 Hover 與畫面寬度的變化
+	UpdateBoardHover(0, Player0CardBoard);
+	UpdateBoardHover(1, Player1CardBoard);
+	UpdateFanLayoutViewport(MyGeometry.GetLocalSize().X);
+
+	// 客戶端：計時以伺服器時間在本地倒數，自己的 PlayerState 到達或換座位時重新綁定
+	if (ReplicatedGameState)
+	{
+		BindLocalPlayerState();
+		UpdateTimerDisplay(ReplicatedGameState->GetRemainingTurnTime());
+	}
 }
 
 void UCardGameHUD::InitializeHUD(ACardBattle* InBattleGameMode)
 {
+	BindBattleEvents(InBattleGameMode);
+	BindCardCatalog();
+
+	// 預先建立對戰期間需要的所有卡牌 Widget
+	if (UCardWidgetPool* Pool = GetCardWidgetPool())
+	{
+		Pool->Prewarm(CardWidgetPoolPrewarmCount);
+	}
+
+	UpdateUI();
+}
+
+void UCardGameHUD::InitializeHUDFromReplicatedState(ACardBattleGameState* InGameState)
+{
+	BindReplicatedState(InGameState);
+	BindCardCatalog();
+
+	if (UCardWidgetPool* Pool = GetCardWidgetPool())
+	{
+		Pool->Prewarm(CardWidgetPoolPrewarmCount);
+	}
+
+	UpdateUI();
+}
+
+UCardWidgetPool* UCardGameHUD::GetCardWidgetPool()
+{
+	if (!CardWidgetPool)
+	{
+		CardWidgetPool = NewObject<UCardWidgetPool>(this);
+	}
+
+	CardWidgetPool->Initialize(this, CardWidgetClass);
+	return CardWidgetPool;
+}
+
+UCardWidget* UCardGameHUD::AcquireCardWidget()
+{
+	if (!CardWidgetClass)
+	{
+		return nullptr;
+	}
+
+	UCardWidgetPool* Pool = GetCardWidgetPool();
+	return Pool ? Pool->Acquire() : nullptr;
+}
+
+void UCardGameHUD::BindBattleEvents(ACardBattle* InBattleGameMode)
+{
+	if (BoundBattleGameMode == InBattleGameMode && BoundBattleGameMode)
+	{
+		return;
+	}
+
+	UnbindBattleEvents();
+
 	BattleGameMode = InBattleGameMode;
+	BoundBattleGameMode = InBattleGameMode;
+
+	if (!BattleGameMode)
+	{
+		return;
+	}
+
+	BattleGameMode->OnScoreChanged().AddUObject(this, &UCardGameHUD::HandleScoreChanged);
+	BattleGameMode->OnHandChanged().AddUObject(this, &UCardGameHUD::HandleHandChanged);
+	BattleGameMode->OnCardPlayed().AddUObject(this, &UCardGameHUD::HandleCardPlayed);
+	BattleGameMode->OnBattleStateChanged().AddUObject(this, &UCardGameHUD::HandleBattleStateChanged);
+	BattleGameMode->OnTurnTimerTick().AddUObject(this, &UCardGameHUD::HandleTurnTimerTick);
+}
+
+void UCardGameHUD::UnbindBattleEvents()
+{
+	if (ACardBattle* OldGameMode = BoundBattleGameMode.Get())
+	{
+		OldGameMode->OnScoreChanged().RemoveAll(this);
+		OldGameMode->OnHandChanged().RemoveAll(this);
+		OldGameMode->OnCardPlayed().RemoveAll(this);
+		OldGameMode->OnBattleStateChanged().RemoveAll(this);
+		OldGameMode->OnTurnTimerTick().RemoveAll(this);
+	}
+	BoundBattleGameMode.Reset();
+}
+
+void UCardGameHUD::BindReplicatedState(ACardBattleGameState* InGameState)
+{
+	if (ReplicatedGameState == InGameState && ReplicatedGameState)
+	{
+		return;
+	}
+
+	UnbindReplicatedState();
+
+	ReplicatedGameState = InGameState;
+	if (!ReplicatedGameState)
+	{
+		return;
+	}
+
+	ReplicatedGameState->OnReplicatedStateChanged().AddUObject(this, &UCardGameHUD::HandleReplicatedStateChanged);
+	BindLocalPlayerState();
+}
+
+void UCardGameHUD::UnbindReplicatedState()
+{
+	if (ACardBattlePlayerState* OldPlayerState = BoundPlayerState.Get())
+	{
+		OldPlayerState->OnHandReplicated().RemoveAll(this);
+	}
+	BoundPlayerState.Reset();
+
+	if (ReplicatedGameState)
+	{
+		ReplicatedGameState->OnReplicatedStateChanged().RemoveAll(this);
+		ReplicatedGameState = nullptr;
+	}
+
+	LocalSeatId = 0;
+}
+
+void UCardGameHUD::BindLocalPlayerState()
+{
+	ACardBattlePlayerState* PlayerState = GetOwningPlayerState<ACardBattlePlayerState>();
+	const int32 SeatId = PlayerState ? FMath::Max(PlayerState->GetSeatId(), 0) : 0;
+	if (BoundPlayerState == PlayerState && LocalSeatId == SeatId)
+	{
+		return;
+	}
+
+	if (ACardBattlePlayerState* OldPlayerState = BoundPlayerState.Get())
+	{
+		OldPlayerState->OnHandReplicated().RemoveAll(this);
+	}
+
+	BoundPlayerState = PlayerState;
+	LocalSeatId = SeatId;
+	if (PlayerState)
+	{
+		PlayerState->OnHandReplicated().AddUObject(this, &UCardGameHUD::HandleReplicatedHandChanged);
+	}
+
+	UpdateUI();
+}
+
+void UCardGameHUD::HandleReplicatedStateChanged()
+{
+	// 一次網路更新可能觸發多個 OnRep；UpdateUI 只會改動有差異的元件
 	UpdateUI();
 }
 
+void UCardGameHUD::HandleReplicatedHandChanged()
+{
+	RefreshReplicatedCards();
+
+	UHorizontalBox* HandBox = LocalSeatId == 0 ? Player0HandBox.Get() : Player1HandBox.Get();
+	if (HandBox)
+	{
+		UpdatePlayerHand(LocalSeatId, HandBox);
+	}
+}
+
+void UCardGameHUD::RefreshReplicatedCards()
+{
+	if (!ReplicatedGameState)
+	{
+		return;
+	}
+
+	const ACardBattlePlayerState* PlayerState = BoundPlayerState.Get();
+	for (int32 PlayerId = 0; PlayerId < 2; ++PlayerId)
+	{
+		TArray<FCard>& Hand = ReplicatedHands[PlayerId];
+		if (PlayerState && PlayerId == LocalSeatId)
+		{
+			const FCardHand OwnHand = PlayerState->GetHand();
+			Hand.SetNumUninitialized(OwnHand.Num());
+			OwnHand.CopyTo(Hand.GetData());
+		}
+		else
+		{
+			// 對手的手牌內容不會複製，只顯示張數
+			Hand.Reset();
+			Hand.AddDefaulted(ReplicatedGameState->GetHandCount(PlayerId));
+		}
+
+		ReplicatedGameState->GetPlayedCards(PlayerId, ReplicatedPlayedCards[PlayerId]);
+	}
+}
+
+int32 UCardGameHUD::GetDisplayedScore(int32 PlayerId) const
+{
+	return BattleGameMode ? BattleGameMode->GetPlayerScore(PlayerId) : (ReplicatedGameState ? ReplicatedGameState->GetScore(PlayerId) : 0);
+}
+
+int32 UCardGameHUD::GetDisplayedTurnPlayerId() const
+{
+	return BattleGameMode ? BattleGameMode->GetCurrentTurnPlayerId() : (ReplicatedGameState ? ReplicatedGameState->GetCurrentTurnPlayerId() : 0);
+}
+
+EBattleState UCardGameHUD::GetDisplayedBattleState() const
+{
+	return BattleGameMode ? BattleGameMode->GetBattleState() : (ReplicatedGameState ? ReplicatedGameState->GetBattleState() : EBattleState::Idle);
+}
+
+int32 UCardGameHUD::GetDisplayedWinner() const
+{
+	if (BattleGameMode)
+	{
+		return BattleGameMode->GetWinner();
+	}
+
+	// 與 FBattleSimCore::DetermineWinner 相同，由最終分數決定
+	const int32 Score0 = GetDisplayedScore(0);
+	const int32 Score1 = GetDisplayedScore(1);
+	return Score0 > Score1 ? 0 : (Score1 > Score0 ? 1 : -1);
+}
+
+FRoundInfo UCardGameHUD::GetDisplayedLastRound() const
+{
+	if (BattleGameMode)
+	{
+		return BattleGameMode->GetLastRoundInfo();
+	}
+
+	// 雙方都出過第 N 張牌時第 N 回合就結束了 (回合不判定勝負)
+	FRoundInfo LastRound;
+	const int32 NumRounds = FMath::Min(ReplicatedPlayedCards[0].Num(), ReplicatedPlayedCards[1].Num());
+	if (NumRounds > 0)
+	{
+		LastRound.Player0Card = ReplicatedPlayedCards[0][NumRounds - 1];
+		LastRound.Player1Card = ReplicatedPlayedCards[1][NumRounds - 1];
+		LastRound.WinnerID = -1;
+	}
+	return LastRound;
+}
+
+float UCardGameHUD::GetDisplayedRemainingTime() const
+{
+	return BattleGameMode ? BattleGameMode->GetRemainingTurnTime() : (ReplicatedGameState ? ReplicatedGameState->GetRemainingTurnTime() : 0.0f);
+}
+
+float UCardGameHUD::GetDisplayedTurnTimeLimit() const
+{
+	if (BattleGameMode)
+	{
+		return BattleGameMode->GetTurnTimeLimit();
+	}
+
+	// 客戶端沒有 GameMode 實例，使用複製的 GameMode 類別預設值
+	const ACardBattle* DefaultBattle = ReplicatedGameState ? ReplicatedGameState->GetDefaultGameMode<ACardBattle>() : nullptr;
+	return DefaultBattle ? DefaultBattle->GetTurnTimeLimit() : 0.0f;
+}
+
+void UCardGameHUD::HandleScoreChanged(int32 PlayerId, int32 NewScore)
+{
+	UpdateScoreText(PlayerId);
+}
+
+void UCardGameHUD::HandleHandChanged(int32 PlayerId)
+{
+	UHorizontalBox* HandBox = PlayerId == 0 ? Player0HandBox.Get() : Player1HandBox.Get();
+	if (HandBox)
+	{
+		UpdatePlayerHand(PlayerId, HandBox);
+	}
+}
+
+void UCardGameHUD::HandleCardPlayed(int32 PlayerId, FCard PlayedCard)
+{
+	UHorizontalBox* BoardBox = PlayerId == 0 ? Player0CardBoard.Get() : Player1CardBoard.Get();
+	if (!BoardBox || !HasBattleSource())
+	{
+		return;
+	}
+
+	// 一般情況檯面剛好少這一張，只加入一個 Widget；否則重新同步
+	if (BoardBox->GetChildrenCount() + 1 == GetDisplayedPlayedCards(PlayerId).Num())
+	{
+		AppendPlayedCard(PlayerId, BoardBox, PlayedCard);
+	}
+	else
+	{
+		UpdatePlayedCards(PlayerId, BoardBox);
+	}
+}
+
+void UCardGameHUD::HandleBattleStateChanged(EBattleState NewState)
+{
+	UpdateBattleStateDisplay();
+
+	// 重新開始或結束遊戲時歷史被清空，檯面需要同步移除
+	if (HasBattleSource())
+	{
+		if (Player0CardBoard && Player0CardBoard->GetChildrenCount() > GetDisplayedPlayedCards(0).Num())
+		{
+			UpdatePlayedCards(0, Player0CardBoard);
+		}
+
+		if (Player1CardBoard && Player1CardBoard->GetChildrenCount() > GetDisplayedPlayedCards(1).Num())
+		{
+			UpdatePlayedCards(1, Player1CardBoard);
+		}
+	}
+}
+
+void UCardGameHUD::HandleTurnTimerTick(float RemainingTime)
+{
+	UpdateTimerDisplay(RemainingTime);
+}
+
+void UCardGameHUD::BindCardCatalog()
+{
+	if (CardCatalog)
+	{
+		return;
+	}
+
+	CardCatalog = UCardCatalogSubsystem::Get(this);
+	if (!CardCatalog)
+	{
+		UE_LOG(LogTemp, Error, TEXT("HUD: UCardCatalogSubsystem is not available!"));
+		return;
+	}
+
+	// GameMode 沒有指定資料來源時，使用 WBP_GameHUD 上設定的 DataTable
+	if (CardDataTable && !CardCatalog->GetSourceTable())
+	{
+		CardCatalog->SetSourceTable(CardDataTable);
+	}
+
+	CatalogChangedHandle = CardCatalog->OnCatalogChanged().AddUObject(this, &UCardGameHUD::OnCardCatalogChanged);
+}
+
+TConstArrayView<FCard> UCardGameHUD::GetDisplayedHand(int32 PlayerId) const
+{
+	if (DisplayOverride)
+	{
+		return DisplayOverride->Hands[PlayerId];
+	}
+
+	if (ReplicatedGameState && !BattleGameMode)
+	{
+		return ReplicatedHands[PlayerId];
+	}
+
+	return BattleGameMode ? BattleGameMode->GetPlayerHandView(PlayerId) : TConstArrayView<FCard>();
+}
+
+TConstArrayView<FCard> UCardGameHUD::GetDisplayedPlayedCards(int32 PlayerId) const
+{
+	if (DisplayOverride)
+	{
+		return DisplayOverride->PlayedCards[PlayerId];
+	}
+
+	if (ReplicatedGameState && !BattleGameMode)
+	{
+		return ReplicatedPlayedCards[PlayerId];
+	}
+
+	return BattleGameMode ? BattleGameMode->GetPlayedCardsView(PlayerId) : TConstArrayView<FCard>();
+}
+
+int32 UCardGameHUD::GetNumCardWidgets() const
+{
+	int32 NumWidgets = 0;
+	for (const UHorizontalBox* Box : { Player0HandBox.Get(), Player1HandBox.Get(), Player0CardBoard.Get(), Player1CardBoard.Get() })
+	{
+		NumWidgets += Box ? Box->GetChildrenCount() : 0;
+	}
+	return NumWidgets;
+}
+
+const FCardData* UCardGameHUD::FindCardData(int32 CardValue) const
+{
+	return CardCatalog ? CardCatalog->FindCard(CardValue) : nullptr;
+}
+
+void UCardGameHUD::OnCardCatalogChanged()
+{
+	// Catalog 原地重建，指標不變，所以要強制所有卡牌重新套用資料
+	for (UHorizontalBox* Box : { Player0HandBox.Get(), Player1HandBox.Get(), Player0CardBoard.Get(), Player1CardBoard.Get() })
+	{
+		if (!Box)
+		{
+			continue;
+		}
+
+		for (UWidget* Child : Box->GetAllChildren())
+		{
+			if (UCardWidget* CardWidget = Cast<UCardWidget>(Child))
+			{
+				CardWidget->SetCardData(CardWidget->GetCardData(), true);
+			}
+		}
+	}
+}
+
 void UCardGameHUD::UpdateUI()
 {
-	if (!BattleGameMode)
+	CARDGAME_SCOPE_CYCLE_COUNTER(UpdateUI);
+
+	if (!HasBattleSource())
 	{
 		return;
 	}
 
-	// 更新分數
-	if (Player0ScoreText)
+	// 客戶端先從複製的狀態組成手牌與檯面
+	if (!BattleGameMode)
+	{
+		RefreshReplicatedCards();
+	}
+
+	// 完整刷新 (初始化或重新開始時使用；平常由 ACardBattle 的事件局部更新)
+	UpdateScoreText(0);
+	UpdateScoreText(1);
+	UpdateTimerDisplay(GetDisplayedRemainingTime());
+	UpdateBattleStateDisplay();
+
+	// 更新手牌顯示
+	if (Player0HandBox)
 	{
-		Player0ScoreText->SetText(FText::FromString(FString::Printf(TEXT("Player 0: %d"), BattleGameMode->GetPlayerScore(0))));
+		UpdatePlayerHand(0, Player0HandBox);
 	}
 
-	if (Player1ScoreText)
+	if (Player1HandBox)
 	{
-		Player1ScoreText->SetText(FText::FromString(FString::Printf(TEXT("Player 1: %d"), BattleGameMode->GetPlayerScore(1))));
+		UpdatePlayerHand(1, Player1HandBox);
 	}
 
-	// 更新當前回合
-	if (CurrentTurnText)
+	// 更新檯面的牌
+	if (Player0CardBoard)
 	{
-		int32 CurrentPlayer = BattleGameMode->GetCurrentTurnPlayerId();
-		CurrentTurnText->SetText(FText::FromString(FString::Printf(TEXT("Current Turn: Player %d"), CurrentPlayer)));
+		UpdatePlayedCards(0, Player0CardBoard);
 	}
+	
+	if (Player1CardBoard)
+	{
+		UpdatePlayedCards(1, Player1CardBoard);
+	}
+}
+
+void UCardGameHUD::UpdateScoreText(int32 PlayerId)
+{
+	UTextBlock* ScoreText = PlayerId == 0 ? Player0ScoreText.Get() : Player1ScoreText.Get();
+	if (ScoreText && HasBattleSource())
+	{
+		ScoreText->SetText(FText::FromString(FString::Printf(TEXT("Player %d: %d"), PlayerId, GetDisplayedScore(PlayerId))));
+	}
+}
+
+void UCardGameHUD::UpdateTimerDisplay(float RemainingTime)
+{
+	// 只有顯示的數值 (0.1 秒) 改變時才更新文字
+	const int32 DisplayedTenths = FMath::CeilToInt(RemainingTime * 10.0f);
+	if (DisplayedTenths == LastDisplayedTimerTenths)
+	{
+		return;
+	}
+	LastDisplayedTimerTenths = DisplayedTenths;
 
-	// 更新計時器
-	float RemainingTime = BattleGameMode->GetRemainingTurnTime();
 	if (TimerText)
 	{
-		TimerText->SetText(FText::FromString(FString::Printf(TEXT("Time: %.1f"), RemainingTime)));
+		TimerText->SetText(FText::FromString(FString::Printf(TEXT("Time: %.1f"), DisplayedTenths * 0.1f)));
+	}
+
+	if (TimerProgressBar && HasBattleSource())
+	{
+		const float TimeLimit = GetDisplayedTurnTimeLimit();
+		TimerProgressBar->SetPercent(TimeLimit > 0.0f ? RemainingTime / TimeLimit : 0.0f);
+	}
+}
+
+void UCardGameHUD::UpdateBattleStateDisplay()
+{
+	if (!HasBattleSource())
+	{
+		return;
 	}
 
-	if (TimerProgressBar)
+	// 更新當前回合
+	if (CurrentTurnText)
 	{
-		// 假設 30 秒為滿
-		TimerProgressBar->SetPercent(RemainingTime / 30.0f);
+		int32 CurrentPlayer = GetDisplayedTurnPlayerId();
+		CurrentTurnText->SetText(FText::FromString(FString::Printf(TEXT("Current Turn: Player %d"), CurrentPlayer)));
 	}
 
 	// 更新遊戲狀態
 	if (GameStateText)
 	{
-		EBattleState State = BattleGameMode->GetBattleState();
+		EBattleState State = GetDisplayedBattleState();
 		GameStateText->SetText(FText::FromString(GetBattleStateString(State)));
 	}
 
 	// 更新上回合結果
 	if (LastRoundResultText)
 	{
-		const FRoundInfo& LastRound = BattleGameMode->GetLastRoundInfo();
+		const FRoundInfo LastRound = GetDisplayedLastRound();
 		if (LastRound.Player0Card.IsValid() && LastRound.Player1Card.IsValid())
 		{
 			FString ResultStr;
@@ -162,9 +649,9 @@ void UCardGameHUD::UpdateUI()
 	// 更新獲勝者顯示
 	if (WinnerText)
 	{
-		if (BattleGameMode->GetBattleState() == EBattleState::GameOver)
+		if (GetDisplayedBattleState() == EBattleState::GameOver)
 		{
-			int32 Winner = BattleGameMode->GetWinner();
+			int32 Winner = GetDisplayedWinner();
 			if (Winner == 0)
 			{
 				WinnerText->SetText(FText::FromString(TEXT("🎉 PLAYER 0 WINS! 🎉")));
@@ -184,33 +671,11 @@ void UCardGameHUD::UpdateUI()
 			WinnerText->SetVisibility(ESlateVisibility::Collapsed);
 		}
 	}
-
-	// 更新手牌顯示（簡化版：顯示手牌數量）
-	if (Player0HandBox)
-	{
-		UpdatePlayerHand(0, Player0HandBox);
-	}
-
-	if (Player1HandBox)
-	{
-		UpdatePlayerHand(1, Player1HandBox);
-	}
-
-	// 更新檯面的牌
-	if (Player0CardBoard)
-	{
-		UpdatePlayedCards(0, Player0CardBoard);
-	}
-	
-	if (Player1CardBoard)
-	{
-		UpdatePlayedCards(1, Player1CardBoard);
-	}
 }
 
 bool UCardGameHUD::NativeOnDrop(const FGeometry& InGeometry, const FDragDropEvent& InDragDropEvent, UDragDropOperation* InOperation)
 {
-	if (!BattleGameMode || !InOperation)
+	if (!HasBattleSource() || !InOperation)
 	{
 		return Super::NativeOnDrop(InGeometry, InDragDropEvent, InOperation);
 	}
@@ -221,12 +686,7 @@ bool UCardGameHUD::NativeOnDrop(const FGeometry& InGeometry, const FDragDropEven
 		return Super::NativeOnDrop(InGeometry, InDragDropEvent, InOperation);
 	}
 
-	const FVector2D DropPos = InDragDropEvent.GetScreenSpacePosition();
-	const bool bDroppedOnPlayer0Board = Player0CardBoardBorder
-		? Player0CardBoardBorder->GetCachedGeometry().IsUnderLocation(DropPos)
-		: (Player0CardBoard && Player0CardBoard->GetCachedGeometry().IsUnderLocation(DropPos));
-
-	if (!bDroppedOnPlayer0Board)
+	if (!IsOverLocalBoard(InDragDropEvent.GetScreenSpacePosition()))
 	{
 		return Super::NativeOnDrop(InGeometry, InDragDropEvent, InOperation);
 	}
@@ -248,12 +708,7 @@ bool UCardGameHUD::NativeOnDragOver(const FGeometry& InGeometry, const FDragDrop
 		return Super::NativeOnDragOver(InGeometry, InDragDropEvent, InOperation);
 	}
 
-	const FVector2D DragPos = InDragDropEvent.GetScreenSpacePosition();
-	const bool bOverPlayer0Board = Player0CardBoardBorder
-		? Player0CardBoardBorder->GetCachedGeometry().IsUnderLocation(DragPos)
-		: (Player0CardBoard && Player0CardBoard->GetCachedGeometry().IsUnderLocation(DragPos));
-
-	if (bOverPlayer0Board)
+	if (IsOverLocalBoard(InDragDropEvent.GetScreenSpacePosition()))
 	{
 		return true;
 	}
@@ -261,402 +716,445 @@ bool UCardGameHUD::NativeOnDragOver(const FGeometry& InGeometry, const FDragDrop
 	return Super::NativeOnDragOver(InGeometry, InDragDropEvent, InOperation);
 }
 
+bool UCardGameHUD::IsOverLocalBoard(const FVector2D& ScreenPosition) const
+{
+	const UBorder* BoardBorder = LocalSeatId == 0 ? Player0CardBoardBorder.Get() : Player1CardBoardBorder.Get();
+	const UHorizontalBox* BoardBox = LocalSeatId == 0 ? Player0CardBoard.Get() : Player1CardBoard.Get();
+	return BoardBorder
+		? BoardBorder->GetCachedGeometry().IsUnderLocation(ScreenPosition)
+		: (BoardBox && BoardBox->GetCachedGeometry().IsUnderLocation(ScreenPosition));
+}
+
 void UCardGameHUD::OnCardClicked(int32 CardIndex)
 {
 	if (BattleGameMode)
 	{
-		// 假設玩家 0 是人類玩家
-		BattleGameMode->PlayerPlayCard(0, CardIndex);
+		// 本機對戰：玩家 0 是人類玩家
+		BattleGameMode->PlayerPlayCard(LocalSeatId, CardIndex);
+		return;
+	}
+
+	// 客戶端：送出牌值給伺服器 (索引在伺服器端可能已經不同)
+	const TConstArrayView<FCard> Hand = GetDisplayedHand(LocalSeatId);
+	ACardBattlePlayerState* PlayerState = BoundPlayerState.Get();
+	if (PlayerState && Hand.IsValidIndex(CardIndex))
+	{
+		PlayerState->ServerPlayCard(Hand[CardIndex].CardValue);
 	}
 }
 
 void UCardGameHUD::UpdatePlayerHand(int32 PlayerId, UHorizontalBox* HandBox)
 {
-	if (!HandBox || !BattleGameMode)
+	CARDGAME_SCOPE_CYCLE_COUNTER(UpdatePlayerHand);
+
+	if (!HandBox || !HasBattleSource())
 	{
 		return;
 	}
 
 	// 獲取玩家手牌
-	const TArray<FCard>& Hand = BattleGameMode->GetPlayerHand(PlayerId);
+	const TConstArrayView<FCard> Hand = GetDisplayedHand(PlayerId);
 
-	// 動態計算間距與旋轉參數
-	const float MaxHandWidth = 900.0f; // 手牌最大寬度限制 (可依據螢幕解析度調整)
-	const float CardWidth = 150.0f;    // 假設卡牌顯示寬度
-	const float BasePadding = -25.0f;  // 預設負邊距 (重疊量)
+	// 自己的手牌圖片優先載入，對手的最後
+	const ECardArtPriority ArtPriority = PlayerId == LocalSeatId ? ECardArtPriority::PlayerHand : ECardArtPriority::OpponentHand;
 
-	float CurrentPadding = BasePadding;
+	// 扇形排版 (依手牌數與畫面寬度快取)
+	const FHandFanLayout& FanLayout = GetHandFanLayout(Hand.Num());
 
-	// 如果卡牌數量多，計算需要的壓縮邊距
-	// 總寬度 ~= Num * (CardWidth + 2 * Padding)
-	if (Hand.Num() > 0)
+	// 手牌數或畫面寬度改變時才需要重新套用所有牌的間距與角度
+	const bool bFanLayoutChanged = AppliedFanLayoutNum[PlayerId] != Hand.Num() || AppliedFanLayoutWidth[PlayerId] != FanLayoutViewportWidth;
+	AppliedFanLayoutNum[PlayerId] = Hand.Num();
+	AppliedFanLayoutWidth[PlayerId] = FanLayoutViewportWidth;
+
+	// 以 CardValue 為 key 對應現有的 Widget (同一玩家手牌中的 CardValue 不會重複)
+	UCardWidget* WidgetByValue[MaxKeyedCardValue] = {};
+	bool bInNewHand[MaxKeyedCardValue] = {};
+
+	for (const FCard& Card : Hand)
 	{
-		float CurrentTotalWidth = (float)Hand.Num() * (CardWidth + 2.0f * BasePadding);
-		if (CurrentTotalWidth > MaxHandWidth)
+		if (Card.CardValue > 0 && Card.CardValue < MaxKeyedCardValue)
 		{
-			// 計算新的 Padding 以符合最大寬度
-			// Padding = ((MaxWidth / Num) - CardWidth) / 2
-			CurrentPadding = ((MaxHandWidth / (float)Hand.Num()) - CardWidth) * 0.5f;
+			bInNewHand[Card.CardValue] = true;
+		}
+	}
+
+	// 移除已不在手牌中的 Widget (例如剛打出的牌)，其餘保留
+	TArray<UCardWidget*, TInlineAllocator<FBattleSimCore::HandSize>> Survivors;
+	TArray<UWidget*, TInlineAllocator<FBattleSimCore::HandSize>> RemovedWidgets;
+	for (UWidget* ChildWidget : HandBox->GetAllChildren())
+	{
+		UCardWidget* CardWidget = Cast<UCardWidget>(ChildWidget);
+		const int32 CardValue = CardWidget ? CardWidget->CardValue : 0;
+		if (CardWidget && CardValue > 0 && CardValue < MaxKeyedCardValue
+			&& bInNewHand[CardValue] && !WidgetByValue[CardValue])
+		{
+			WidgetByValue[CardValue] = CardWidget;
+			Survivors.Add(CardWidget);
+		}
+		else
+		{
+			RemovedWidgets.Add(ChildWidget);
+		}
+	}
+
+	const bool bStructureChanged = RemovedWidgets.Num() > 0 || Survivors.Num() != Hand.Num();
+	if (bStructureChanged)
+	{
+		// 記錄留下的牌目前的位置，排版後再由該位置滑到新位置
+		for (UCardWidget* CardWidget : Survivors)
+		{
+			CardWidget->BeginLayoutTransition();
+		}
+	}
+
+	for (UWidget* ChildWidget : RemovedWidgets)
+	{
+		// 卡牌 Widget 歸還到物件池，其他元件直接移除
+		if (UCardWidget* CardWidget = Cast<UCardWidget>(ChildWidget))
+		{
+			GetCardWidgetPool()->Release(CardWidget);
+		}
+		else
+		{
+			HandBox->RemoveChild(ChildWidget);
 		}
 	}
 
-	// 根據數量調整旋轉角度步長，避免扇形太寬
-	float AngleStep = 5.0f;
-	if (Hand.Num() > 8)
+	// 留下的牌順序與新手牌一致時只需在尾端加入新牌；否則以既有 Widget 重新排列
+	bool bOrderMatches = true;
+	for (int32 i = 0, SurvivorIndex = 0; i < Hand.Num() && SurvivorIndex < Survivors.Num(); ++i)
 	{
-		// 限制最大展開角度範圍
-		AngleStep = 40.0f / ((float)Hand.Num() * 0.5f);
+		const int32 CardValue = Hand[i].CardValue;
+		if (CardValue > 0 && CardValue < MaxKeyedCardValue && WidgetByValue[CardValue])
+		{
+			if (Survivors[SurvivorIndex++] != WidgetByValue[CardValue])
+			{
+				bOrderMatches = false;
+				break;
+			}
+		}
+		else if (SurvivorIndex < Survivors.Num())
+		{
+			// 新牌插在舊牌之間
+			bOrderMatches = false;
+			break;
+		}
 	}
 
-	// 檢查是否需要重建 (數量不同時才重建)
-	// 注意：這裡簡單用數量判斷。如果遊戲中有交換手牌等機制，可能需要更嚴謹的檢查 (例如檢查 CardID)
-	if (HandBox->GetChildrenCount() == Hand.Num())
+	if (!bOrderMatches)
 	{
-		// 數量相同，嘗試更新現有 Widget
-		bool bUpdateSuccess = true;
-		for (int32 i = 0; i < Hand.Num(); ++i)
+		HandBox->ClearChildren();
+	}
+
+	for (int32 i = 0; i < Hand.Num(); ++i)
+	{
+		const int32 CardValue = Hand[i].CardValue;
+		const bool bKeyed = CardValue > 0 && CardValue < MaxKeyedCardValue;
+
+		UCardWidget* CardWidget = bKeyed ? WidgetByValue[CardValue] : nullptr;
+		const bool bNeedsAdd = !CardWidget || !bOrderMatches;
+
+		// 只有新出現的牌才從物件池取得 Widget
+		if (!CardWidget)
 		{
-			UWidget* ChildWidget = HandBox->GetChildAt(i);
-			
-			// 所有玩家都使用 CardWidget
-			if (UCardWidget* CardWidget = Cast<UCardWidget>(ChildWidget))
+			CardWidget = AcquireCardWidget();
+			if (!CardWidget)
 			{
-				// 獲取資料並更新
-				FCardData DisplayData;
-				bool bDataFound = false;
-				if (CardDataTable)
-				{
-					FName RowName = FName(*FString::FromInt(Hand[i].CardValue));
-					static const FString ContextString(TEXT("CardWidgetContext"));
-					FCardData* CardData = CardDataTable->FindRow<FCardData>(RowName, ContextString);
-					if (CardData)
-					{
-						DisplayData = *CardData;
-						bDataFound = true;
-					}
-				}
-				
-				if (!bDataFound)
-				{
-					DisplayData.Name = FString::Printf(TEXT("Card %d"), Hand[i].CardValue);
-					DisplayData.Power = Hand[i].CardValue;
-					DisplayData.Description = TEXT("No Data");
-				}
-				
-				CardWidget->UpdateCardDisplay(DisplayData);
-				
-				// 確保索引正確 (因為手牌可能會變動)
-				CardWidget->CardIndex = i;
-				
-				// 只有玩家 0 (自己) 才綁定點擊事件
-				if (PlayerId == 0)
-				{
-					CardWidget->SetOnClicked(FOnCardClicked::CreateUObject(this, &UCardGameHUD::OnCardClicked));
-					CardWidget->SetDraggable(true);
-				}
-				else
-				{
-					// 清除綁定，避免誤觸
-					CardWidget->SetOnClicked(FOnCardClicked()); 
-					CardWidget->SetDraggable(false);
-				}
-
-				// 手牌不啟用發光效果
-				CardWidget->SetGlowEffectEnabled(false);
-
-				// 更新佈局參數 (動態調整 Padding)
-				if (UHorizontalBoxSlot* HSlot = Cast<UHorizontalBoxSlot>(CardWidget->Slot))
-				{
-					HSlot->SetPadding(FMargin(CurrentPadding, 0.0f, CurrentPadding, 0.0f));
-				}
-
-				// 更新扇形效果
-				float CenterIndex = (Hand.Num() - 1) / 2.0f;
-				float DistanceFromCenter = i - CenterIndex;
-				float RotationAngle = DistanceFromCenter * AngleStep; 
-
-				CardWidget->SetRenderTransformPivot(FVector2D(0.5f, 2.0f));
-				CardWidget->SetRenderTransformAngle(RotationAngle);
+				continue;
 			}
-			else
+
+			// 縮小卡牌以防止超出螢幕
+			CardWidget->SetRenderScale(FVector2D(1.0f, 1.0f));
+
+			if (bKeyed)
 			{
-				// 類型不對，強制重建
-				bUpdateSuccess = false;
-				break;
+				WidgetByValue[CardValue] = CardWidget;
 			}
 		}
 
-		if (bUpdateSuccess)
+		// 直接使用 Catalog 的資料 (不複製，資料相同時不會重設)
+		CardWidget->CardValue = CardValue;
+		CardWidget->SetArtLoadPriority(ArtPriority);
+		CardWidget->SetCardData(FindCardData(CardValue));
+
+		// 新加入、位置改變或排版改變的牌才需要設定間距與角度
+		const bool bNeedsLayout = bNeedsAdd || bFanLayoutChanged || CardWidget->CardIndex != i;
+
+		// 確保索引正確 (因為手牌可能會變動)
+		CardWidget->CardIndex = i;
+
+		// 只有自己的座位才綁定點擊事件
+		if (PlayerId == LocalSeatId)
 		{
-			return; // 更新成功，不需要重建
+			CardWidget->SetOnClicked(FOnCardClicked::CreateUObject(this, &UCardGameHUD::OnCardClicked));
+			CardWidget->SetDraggable(true);
+		}
+		else
+		{
+			// 清除綁定，避免誤觸
+			CardWidget->SetOnClicked(FOnCardClicked());
+			CardWidget->SetDraggable(false);
+		}
+
+		// 手牌不啟用發光效果
+		CardWidget->SetGlowEffectEnabled(false);
+
+		if (bNeedsAdd)
+		{
+			if (UHorizontalBoxSlot* HandSlot = Cast<UHorizontalBoxSlot>(HandBox->AddChild(CardWidget)))
+			{
+				// 設置為自動大小，讓卡片保持自己的寬度
+				HandSlot->SetSize(FSlateChildSize(ESlateSizeRule::Automatic));
+				// 垂直對齊改為底部對齊，避免被拉伸到整個容器高度 (500)
+				HandSlot->SetVerticalAlignment(VAlign_Bottom);
+			}
+
+			// 設定旋轉軸心在卡片下方，產生扇形效果
+			// 0.5 = X軸中心, 2.0 = Y軸 (卡片高度的 2 倍處，即卡片底部再往下一個卡片高度)
+			CardWidget->SetRenderTransformPivot(FVector2D(0.5f, 2.0f));
+		}
+
+		if (bNeedsLayout)
+		{
+			if (UHorizontalBoxSlot* HandSlot = Cast<UHorizontalBoxSlot>(CardWidget->Slot))
+			{
+				// 設置動態邊距
+				HandSlot->SetPadding(FMargin(FanLayout.Padding, 0.0f, FanLayout.Padding, 0.0f));
+			}
+
+			CardWidget->SetRenderTransformAngle(FanLayout.Angles[i]);
 		}
 	}
+}
 
-	// 清空現有內容 (只有在數量不對或類型不對時才執行)
-	HandBox->ClearChildren();
+const UCardGameHUD::FHandFanLayout& UCardGameHUD::GetHandFanLayout(int32 NumCards)
+{
+	if (HandFanLayouts.Num() <= NumCards)
+	{
+		RebuildHandFanLayouts(FMath::Max(NumCards, FBattleSimCore::HandSize));
+	}
 
-	// 為每張牌創建 Widget
-	for (int32 i = 0; i < Hand.Num(); ++i)
+	return HandFanLayouts[NumCards];
+}
+
+void UCardGameHUD::RebuildHandFanLayouts(int32 MaxCards)
+{
+	// 手牌最大寬度限制 (畫面較窄時依畫面寬度縮小；尚未排版時使用預設值)
+	const float DefaultMaxHandWidth = 900.0f;
+	const float MaxHandWidth = FanLayoutViewportWidth > 0.0f
+		? FMath::Min(DefaultMaxHandWidth, FanLayoutViewportWidth * 0.7f)
+		: DefaultMaxHandWidth;
+	const float CardWidth = 150.0f;    // 假設卡牌顯示寬度
+	const float BasePadding = -25.0f;  // 預設負邊距 (重疊量)
+
+	HandFanLayouts.SetNum(MaxCards + 1);
+	for (int32 NumCards = 0; NumCards <= MaxCards; ++NumCards)
 	{
-		// 所有玩家都顯示完整卡牌
-		if (CardWidgetClass)
+		FHandFanLayout& Layout = HandFanLayouts[NumCards];
+
+		// 如果卡牌數量多，計算需要的壓縮邊距
+		// 總寬度 ~= Num * (CardWidth + 2 * Padding)
+		Layout.Padding = BasePadding;
+		if (NumCards > 0)
 		{
-			UCardWidget* NewCard = CreateWidget<UCardWidget>(this, CardWidgetClass);
-			if (NewCard)
+			float CurrentTotalWidth = (float)NumCards * (CardWidth + 2.0f * BasePadding);
+			if (CurrentTotalWidth > MaxHandWidth)
 			{
-				FCardData DisplayData;
-				bool bDataFound = false;
-
-				// 嘗試從 DataTable 獲取資料
-				if (CardDataTable)
-				{
-					// 假設 RowName 就是 CardValue 的字串形式 (例如 "1", "2")
-					FName RowName = FName(*FString::FromInt(Hand[i].CardValue));
-					static const FString ContextString(TEXT("CardWidgetContext"));
-					FCardData* CardData = CardDataTable->FindRow<FCardData>(RowName, ContextString);
-
-					if (CardData)
-					{
-						DisplayData = *CardData;
-						bDataFound = true;
-					}
-					else
-					{
-						// UE_LOG(LogTemp, Warning, TEXT("HUD: Row '%s' not found in DataTable!"), *RowName.ToString());
-					}
-				}
-				else
-				{
-					static bool bWarnedDT = false;
-					if (!bWarnedDT)
-					{
-						UE_LOG(LogTemp, Error, TEXT("HUD: CardDataTable is NOT set in WBP_GameHUD!"));
-						bWarnedDT = true;
-					}
-				}
-
-				// 如果找不到資料，使用預設值
-				if (!bDataFound)
-				{
-					DisplayData.Name = FString::Printf(TEXT("Card %d"), Hand[i].CardValue);
-					DisplayData.Power = Hand[i].CardValue;
-					DisplayData.Description = TEXT("No Data");
-				}
-
-				NewCard->UpdateCardDisplay(DisplayData);
-				
-				// 設定索引和點擊回調
-				NewCard->CardIndex = i;
-				
-				// 只有玩家 0 綁定點擊
-				if (PlayerId == 0)
-				{
-					NewCard->SetOnClicked(FOnCardClicked::CreateUObject(this, &UCardGameHUD::OnCardClicked));
-					NewCard->SetDraggable(true);
-				}
-				else
-				{
-					NewCard->SetDraggable(false);
-				}
-
-				// 手牌不啟用發光效果
-				NewCard->SetGlowEffectEnabled(false);
-
-				// 扇形效果計算
-				float CenterIndex = (Hand.Num() - 1) / 2.0f;
-				float DistanceFromCenter = i - CenterIndex;
-				float RotationAngle = DistanceFromCenter * AngleStep; // 使用動態計算的 AngleStep
-
-				// 設定旋轉軸心在卡片下方，產生扇形效果
-				// 0.5 = X軸中心, 2.0 = Y軸 (卡片高度的 2 倍處，即卡片底部再往下一個卡片高度)
-				NewCard->SetRenderTransformPivot(FVector2D(0.5f, 2.0f));
-				NewCard->SetRenderTransformAngle(RotationAngle);
-
-				// 縮小卡牌以防止超出螢幕
-				NewCard->SetRenderScale(FVector2D(1.0f, 1.0f));
-
-				UHorizontalBoxSlot* HandSlot = Cast<UHorizontalBoxSlot>(HandBox->AddChild(NewCard));
-				if (HandSlot)
-				{
-					// 設置動態邊距
-					HandSlot->SetPadding(FMargin(CurrentPadding, 0.0f, CurrentPadding, 0.0f));
-					// 設置為自動大小，讓卡片保持自己的寬度
-					HandSlot->SetSize(FSlateChildSize(ESlateSizeRule::Automatic));
-					// 垂直對齊改為底部對齊，避免被拉伸到整個容器高度 (500)
-					HandSlot->SetVerticalAlignment(VAlign_Bottom);
-				}
+				// 計算新的 Padding 以符合最大寬度
+				// Padding = ((MaxWidth / Num) - CardWidth) / 2
+				Layout.Padding = ((MaxHandWidth / (float)NumCards) - CardWidth) * 0.5f;
 			}
 		}
+
+		// 根據數量調整旋轉角度步長，避免扇形太寬
+		float AngleStep = 5.0f;
+		if (NumCards > 8)
+		{
+			// 限制最大展開角度範圍
+			AngleStep = 40.0f / ((float)NumCards * 0.5f);
+		}
+
+		// 扇形效果計算
+		const float CenterIndex = (NumCards - 1) / 2.0f;
+		Layout.Angles.SetNum(NumCards);
+		for (int32 i = 0; i < NumCards; ++i)
+		{
+			Layout.Angles[i] = (i - CenterIndex) * AngleStep;
+		}
+	}
+}
+
+void UCardGameHUD::UpdateFanLayoutViewport(float ViewportWidth)
+{
+	if (ViewportWidth <= 0.0f || ViewportWidth == FanLayoutViewportWidth)
+	{
+		return;
+	}
+
+	// 解析度改變：重建快取並重新套用到手牌
+	FanLayoutViewportWidth = ViewportWidth;
+	HandFanLayouts.Reset();
+
+	if (Player0HandBox)
+	{
+		UpdatePlayerHand(0, Player0HandBox);
+	}
+
+	if (Player1HandBox)
+	{
+		UpdatePlayerHand(1, Player1HandBox);
 	}
 }
 
 void UCardGameHUD::UpdatePlayedCards(int32 PlayerId, UHorizontalBox* BoardBox)
 {
-	if (!BoardBox || !BattleGameMode)
+	CARDGAME_SCOPE_CYCLE_COUNTER(UpdatePlayedCards);
+
+	if (!BoardBox || !HasBattleSource())
 	{
 		return;
 	}
 
 	// 獲取玩家已出的牌
-	// 根據 PlayerId 選擇對應的函數
-	const TArray<FCard>& PlayedCards = (PlayerId == 0) ? 
-		BattleGameMode->GetPlayer0PlayedCards() : 
-		BattleGameMode->GetPlayer1PlayedCards();
+	const TConstArrayView<FCard> PlayedCards = GetDisplayedPlayedCards(PlayerId);
 
-	// 判斷 Hover 狀態：只看檯面區本身（不再用子卡牌 Hover 觸發）
-	UBorder* BoardBorder = (PlayerId == 0) ? Player0CardBoardBorder.Get() : Player1CardBoardBorder.Get();
-	const bool bBoardHovered = BoardBorder ? BoardBorder->IsHovered() : BoardBox->IsHovered();
+	// 歷史只會往後加，檯面上的牌應該是歷史的前綴
+	int32 NumMatching = 0;
+	while (NumMatching < BoardBox->GetChildrenCount() && NumMatching < PlayedCards.Num())
+	{
+		const UCardWidget* CardWidget = Cast<UCardWidget>(BoardBox->GetChildAt(NumMatching));
+		if (!CardWidget || CardWidget->CardValue != PlayedCards[NumMatching].CardValue)
+		{
+			break;
+		}
+		++NumMatching;
+	}
 
-	// 檯面本身的發光感：放大 + 提升透明度（亮度感）
-	BoardBox->SetRenderTransformPivot(FVector2D(0.5f, 0.5f));
-	BoardBox->SetRenderScale(FVector2D(1.0f, 1.0f));
-	BoardBox->SetRenderOpacity(bBoardHovered ? 1.0f : 0.9f);
+	// 不符合的部分 (例如重新開始後歷史被清空) 歸還到物件池
+	if (NumMatching < BoardBox->GetChildrenCount())
+	{
+		GetCardWidgetPool()->ReleaseChildren(BoardBox, NumMatching);
+		UpdateBoardPadding(PlayerId, BoardBox);
+	}
 
-	// 白框亮度：Hover 時更亮
-	if (BoardBorder)
+	// 補上缺少的牌
+	for (int32 i = BoardBox->GetChildrenCount(); i < PlayedCards.Num(); ++i)
 	{
-		BoardBorder->SetPadding(FMargin(2.0f));
-		BoardBorder->SetBrushColor(bBoardHovered
-			? FLinearColor(1.0f, 1.0f, 1.0f, 1.0f)
-			: FLinearColor(1.0f, 1.0f, 1.0f, 0.0f));
+		AppendPlayedCard(PlayerId, BoardBox, PlayedCards[i]);
+	}
+}
+
+void UCardGameHUD::AppendPlayedCard(int32 PlayerId, UHorizontalBox* BoardBox, FCard PlayedCard)
+{
+	UCardWidget* NewCard = AcquireCardWidget();
+	if (!NewCard)
+	{
+		return;
 	}
 
+	NewCard->CardValue = PlayedCard.CardValue;
+	NewCard->SetArtLoadPriority(ECardArtPriority::Board);
+	NewCard->SetCardData(FindCardData(PlayedCard.CardValue));
+
+	// 檯面上的牌不可點擊
+	NewCard->SetIsEnabled(true); // 保持啟用才能看到，但移除點擊回調
+	NewCard->SetOnClicked(FOnCardClicked());
+	NewCard->SetDraggable(false);
+
+	// 確保沒有旋轉或縮放
+	NewCard->SetRenderTransformAngle(0.0f);
+	NewCard->SetRenderScale(FVector2D(BoardCardScale, BoardCardScale)); // 稍微縮小一點以適應版面
+
+	// 新加入的牌，依當前 Hover 狀態決定是否發光
+	NewCard->SetGlowEffectEnabled(bBoardHoveredState[PlayerId]);
+
+	UHorizontalBoxSlot* CardSlot = Cast<UHorizontalBoxSlot>(BoardBox->AddChild(NewCard));
+	if (CardSlot)
+	{
+		CardSlot->SetPadding(FMargin(BoardPadding[PlayerId], 0.0f, BoardPadding[PlayerId], 0.0f));
+		CardSlot->SetSize(FSlateChildSize(ESlateSizeRule::Automatic));
+		CardSlot->SetVerticalAlignment(VAlign_Center);
+		CardSlot->SetHorizontalAlignment(HAlign_Center);
+	}
+
+	// 只有壓縮間距改變時才更新其他牌
+	UpdateBoardPadding(PlayerId, BoardBox);
+}
+
+void UCardGameHUD::UpdateBoardPadding(int32 PlayerId, UHorizontalBox* BoardBox)
+{
 	// 動態計算間距
 	const float MaxBoardWidth = 800.0f; // 檯面最大寬度
-	const float CardScale = 0.8f;
-	const float CardWidth = 150.0f * CardScale; 
+	const float CardWidth = 150.0f * BoardCardScale;
 	const float BasePadding = 5.0f;    // 預設間距 (正數表示分開)
 
-	float CurrentPadding = BasePadding;
+	const int32 NumCards = BoardBox->GetChildrenCount();
+	float NewPadding = BasePadding;
 
 	// 如果卡牌數量多，計算需要的壓縮邊距
-	if (PlayedCards.Num() > 0)
+	if (NumCards > 0)
 	{
-		float CurrentTotalWidth = (float)PlayedCards.Num() * (CardWidth + 2.0f * BasePadding);
+		float CurrentTotalWidth = (float)NumCards * (CardWidth + 2.0f * BasePadding);
 		if (CurrentTotalWidth > MaxBoardWidth)
 		{
 			// 計算新的 Padding 以符合最大寬度
 			// 這裡計算出的 Padding 可能是負數，這會讓卡牌重疊，這正是我們想要的
-			CurrentPadding = ((MaxBoardWidth / (float)PlayedCards.Num()) - CardWidth) * 0.5f;
+			NewPadding = ((MaxBoardWidth / (float)NumCards) - CardWidth) * 0.5f;
 		}
 	}
 
-	// 檢查是否需要重建 (數量不同時才重建)
-	if (BoardBox->GetChildrenCount() == PlayedCards.Num())
+	if (NewPadding == BoardPadding[PlayerId])
 	{
-		// 數量相同，嘗試更新現有 Widget 的資料與佈局
-		for (int32 i = 0; i < PlayedCards.Num(); ++i)
-		{
-			UWidget* ChildWidget = BoardBox->GetChildAt(i);
-			if (UCardWidget* CardWidget = Cast<UCardWidget>(ChildWidget))
-			{
-				// 更新資料 (以防資料顯示有變，雖然打出的牌通常不變)
-				FCardData DisplayData;
-				bool bDataFound = false;
-				if (CardDataTable)
-				{
-					FName RowName = FName(*FString::FromInt(PlayedCards[i].CardValue));
-					static const FString ContextString(TEXT("PlayedCardContext"));
-					FCardData* CardData = CardDataTable->FindRow<FCardData>(RowName, ContextString);
-					if (CardData)
-					{
-						DisplayData = *CardData;
-						bDataFound = true;
-					}
-				}
-
-				if (!bDataFound)
-				{
-					DisplayData.Name = FString::Printf(TEXT("Card %d"), PlayedCards[i].CardValue);
-					DisplayData.Power = PlayedCards[i].CardValue;
-					DisplayData.Description = TEXT("");
-				}
-				CardWidget->UpdateCardDisplay(DisplayData);
-
-				// 更新佈局參數 (動態調整 Padding)
-				if (UHorizontalBoxSlot* HSlot = Cast<UHorizontalBoxSlot>(CardWidget->Slot))
-				{
-					HSlot->SetPadding(FMargin(CurrentPadding, 0.0f, CurrentPadding, 0.0f));
-				}
-				
-				// 確保沒有旋轉或縮放
-				CardWidget->SetRenderTransformAngle(0.0f);
-				CardWidget->SetRenderScale(FVector2D(CardScale, CardScale));
-
-				// Hover 到 CardBoard 或卡牌本身時顯示發光
-				CardWidget->SetGlowEffectEnabled(bBoardHovered || CardWidget->IsHovered());
-			}
-			else
-			{
-				// 類型不對，需要重建 (理論上很少發生)
-				BoardBox->ClearChildren();
-				break;
-			}
-		}
+		return;
+	}
 
-		// 只有在完全匹配且更新成功的情況下才返回
-		if (BoardBox->GetChildrenCount() == PlayedCards.Num())
+	BoardPadding[PlayerId] = NewPadding;
+	for (int32 i = 0; i < NumCards; ++i)
+	{
+		if (UHorizontalBoxSlot* HSlot = Cast<UHorizontalBoxSlot>(BoardBox->GetChildAt(i)->Slot))
 		{
-			return;
+			HSlot->SetPadding(FMargin(NewPadding, 0.0f, NewPadding, 0.0f));
 		}
 	}
+}
+
+void UCardGameHUD::UpdateBoardHover(int32 PlayerId, UHorizontalBox* BoardBox, bool bForce)
+{
+	if (!BoardBox)
+	{
+		return;
+	}
+
+	// 判斷 Hover 狀態：只看檯面區本身（不再用子卡牌 Hover 觸發）
+	UBorder* BoardBorder = (PlayerId == 0) ? Player0CardBoardBorder.Get() : Player1CardBoardBorder.Get();
+	const bool bBoardHovered = BoardBorder ? BoardBorder->IsHovered() : BoardBox->IsHovered();
+
+	// 只在 Hover 狀態改變時更新外觀
+	if (!bForce && bBoardHovered == bBoardHoveredState[PlayerId])
+	{
+		return;
+	}
+	bBoardHoveredState[PlayerId] = bBoardHovered;
 
-	BoardBox->ClearChildren();
+	// 檯面本身的發光感：放大 + 提升透明度（亮度感）
+	BoardBox->SetRenderTransformPivot(FVector2D(0.5f, 0.5f));
+	BoardBox->SetRenderScale(FVector2D(1.0f, 1.0f));
+	BoardBox->SetRenderOpacity(bBoardHovered ? 1.0f : 0.9f);
 
-	for (int32 i = 0; i < PlayedCards.Num(); ++i)
+	// 白框亮度：Hover 時更亮
+	if (BoardBorder)
 	{
-		if (CardWidgetClass)
+		BoardBorder->SetPadding(FMargin(2.0f));
+		BoardBorder->SetBrushColor(bBoardHovered
+			? FLinearColor(1.0f, 1.0f, 1.0f, 1.0f)
+			: FLinearColor(1.0f, 1.0f, 1.0f, 0.0f));
+	}
+
+	for (UWidget* Child : BoardBox->GetAllChildren())
+	{
+		if (UCardWidget* CardWidget = Cast<UCardWidget>(Child))
 		{
-			UCardWidget* NewCard = CreateWidget<UCardWidget>(this, CardWidgetClass);
-			if (NewCard)
-			{
-				FCardData DisplayData;
-				bool bDataFound = false;
-
-				if (CardDataTable)
-				{
-					FName RowName = FName(*FString::FromInt(PlayedCards[i].CardValue));
-					static const FString ContextString(TEXT("PlayedCardContext"));
-					FCardData* CardData = CardDataTable->FindRow<FCardData>(RowName, ContextString);
-
-					if (CardData)
-					{
-						DisplayData = *CardData;
-						bDataFound = true;
-					}
-				}
-
-				if (!bDataFound)
-				{
-					DisplayData.Name = FString::Printf(TEXT("Card %d"), PlayedCards[i].CardValue);
-					DisplayData.Power = PlayedCards[i].CardValue;
-					DisplayData.Description = TEXT("");
-				}
-
-				NewCard->UpdateCardDisplay(DisplayData);
-				
-				// 檯面上的牌不可點擊
-				NewCard->SetIsEnabled(true); // 保持啟用才能看到，但移除點擊回調
-				NewCard->SetOnClicked(FOnCardClicked()); 
-				NewCard->SetDraggable(false);
-
-				// 確保沒有旋轉或縮放
-				NewCard->SetRenderTransformAngle(0.0f);
-				NewCard->SetRenderScale(FVector2D(CardScale, CardScale)); // 稍微縮小一點以適應版面
-
-				// 新建立的牌，依當前 Hover 狀態決定是否發光
-				NewCard->SetGlowEffectEnabled(BoardBox->IsHovered() || NewCard->IsHovered());
-
-				UHorizontalBoxSlot* CardSlot = Cast<UHorizontalBoxSlot>(BoardBox->AddChild(NewCard));
-				if (CardSlot)
-				{
-					// 使用動態計算的 Padding
-					CardSlot->SetPadding(FMargin(CurrentPadding, 0.0f, CurrentPadding, 0.0f));
-					CardSlot->SetSize(FSlateChildSize(ESlateSizeRule::Automatic));
-					CardSlot->SetVerticalAlignment(VAlign_Center);
-					CardSlot->SetHorizontalAlignment(HAlign_Center);
-				}
-			}
+			CardWidget->SetGlowEffectEnabled(bBoardHovered);
 		}
 	}
 }
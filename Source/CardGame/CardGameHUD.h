@@ -13,6 +13,15 @@
 #include "CardBattle.h"
 #include "CardGameHUD.generated.h"
 
+/**
+ * FCardHUDDisplayOverride - 取代 ACardBattle 的手牌與檯面資料 (HUD 效能測試用)
+ */
+struct FCardHUDDisplayOverride
+{
+	TArray<FCard> Hands[2];
+	TArray<FCard> PlayedCards[2];
+};
+
 /**
  * UCardGameHUD - 卡牌遊戲的主要 UI
  */
@@ -22,7 +31,11 @@ class CARDGAME_API UCardGameHUD : public UUserWidget
 	GENERATED_BODY()
 
 public:
+	// 手牌 Widget 以 CardValue 對應的數值上限 (對戰只用 1-30；效能測試的大手牌也走同一條對應路徑)
+	static constexpr int32 MaxKeyedCardValue = 256;
+
 	virtual void NativeConstruct() override;
+	virtual void NativeDestruct() override;
 	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
 	virtual bool NativeOnDragOver(const FGeometry& InGeometry, const FDragDropEvent& InDragDropEvent, UDragDropOperation* InOperation) override;
 	virtual bool NativeOnDrop(const FGeometry& InGeometry, const FDragDropEvent& InDragDropEvent, UDragDropOperation* InOperation) override;
@@ -31,6 +44,9 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "CardGame|UI")
 	void InitializeHUD(ACardBattle* InBattleGameMode);
 
+	// 以複製的對戰狀態初始化 HUD (客戶端沒有 ACardBattle，只有 GameState 與自己的 PlayerState)
+	void InitializeHUDFromReplicatedState(class ACardBattleGameState* InGameState);
+
 	// 更新 UI 顯示
 	UFUNCTION(BlueprintCallable, Category = "CardGame|UI")
 	void UpdateUI();
@@ -39,6 +55,15 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "CardGame|UI")
 	void OnCardClicked(int32 CardIndex);
 
+	// 以指定的手牌與檯面取代對戰資料 (nullptr 時恢復；呼叫端負責保持 Override 存活)
+	void SetDisplayOverride(const FCardHUDDisplayOverride* InOverride) { DisplayOverride = InOverride; }
+
+	// 目前顯示中的手牌與檯面 Widget 數
+	int32 GetNumCardWidgets() const;
+
+	// 卡牌 Widget 池 (尚未建立時為 nullptr)
+	const class UCardWidgetPool* GetCardWidgetPoolIfCreated() const { return CardWidgetPool; }
+
 protected:
 	// UI 組件綁定
 	UPROPERTY(meta = (BindWidget), BlueprintReadOnly)
@@ -89,7 +114,11 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CardGame")
 	TSubclassOf<class UCardWidget> CardWidgetClass;
 
-	// 卡牌資料表
+	// 物件池預先建立的卡牌 Widget 數 (雙方手牌 + 雙方檯面 + 拖曳顯示)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CardGame")
+	int32 CardWidgetPoolPrewarmCount = FBattleSimCore::HandSize * 4 + 1;
+
+	// 卡牌資料表 (GameMode 未指定時作為 Catalog 的資料來源)
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CardGame")
 	TObjectPtr<class UDataTable> CardDataTable;
 
@@ -98,12 +127,153 @@ private:
 	UPROPERTY()
 	TObjectPtr<ACardBattle> BattleGameMode;
 
-	// 更新玩家手牌顯示
+	// 已綁定事件的遊戲模式
+	TWeakObjectPtr<ACardBattle> BoundBattleGameMode;
+
+	// 客戶端：複製的對戰狀態 (沒有 GameMode 時的資料來源)
+	UPROPERTY()
+	TObjectPtr<class ACardBattleGameState> ReplicatedGameState;
+
+	// 客戶端：已綁定手牌事件的 PlayerState (自己的 PlayerState 可能比 HUD 晚到)
+	TWeakObjectPtr<class ACardBattlePlayerState> BoundPlayerState;
+
+	// 本機玩家的座位 (這個座位的手牌可以點擊與拖曳到檯面)
+	int32 LocalSeatId = 0;
+
+	// 客戶端由複製資料組成的手牌 (對手只有張數，以無效牌表示背面) 與檯面
+	TArray<FCard> ReplicatedHands[2];
+	TArray<FCard> ReplicatedPlayedCards[2];
+
+	// 效能測試時取代對戰資料
+	const FCardHUDDisplayOverride* DisplayOverride = nullptr;
+
+	// 要顯示的手牌與已出的牌 (有 Override 時使用 Override)
+	TConstArrayView<FCard> GetDisplayedHand(int32 PlayerId) const;
+	TConstArrayView<FCard> GetDisplayedPlayedCards(int32 PlayerId) const;
+
+	// 綁定 / 解除 ACardBattle 的 UI 事件
+	void BindBattleEvents(ACardBattle* InBattleGameMode);
+	void UnbindBattleEvents();
+
+	// 綁定 / 解除 ACardBattleGameState 與自己的 ACardBattlePlayerState 的複製事件
+	void BindReplicatedState(class ACardBattleGameState* InGameState);
+	void UnbindReplicatedState();
+	void BindLocalPlayerState();
+
+	// 複製事件處理 (客戶端)
+	void HandleReplicatedStateChanged();
+	void HandleReplicatedHandChanged();
+
+	// 從 GameState 與 PlayerState 重新組成手牌與檯面
+	void RefreshReplicatedCards();
+
+	// 有可以顯示的對戰 (GameMode 或複製的狀態)
+	bool HasBattleSource() const { return BattleGameMode || ReplicatedGameState; }
+
+	// 顯示用的對戰資料 (GameMode 或複製的狀態)
+	int32 GetDisplayedScore(int32 PlayerId) const;
+	int32 GetDisplayedTurnPlayerId() const;
+	EBattleState GetDisplayedBattleState() const;
+	int32 GetDisplayedWinner() const;
+	FRoundInfo GetDisplayedLastRound() const;
+	float GetDisplayedRemainingTime() const;
+	float GetDisplayedTurnTimeLimit() const;
+
+	// 螢幕座標是否在自己座位的檯面上 (拖放出牌)
+	bool IsOverLocalBoard(const FVector2D& ScreenPosition) const;
+
+	// ACardBattle 事件處理 (只更新受影響的元件)
+	void HandleScoreChanged(int32 PlayerId, int32 NewScore);
+	void HandleHandChanged(int32 PlayerId);
+	void HandleCardPlayed(int32 PlayerId, FCard PlayedCard);
+	void HandleBattleStateChanged(EBattleState NewState);
+	void HandleTurnTimerTick(float RemainingTime);
+
+	// 更新分數文字
+	void UpdateScoreText(int32 PlayerId);
+
+	// 更新計時器 (只有顯示數值改變時才設定文字)
+	void UpdateTimerDisplay(float RemainingTime);
+
+	// 更新回合、狀態、上回合結果與獲勝者
+	void UpdateBattleStateDisplay();
+
+	// 檯面 Hover 外觀 (只在狀態改變時更新)
+	void UpdateBoardHover(int32 PlayerId, UHorizontalBox* BoardBox, bool bForce = false);
+
+	// 上次顯示的剩餘時間 (以 0.1 秒為單位)
+	int32 LastDisplayedTimerTenths = INDEX_NONE;
+
+	// 檯面目前的 Hover 狀態
+	bool bBoardHoveredState[2] = { false, false };
+
+	// 共用的卡牌資料快取
+	UPROPERTY()
+	TObjectPtr<class UCardCatalogSubsystem> CardCatalog;
+
+	FDelegateHandle CatalogChangedHandle;
+
+	// 手牌、檯面與拖曳顯示共用的卡牌 Widget 池
+	UPROPERTY()
+	TObjectPtr<class UCardWidgetPool> CardWidgetPool;
+
+	// 取得 (必要時建立) 卡牌 Widget 池
+	class UCardWidgetPool* GetCardWidgetPool();
+
+	// 從池中取得卡牌 Widget
+	class UCardWidget* AcquireCardWidget();
+
+	// 取得 Catalog 並綁定變更通知
+	void BindCardCatalog();
+
+	// 從 Catalog 取得卡牌資料 (穩定指標)
+	const struct FCardData* FindCardData(int32 CardValue) const;
+
+	// Catalog 重建時刷新所有卡牌
+	void OnCardCatalogChanged();
+
+	// 更新玩家手牌顯示 (以 CardValue 比對現有 Widget，只新增或移除有變動的牌)
 	void UpdatePlayerHand(int32 PlayerId, UHorizontalBox* HandBox);
 
-	// 更新檯面上已出的牌顯示
+	// 手牌扇形排版 (每種手牌數一份)
+	struct FHandFanLayout
+	{
+		// 每張牌左右的邊距
+		float Padding = 0.0f;
+
+		// 每張牌的旋轉角度
+		TArray<float, TInlineAllocator<FBattleSimCore::HandSize>> Angles;
+	};
+
+	// 取得指定手牌數的扇形排版 (快取)
+	const FHandFanLayout& GetHandFanLayout(int32 NumCards);
+
+	// 以目前畫面寬度重建 0..MaxCards 張的排版
+	void RebuildHandFanLayouts(int32 MaxCards);
+
+	// 畫面寬度改變時重建排版並套用到手牌
+	void UpdateFanLayoutViewport(float ViewportWidth);
+
+	// 扇形排版快取與其對應的畫面寬度 (Slate 單位)
+	TArray<FHandFanLayout> HandFanLayouts;
+	float FanLayoutViewportWidth = 0.0f;
+
+	// 各手牌目前套用的排版 (手牌數與畫面寬度)
+	int32 AppliedFanLayoutNum[2] = { INDEX_NONE, INDEX_NONE };
+	float AppliedFanLayoutWidth[2] = { 0.0f, 0.0f };
+
+	// 同步檯面上已出的牌 (保留與歷史相符的前綴，只補上缺少的牌)
 	void UpdatePlayedCards(int32 PlayerId, UHorizontalBox* BoardBox);
 
+	// 在檯面尾端加入一張剛打出的牌
+	void AppendPlayedCard(int32 PlayerId, UHorizontalBox* BoardBox, FCard PlayedCard);
+
+	// 依檯面牌數更新間距 (間距沒變時不做任何事)
+	void UpdateBoardPadding(int32 PlayerId, UHorizontalBox* BoardBox);
+
+	// 檯面目前套用的間距
+	float BoardPadding[2] = { 5.0f, 5.0f };
+
 	// 獲取遊戲狀態文字
 	FString GetBattleStateString(EBattleState State) const;
 };
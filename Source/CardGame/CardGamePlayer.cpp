@@ -95,11 +95,10 @@ void ACardGamePlayer::PlayRandomCard()
 {
 	if (BattleGameMode)
 	{
-		// 獲取玩家手牌
-		const TArray<FCard>& Hand = BattleGameMode->GetPlayerHand(PlayerID);
-		if (Hand.Num() > 0)
+		// 以這局的亂數流選牌 (同一種子可重現)
+		const int32 RandomIndex = BattleGameMode->PickRandomCardIndex(PlayerID);
+		if (RandomIndex != INDEX_NONE)
 		{
-			int32 RandomIndex = FMath::RandRange(0, Hand.Num() - 1);
 			PlayCard(RandomIndex);
 		}
 	}
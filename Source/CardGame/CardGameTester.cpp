@@ -1,6 +1,8 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "CardGameTester.h"
+#include "Sim/BattleTournament.h"
+#include "UI/CardHUDBenchmark.h"
 
 ACardGameTester::ACardGameTester()
 	: bIsTestingGame(false)
@@ -43,7 +45,7 @@ void ACardGameTester::Tick(float DeltaTime)
 	}
 }
 
-void ACardGameTester::StartTestGame()
+void ACardGameTester::StartTestGame(int32 Seed)
 {
 	if (!BattleGameMode)
 	{
@@ -56,7 +58,8 @@ void ACardGameTester::StartTestGame()
 	bIsTestingGame = true;
 	TimeSinceLastAutoPlay = 0.0f;
 
-	BattleGameMode->StartGame();
+	BattleGameMode->StartGame(Seed);
+	UE_LOG(LogTemp, Warning, TEXT("Test game seed: %d"), BattleGameMode->GetMatchSeed());
 	LogGameState();
 }
 
@@ -100,8 +103,8 @@ void ACardGameTester::LogGameState()
 	EBattleState State = BattleGameMode->GetBattleState();
 	int32 Player0Score = BattleGameMode->GetPlayerScore(0);
 	int32 Player1Score = BattleGameMode->GetPlayerScore(1);
-	const TArray<FCard>& Player0Hand = BattleGameMode->GetPlayerHand(0);
-	const TArray<FCard>& Player1Hand = BattleGameMode->GetPlayerHand(1);
+	const TConstArrayView<FCard> Player0Hand = BattleGameMode->GetPlayerHandView(0);
+	const TConstArrayView<FCard> Player1Hand = BattleGameMode->GetPlayerHandView(1);
 
 	UE_LOG(LogTemp, Warning, TEXT("========== GAME STATE =========="));
 	UE_LOG(LogTemp, Warning, TEXT("Battle State: %d"), (int32)State);
@@ -148,12 +151,12 @@ void ACardGameTester::AutoPlayRound()
 	if (State == EBattleState::WaitingForPlayer0 || State == EBattleState::WaitingForPlayer1)
 	{
 		int32 CurrentPlayer = BattleGameMode->GetCurrentTurnPlayerId();
-		const TArray<FCard>& Hand = BattleGameMode->GetPlayerHand(CurrentPlayer);
+		const TConstArrayView<FCard> Hand = BattleGameMode->GetPlayerHandView(CurrentPlayer);
 
 		if (Hand.Num() > 0)
 		{
 			// 隨機選擇一張牌
-			int32 RandomCardIndex = FMath::RandRange(0, Hand.Num() - 1);
+			int32 RandomCardIndex = BattleGameMode->PickRandomCardIndex(CurrentPlayer);
 			UE_LOG(LogTemp, Warning, TEXT("Player %d plays card (index %d, value %d)"),
 				CurrentPlayer, RandomCardIndex, Hand[RandomCardIndex].CardValue);
 
@@ -165,3 +168,31 @@ void ACardGameTester::AutoPlayRound()
 		}
 	}
 }
+
+void ACardGameTester::RunTournament(int32 NumGames, int32 Seed)
+{
+	FBattleTournamentSettings Settings;
+	Settings.NumGames = NumGames;
+	Settings.Seed = Seed;
+
+	// 使用與 GameMode 相同的卡牌資料
+	if (BattleGameMode)
+	{
+		FBattleTournament::ConfigureFromDataTable(Settings, BattleGameMode->GetCardDataTable());
+	}
+
+	UE_LOG(LogTemp, Warning, TEXT("===== RUNNING TOURNAMENT (%d games) ====="), NumGames);
+
+	const FBattleTournamentResult Result = FBattleTournament::Run(Settings);
+	Result.LogReport();
+}
+
+void ACardGameTester::RunHUDBenchmark(int32 MeasureFrames)
+{
+	// 測試期間不自動出牌，HUD 由腳本資料驅動
+	bIsTestingGame = false;
+
+	FCardHUDBenchmarkSettings Settings;
+	Settings.MeasureFrames = FMath::Max(MeasureFrames, 1);
+	FCardHUDBenchmark::Start(GetWorld(), Settings);
+}
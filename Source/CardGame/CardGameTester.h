@@ -22,9 +22,9 @@ public:
 	virtual void BeginPlay() override;
 	virtual void Tick(float DeltaTime) override;
 
-	// 開始測試遊戲
+	// 開始測試遊戲 (Seed 為 0 時自動產生，可用記錄下的種子重現同一局)
 	UFUNCTION(BlueprintCallable, Category = "Testing")
-	void StartTestGame();
+	void StartTestGame(int32 Seed = 0);
 
 	// 停止測試遊戲
 	UFUNCTION(BlueprintCallable, Category = "Testing")
@@ -42,6 +42,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Testing")
 	void SetAutoPlayDelay(float Delay) { AutoPlayDelaySeconds = Delay; }
 
+	// 以所有核心批次模擬大量對戰並輸出勝率統計 (不影響目前這局)
+	UFUNCTION(BlueprintCallable, Category = "Testing")
+	void RunTournament(int32 NumGames = 100000, int32 Seed = 0);
+
+	// 以腳本對戰驅動 HUD (手牌 10、50、200 張)，結果寫到 Saved/Benchmarks/
+	UFUNCTION(BlueprintCallable, Category = "Testing")
+	void RunHUDBenchmark(int32 MeasureFrames = 300);
+
 private:
 	// 對戰遊戲模式指針
 	UPROPERTY()
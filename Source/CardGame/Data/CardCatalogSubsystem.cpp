@@ -0,0 +1,130 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Data/CardCatalogSubsystem.h"
+#include "Sim/BattleSimCore.h"
+#include "Engine/DataTable.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+
+void UCardCatalogSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	SetSourceTable(DefaultCardDataTable.LoadSynchronous());
+
+	if (!SourceTable)
+	{
+		// 仍然建立預設資料，確保 FindCard 總是可用
+		Rebuild();
+	}
+}
+
+void UCardCatalogSubsystem::Deinitialize()
+{
+#if WITH_EDITOR
+	if (SourceTable && SourceTableChangedHandle.IsValid())
+	{
+		SourceTable->OnDataTableChanged().Remove(SourceTableChangedHandle);
+		SourceTableChangedHandle.Reset();
+	}
+#endif
+
+	SourceTable = nullptr;
+	CatalogChangedEvent.Clear();
+
+	Super::Deinitialize();
+}
+
+UCardCatalogSubsystem* UCardCatalogSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	return GameInstance ? GameInstance->GetSubsystem<UCardCatalogSubsystem>() : nullptr;
+}
+
+void UCardCatalogSubsystem::SetSourceTable(UDataTable* InDataTable)
+{
+	if (SourceTable == InDataTable)
+	{
+		return;
+	}
+
+#if WITH_EDITOR
+	if (SourceTable && SourceTableChangedHandle.IsValid())
+	{
+		SourceTable->OnDataTableChanged().Remove(SourceTableChangedHandle);
+		SourceTableChangedHandle.Reset();
+	}
+#endif
+
+	SourceTable = InDataTable;
+
+#if WITH_EDITOR
+	// 編輯器中修改 DataTable 時自動重建
+	if (SourceTable)
+	{
+		SourceTableChangedHandle = SourceTable->OnDataTableChanged().AddUObject(this, &UCardCatalogSubsystem::Rebuild);
+	}
+#endif
+
+	Rebuild();
+}
+
+bool UCardCatalogSubsystem::HasCardData(int32 CardValue) const
+{
+	return bHasData[FMath::Min((uint32)CardValue, (uint32)FCardPowerTable::InvalidIndex)];
+}
+
+void UCardCatalogSubsystem::Rebuild()
+{
+	const bool bValidTable = SourceTable && SourceTable->GetRowStruct() && SourceTable->GetRowStruct()->IsChildOf(FCardData::StaticStruct());
+	if (SourceTable && !bValidTable)
+	{
+		UE_LOG(LogTemp, Error, TEXT("CardCatalog: DataTable '%s' does not use FCardData rows"), *SourceTable->GetName());
+	}
+	else if (!SourceTable)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("CardCatalog: No card DataTable set, using default card data"));
+	}
+
+	// 預設顯示資料 (找不到資料時使用)
+	for (int32 CardValue = 0; CardValue < FCardPowerTable::NumEntries; ++CardValue)
+	{
+		FCardData& Entry = Entries[CardValue];
+		Entry = FCardData();
+		Entry.Name = CardValue <= FCardPowerTable::MaxCardValue ? FString::Printf(TEXT("Card %d"), CardValue) : TEXT("Unknown Card");
+		Entry.Power = CardValue <= FCardPowerTable::MaxCardValue ? CardValue : 0;
+		Entry.Description = TEXT("No Data");
+		bHasData[CardValue] = false;
+	}
+
+	if (bValidTable)
+	{
+		for (const TPair<FName, uint8*>& Row : SourceTable->GetRowMap())
+		{
+			// RowName 就是 CardValue 的字串形式
+			const FString RowString = Row.Key.ToString();
+			if (!RowString.IsNumeric())
+			{
+				continue;
+			}
+
+			const int32 CardValue = FCString::Atoi(*RowString);
+			if (CardValue >= 0 && CardValue <= FCardPowerTable::MaxCardValue)
+			{
+				Entries[CardValue] = *reinterpret_cast<const FCardData*>(Row.Value);
+				bHasData[CardValue] = true;
+			}
+		}
+	}
+
+	// 建立新的一份再替換：工作執行緒上的規則核心可能還在讀舊的表
+	TSharedRef<FCardPowerTable, ESPMode::ThreadSafe> NewPowerTable = MakeShared<FCardPowerTable, ESPMode::ThreadSafe>();
+	NewPowerTable->Build(bValidTable ? SourceTable.Get() : nullptr);
+	PowerTable = NewPowerTable;
+
+	// 牌組與規則核心使用同一套篩選 (1-30、不重複、最多 30 張)
+	FBattleSimCore::BuildDeck(bValidTable ? SourceTable.Get() : nullptr, DeckCards);
+
+	CatalogChangedEvent.Broadcast();
+}
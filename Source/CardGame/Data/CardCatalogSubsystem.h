@@ -0,0 +1,83 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Card.h"
+#include "Data/DT_CardData.h"
+#include "Sim/CardPowerTable.h"
+#include "CardCatalogSubsystem.generated.h"
+
+DECLARE_MULTICAST_DELEGATE(FOnCardCatalogChanged);
+
+/**
+ * UCardCatalogSubsystem - 全遊戲共用的卡牌資料快取
+ * DataTable 只載入、解析一次，之後以 CardValue 直接索引。
+ * FindCard 回傳的指標在整個 GameInstance 生命週期內都有效 (重建時原地覆寫)，
+ * HUD、卡牌 Widget 與 GameMode 都讀取這份快取，不再每幀 FindRow 並複製 FCardData。
+ */
+UCLASS(Config = Game)
+class CARDGAME_API UCardCatalogSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// 從任意 WorldContext 取得 Catalog
+	static UCardCatalogSubsystem* Get(const UObject* WorldContextObject);
+
+	// 設定資料來源 (與目前相同時不做任何事)
+	void SetSourceTable(UDataTable* InDataTable);
+
+	// 目前的資料來源
+	UDataTable* GetSourceTable() const { return SourceTable; }
+
+	// 以 CardValue 取得卡牌資料；永遠不為 nullptr (找不到時回傳預設顯示資料)
+	const FCardData* FindCard(int32 CardValue) const
+	{
+		return &Entries[FMath::Min((uint32)CardValue, (uint32)FCardPowerTable::InvalidIndex)];
+	}
+
+	// DataTable 中是否有該卡牌的資料
+	bool HasCardData(int32 CardValue) const;
+
+	// 編譯後的規則數值表 (所有規則核心共用；重建時換成新的一份，已發出的參照保持不變)
+	const FCardPowerTableRef& GetPowerTable() const { return PowerTable; }
+
+	// 牌組使用的卡牌 (依資料表順序；見 FBattleSimCore::BuildDeck)
+	TConstArrayView<FCard> GetDeckCards() const { return DeckCards; }
+
+	// 資料重建時通知 (編輯器中修改 DataTable)
+	FOnCardCatalogChanged& OnCatalogChanged() { return CatalogChangedEvent; }
+
+private:
+	// 依 SourceTable 重建所有快取
+	void Rebuild();
+
+	// 預設的卡牌資料表
+	UPROPERTY(Config)
+	TSoftObjectPtr<UDataTable> DefaultCardDataTable;
+
+	// 目前的資料來源
+	UPROPERTY()
+	TObjectPtr<UDataTable> SourceTable;
+
+	// CardValue -> 卡牌資料 (固定大小，指標穩定)
+	FCardData Entries[FCardPowerTable::NumEntries];
+
+	// CardValue -> 是否來自 DataTable
+	bool bHasData[FCardPowerTable::NumEntries];
+
+	FCardPowerTableRef PowerTable = FCardPowerTable::GetDefault();
+
+	TArray<FCard> DeckCards;
+
+	FOnCardCatalogChanged CatalogChangedEvent;
+
+#if WITH_EDITOR
+	FDelegateHandle SourceTableChangedHandle;
+#endif
+};
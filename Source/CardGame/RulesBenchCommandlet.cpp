@@ -0,0 +1,300 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "RulesBenchCommandlet.h"
+#include "Card.h"
+#include "BattlePlayer.h"
+#include "Sim/BattleSimCore.h"
+#include "Sim/BattleTournament.h"
+#include "Engine/DataTable.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/App.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "UObject/StrongObjectPtr.h"
+
+namespace RulesBench
+{
+	// 單一案例的結果 (每次操作的奈秒數)
+	struct FCaseResult
+	{
+		FString Name;
+		TArray<double> NsPerOp;
+		double Median = 0.0;
+		double P99 = 0.0;
+		double Min = 0.0;
+		double Mean = 0.0;
+	};
+
+	// 累加每個案例的回傳值，避免編譯器把被量測的呼叫整個省略
+	static volatile int64 GSink = 0;
+
+	static double GetPercentile(const TArray<double>& Sorted, double Fraction)
+	{
+		return Sorted.Num() > 0 ? Sorted[FMath::Clamp((int32)(Fraction * (Sorted.Num() - 1)), 0, Sorted.Num() - 1)] : 0.0;
+	}
+
+	// Body(Count) 執行 Count 次操作並回傳檢查值；每次重複量測整批操作再換算成每次操作的時間，
+	// 避免逐次呼叫 Cycles64 的開銷蓋過只有幾奈秒的操作
+	template<typename BodyType>
+	static FCaseResult RunCase(const TCHAR* Name, int32 NumWarmup, int32 NumReps, int32 NumOps, BodyType&& Body)
+	{
+		FCaseResult Result;
+		Result.Name = Name;
+
+		for (int32 Rep = 0; Rep < NumWarmup; ++Rep)
+		{
+			GSink = GSink + Body(NumOps);
+		}
+
+		Result.NsPerOp.Reserve(NumReps);
+		for (int32 Rep = 0; Rep < NumReps; ++Rep)
+		{
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+			const int64 Check = Body(NumOps);
+			const uint64 EndCycles = FPlatformTime::Cycles64();
+			GSink = GSink + Check;
+
+			Result.NsPerOp.Add(FPlatformTime::ToSeconds64(EndCycles - StartCycles) * 1.0e9 / NumOps);
+		}
+
+		TArray<double> Sorted = Result.NsPerOp;
+		Sorted.Sort();
+
+		double Sum = 0.0;
+		for (double Sample : Sorted)
+		{
+			Sum += Sample;
+		}
+
+		Result.Median = GetPercentile(Sorted, 0.5);
+		Result.P99 = GetPercentile(Sorted, 0.99);
+		Result.Min = Sorted.Num() > 0 ? Sorted[0] : 0.0;
+		Result.Mean = Sorted.Num() > 0 ? Sum / Sorted.Num() : 0.0;
+
+		UE_LOG(LogTemp, Display, TEXT("%-40s median %10.1f ns  p99 %10.1f ns  min %10.1f ns  mean %10.1f ns"),
+			Name, Result.Median, Result.P99, Result.Min, Result.Mean);
+
+		return Result;
+	}
+
+	static bool WriteJson(const FString& FilePath, const TArray<FCaseResult>& Results, int32 NumWarmup, int32 NumReps, int32 NumOps, int32 Seed)
+	{
+		FString Json;
+		Json += TEXT("{\n");
+		Json += TEXT("\t\"benchmark\": \"RulesBench\",\n");
+		Json += FString::Printf(TEXT("\t\"timestamp\": \"%s\",\n"), *FDateTime::UtcNow().ToIso8601());
+		Json += FString::Printf(TEXT("\t\"platform\": \"%s\",\n"), ANSI_TO_TCHAR(FPlatformProperties::PlatformName()));
+		Json += FString::Printf(TEXT("\t\"configuration\": \"%s\",\n"), LexToString(FApp::GetBuildConfiguration()));
+		Json += FString::Printf(TEXT("\t\"warmup\": %d,\n\t\"reps\": %d,\n\t\"opsPerRep\": %d,\n\t\"seed\": %d,\n"), NumWarmup, NumReps, NumOps, Seed);
+		Json += TEXT("\t\"cases\": [\n");
+
+		for (int32 i = 0; i < Results.Num(); ++i)
+		{
+			const FCaseResult& Result = Results[i];
+
+			FString Samples;
+			for (int32 Rep = 0; Rep < Result.NsPerOp.Num(); ++Rep)
+			{
+				Samples += FString::Printf(TEXT("%s%.2f"), Rep > 0 ? TEXT(", ") : TEXT(""), Result.NsPerOp[Rep]);
+			}
+
+			Json += FString::Printf(TEXT("\t\t{ \"name\": \"%s\", \"medianNs\": %.2f, \"p99Ns\": %.2f, \"minNs\": %.2f, \"meanNs\": %.2f, \"samplesNs\": [%s] }%s\n"),
+				*Result.Name, Result.Median, Result.P99, Result.Min, Result.Mean, *Samples, i + 1 < Results.Num() ? TEXT(",") : TEXT(""));
+		}
+
+		Json += TEXT("\t]\n}\n");
+		return FFileHelper::SaveStringToFile(Json, *FilePath);
+	}
+}
+
+URulesBenchCommandlet::URulesBenchCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 URulesBenchCommandlet::Main(const FString& Params)
+{
+	using namespace RulesBench;
+
+	int32 NumReps = 51;
+	int32 NumWarmup = 5;
+	int32 NumOps = 10000;
+	int32 Seed = 1;
+	FParse::Value(*Params, TEXT("Reps="), NumReps);
+	FParse::Value(*Params, TEXT("Warmup="), NumWarmup);
+	FParse::Value(*Params, TEXT("Ops="), NumOps);
+	FParse::Value(*Params, TEXT("Seed="), Seed);
+
+	// 只跑名稱包含 Filter 的案例
+	FString Filter;
+	FParse::Value(*Params, TEXT("Filter="), Filter);
+
+	FString TablePath(TEXT("/Game/DataTable/DT_CardData.DT_CardData"));
+	FParse::Value(*Params, TEXT("Table="), TablePath);
+
+	FString JsonPath = FPaths::ProjectSavedDir() / TEXT("Benchmarks")
+		/ FString::Printf(TEXT("RulesBench_%s.json"), *FDateTime::Now().ToString());
+	FParse::Value(*Params, TEXT("Json="), JsonPath);
+
+	if (NumReps <= 0 || NumOps <= 0 || NumWarmup < 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("RulesBench: -Reps and -Ops must be positive, -Warmup must not be negative"));
+		return 1;
+	}
+
+	// 與 BattleTournament 相同的方式從 DataTable 取得牌組與 Power 表
+	FBattleTournamentSettings TableSettings;
+	UDataTable* DataTable = LoadObject<UDataTable>(nullptr, *TablePath);
+	if (DataTable)
+	{
+		FBattleTournament::ConfigureFromDataTable(TableSettings, DataTable);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RulesBench: Could not load DataTable '%s', using default cards"), *TablePath);
+	}
+
+	TArray<FCard> DeckCards = TableSettings.DeckCards;
+	if (DeckCards.Num() == 0)
+	{
+		FBattleSimCore::GetDefaultDeck(DeckCards);
+	}
+
+	const FBattleSimCore Prototype = TableSettings.Prototype;
+
+	TStrongObjectPtr<UCardDeck> Deck(NewObject<UCardDeck>());
+	TStrongObjectPtr<UBattlePlayer> Player(NewObject<UBattlePlayer>());
+	Player->SetDeck(Deck.Get());
+
+	FRandomStream Random(Seed);
+	TArray<FCaseResult> Results;
+
+	auto ShouldRun = [&Filter](const TCHAR* Name)
+	{
+		return Filter.IsEmpty() || FCString::Stristr(Name, *Filter) != nullptr;
+	};
+
+	UE_LOG(LogTemp, Display, TEXT("========== RULES BENCH =========="));
+	UE_LOG(LogTemp, Display, TEXT("%d cards, %d warmup + %d reps x %d ops, seed %d"), DeckCards.Num(), NumWarmup, NumReps, NumOps, Seed);
+
+	// ShuffleDeck 是私有函式，透過 InitializeFromCards (複製牌組 + 洗牌) 量測
+	if (ShouldRun(TEXT("Deck.Shuffle")))
+	{
+		Results.Add(RunCase(TEXT("Deck.Shuffle (InitializeFromCards)"), NumWarmup, NumReps, NumOps, [&](int32 Count)
+		{
+			int32 Check = 0;
+			for (int32 Op = 0; Op < Count; ++Op)
+			{
+				Deck->InitializeFromCards(DeckCards, Random);
+				Check += Deck->DrawCards(1)[0].CardValue;
+			}
+			return Check;
+		}));
+	}
+
+	if (DataTable && ShouldRun(TEXT("Deck.InitializeFromDataTable")))
+	{
+		Results.Add(RunCase(TEXT("Deck.InitializeFromDataTable"), NumWarmup, NumReps, NumOps, [&](int32 Count)
+		{
+			int32 Check = 0;
+			for (int32 Op = 0; Op < Count; ++Op)
+			{
+				Deck->InitializeFromDataTable(DataTable, Random);
+				Check += Deck->DrawCards(1)[0].CardValue;
+			}
+			return Check;
+		}));
+	}
+
+	// 每次操作 = 洗牌、抽 HandSize 張、依序打完；扣掉 Deck.Shuffle 就是抽牌與出牌的成本
+	if (ShouldRun(TEXT("Player.PlayCard")))
+	{
+		Results.Add(RunCase(TEXT("Player.PlayCard (shuffle+draw+play 10)"), NumWarmup, NumReps, NumOps, [&](int32 Count)
+		{
+			int32 Check = 0;
+			for (int32 Op = 0; Op < Count; ++Op)
+			{
+				Deck->InitializeFromCards(DeckCards, Random);
+				Player->Initialize(0);
+				Player->DrawCardsToHand(FBattleSimCore::HandSize);
+				while (Player->GetHandSize() > 0)
+				{
+					Check += Player->PlayCard(Player->GetHandSize() - 1).CardValue;
+				}
+			}
+			return Check;
+		}));
+	}
+
+	if (ShouldRun(TEXT("Player.PlayCardRandom")))
+	{
+		Results.Add(RunCase(TEXT("Player.PlayCardRandom (shuffle+draw+play 10)"), NumWarmup, NumReps, NumOps, [&](int32 Count)
+		{
+			int32 Check = 0;
+			for (int32 Op = 0; Op < Count; ++Op)
+			{
+				Deck->InitializeFromCards(DeckCards, Random);
+				Player->Initialize(0);
+				Player->DrawCardsToHand(FBattleSimCore::HandSize);
+				while (Player->GetHandSize() > 0)
+				{
+					Check += Player->PlayCardRandom(Random).CardValue;
+				}
+			}
+			return Check;
+		}));
+	}
+
+	if (ShouldRun(TEXT("SimCore.GetCardPower")))
+	{
+		Results.Add(RunCase(TEXT("SimCore.GetCardPower"), NumWarmup, NumReps, NumOps, [&](int32 Count)
+		{
+			int32 Check = 0;
+			for (int32 Op = 0; Op < Count; ++Op)
+			{
+				Check += Prototype.GetCardPower(DeckCards[Op % DeckCards.Num()].CardValue);
+			}
+			return Check;
+		}));
+	}
+
+	// 整局對戰：與 BattleTournament 相同的發牌、決定先手與隨機出牌流程
+	if (ShouldRun(TEXT("SimCore.RandomGame")))
+	{
+		Results.Add(RunCase(TEXT("SimCore.RandomGame"), NumWarmup, NumReps, NumOps, [&](int32 Count)
+		{
+			FBattleSimCore Game = Prototype;
+			int32 Check = 0;
+			for (int32 Op = 0; Op < Count; ++Op)
+			{
+				Game.Reset();
+				Game.DealHands(DeckCards, Random);
+				Game.Start(Random.RandRange(0, 1));
+				Check += Game.RunRandomGame(Random);
+			}
+			return Check;
+		}));
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("================================="));
+
+	if (Results.Num() == 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("RulesBench: No case matches -Filter=%s"), *Filter);
+		return 1;
+	}
+
+	if (!WriteJson(JsonPath, Results, NumWarmup, NumReps, NumOps, Seed))
+	{
+		UE_LOG(LogTemp, Error, TEXT("RulesBench: Failed to write %s"), *JsonPath);
+		return 1;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("RulesBench: Results written to %s"), *FPaths::ConvertRelativePathToFull(JsonPath));
+	return 0;
+}
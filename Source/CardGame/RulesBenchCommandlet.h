@@ -0,0 +1,25 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "RulesBenchCommandlet.generated.h"
+
+/**
+ * URulesBenchCommandlet - 規則與牌組程式碼的微基準測試
+ * 量測 UCardDeck 洗牌/初始化、UBattlePlayer 出牌、GetCardPower 與整局對戰，
+ * 每個案例先暖身再重複多次，回報每次操作的 median/p99 並輸出 JSON 到 Saved/Benchmarks/。
+ * 用法: UnrealEditor-Cmd CardGame.uproject -run=RulesBench [-Reps=51] [-Warmup=5] [-Ops=10000] [-Seed=1]
+ *       [-Filter=Deck] [-Table=/Game/DataTable/DT_CardData.DT_CardData] [-Json=Path/To/Result.json]
+ */
+UCLASS()
+class CARDGAME_API URulesBenchCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	URulesBenchCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,135 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Server/BattleHostSubsystem.h"
+#include "Data/CardCatalogSubsystem.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+
+static FAutoConsoleCommandWithWorldAndArgs GBattleHostBenchCommand(
+	TEXT("CardGame.HostBench"),
+	TEXT("Run the multi-match host benchmark. Usage: CardGame.HostBench [Matches=10000] [Seed=1]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		const int32 NumMatches = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 10000;
+		const int32 Seed = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 1;
+
+		if (const UBattleHostSubsystem* HostSubsystem = UBattleHostSubsystem::Get(World))
+		{
+			HostSubsystem->RunBenchmark(NumMatches, Seed);
+		}
+		else
+		{
+			FBattleMatchHost::RunBenchmark(FBattleSimCore(), TConstArrayView<FCard>(), NumMatches, Seed);
+		}
+	}));
+
+void UBattleHostSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	Collection.InitializeDependency<UCardCatalogSubsystem>();
+	ConfigureFromCatalog();
+
+	if (UCardCatalogSubsystem* Catalog = GetGameInstance()->GetSubsystem<UCardCatalogSubsystem>())
+	{
+		CatalogChangedHandle = Catalog->OnCatalogChanged().AddUObject(this, &UBattleHostSubsystem::ConfigureFromCatalog);
+	}
+
+	bInitialized = true;
+}
+
+void UBattleHostSubsystem::Deinitialize()
+{
+	bInitialized = false;
+
+	if (UCardCatalogSubsystem* Catalog = GetGameInstance()->GetSubsystem<UCardCatalogSubsystem>())
+	{
+		Catalog->OnCatalogChanged().Remove(CatalogChangedHandle);
+	}
+	CatalogChangedHandle.Reset();
+	MatchFinishedEvent.Clear();
+
+	Super::Deinitialize();
+}
+
+UBattleHostSubsystem* UBattleHostSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	return GameInstance ? GameInstance->GetSubsystem<UBattleHostSubsystem>() : nullptr;
+}
+
+void UBattleHostSubsystem::ConfigureFromCatalog()
+{
+	// 已在進行中的對戰保留開局時的規則，只有新對戰使用新的數值
+	FBattleSimCore Prototype;
+	TConstArrayView<FCard> DeckCards;
+
+	if (const UCardCatalogSubsystem* Catalog = GetGameInstance()->GetSubsystem<UCardCatalogSubsystem>())
+	{
+		Prototype.SetPowerTable(Catalog->GetPowerTable());
+		DeckCards = Catalog->GetDeckCards();
+	}
+
+	Host.Configure(Prototype, DeckCards, TurnTimeLimit);
+	Host.MatchesPerTask = MatchesPerTask;
+}
+
+FBattleMatchHandle UBattleHostSubsystem::CreateMatch(int32 Seed, uint8 BotSeatMask)
+{
+	if (Seed == 0)
+	{
+		Seed = (int32)GetTypeHash(FPlatformTime::Cycles64());
+		Seed = Seed != 0 ? Seed : 1;
+	}
+
+	return Host.CreateMatch(Seed, BotSeatMask);
+}
+
+void UBattleHostSubsystem::DestroyMatch(FBattleMatchHandle Handle)
+{
+	Host.DestroyMatch(Handle);
+}
+
+bool UBattleHostSubsystem::SubmitAction(FBattleMatchHandle Handle, const FBattleAction& Action)
+{
+	return Host.SubmitAction(Handle, Action);
+}
+
+void UBattleHostSubsystem::RunBenchmark(int32 NumMatches, int32 Seed) const
+{
+	FBattleSimCore Prototype;
+	TConstArrayView<FCard> DeckCards;
+
+	if (const UCardCatalogSubsystem* Catalog = GetGameInstance()->GetSubsystem<UCardCatalogSubsystem>())
+	{
+		Prototype.SetPowerTable(Catalog->GetPowerTable());
+		DeckCards = Catalog->GetDeckCards();
+	}
+
+	FBattleMatchHost::RunBenchmark(Prototype, DeckCards, NumMatches, Seed);
+}
+
+void UBattleHostSubsystem::Tick(float DeltaTime)
+{
+	FinishedMatches.Reset();
+	Host.Step(DeltaTime, FinishedMatches);
+
+	for (const FBattleMatchHandle& Handle : FinishedMatches)
+	{
+		if (const FBattleHostedMatch* Match = Host.FindMatch(Handle))
+		{
+			MatchFinishedEvent.Broadcast(Handle, Match->Game);
+		}
+	}
+}
+
+bool UBattleHostSubsystem::IsTickable() const
+{
+	return bInitialized && Host.GetNumActiveMatches() > 0;
+}
+
+TStatId UBattleHostSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UBattleHostSubsystem, STATGROUP_Tickables);
+}
@@ -0,0 +1,79 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Tickable.h"
+#include "Sim/BattleMatchHost.h"
+#include "BattleHostSubsystem.generated.h"
+
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnHostedMatchFinished, FBattleMatchHandle /*Handle*/, const FBattleSimCore& /*Game*/);
+
+/**
+ * UBattleHostSubsystem - 在一個行程中同時主持大量對戰 (伺服器用)
+ * 每場對戰只是 FBattleMatchHost 連續陣列中的一筆資料，不需要 UWorld 或 GameMode；
+ * 每幀由一次 Tick 以多執行緒推進所有對戰，結束的對戰在遊戲執行緒上通知。
+ * 規則數值與牌組取自 UCardCatalogSubsystem，與 ACardBattle 一致。
+ */
+UCLASS(Config = Game)
+class CARDGAME_API UBattleHostSubsystem : public UGameInstanceSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// 從任意 WorldContext 取得主機
+	static UBattleHostSubsystem* Get(const UObject* WorldContextObject);
+
+	// 建立一場對戰 (Seed 為 0 時自動產生)；BotSeatMask 中的座位由主機隨機出牌
+	FBattleMatchHandle CreateMatch(int32 Seed = 0, uint8 BotSeatMask = 0);
+
+	// 刪除對戰
+	void DestroyMatch(FBattleMatchHandle Handle);
+
+	// 排入出牌指令 (網路層或其他來源)，在下一次 Tick 執行
+	bool SubmitAction(FBattleMatchHandle Handle, const FBattleAction& Action);
+
+	// 取得對戰狀態 (控制代碼失效時回傳 nullptr)
+	const FBattleHostedMatch* FindMatch(FBattleMatchHandle Handle) const { return Host.FindMatch(Handle); }
+
+	int32 GetNumActiveMatches() const { return Host.GetNumActiveMatches(); }
+
+	// 對戰結束時通知 (遊戲執行緒；處理完畢後由呼叫端決定是否 DestroyMatch)
+	FOnHostedMatchFinished& OnMatchFinished() { return MatchFinishedEvent; }
+
+	// 以目前的卡牌資料執行主機效能測試
+	void RunBenchmark(int32 NumMatches, int32 Seed) const;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual ETickableTickType GetTickableTickType() const override { return ETickableTickType::Conditional; }
+
+private:
+	// 從卡牌 Catalog 重新設定規則
+	void ConfigureFromCatalog();
+
+	// 每回合的時間限制 (秒)
+	UPROPERTY(Config)
+	float TurnTimeLimit = 5.0f;
+
+	// 每個工作項目處理的對戰數
+	UPROPERTY(Config)
+	int32 MatchesPerTask = 256;
+
+	FBattleMatchHost Host;
+
+	// 每次 Tick 結束的對戰 (重複使用)
+	TArray<FBattleMatchHandle> FinishedMatches;
+
+	FOnHostedMatchFinished MatchFinishedEvent;
+
+	FDelegateHandle CatalogChangedHandle;
+
+	bool bInitialized = false;
+};
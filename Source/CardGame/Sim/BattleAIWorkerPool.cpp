@@ -0,0 +1,208 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Sim/BattleAIWorkerPool.h"
+#include "CardGame.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+#include "Tasks/Task.h"
+
+static TAutoConsoleVariable<int32> CVarBattleAIMaxWorkers(
+	TEXT("CardGame.AI.MaxWorkers"),
+	0,
+	TEXT("Maximum number of background workers running AI searches for all matches (0 = half of the task graph workers)."));
+
+static TAutoConsoleVariable<float> CVarBattleAISliceMs(
+	TEXT("CardGame.AI.SliceMs"),
+	1.0f,
+	TEXT("Length of one AI search time slice in milliseconds."));
+
+namespace BattleAIWorkerPool
+{
+	// 每次檢查時間之間的迭代數
+	static constexpr int32 IterationsPerCheck = 32;
+}
+
+FBattleAIJob::FBattleAIJob(const FBattleSimCore& Game, TConstArrayView<FCard> DeckCards, int32 Seed, double BudgetSeconds, int64 InMaxIterations)
+	: bDone(false)
+	, bCancelled(false)
+{
+	Restart(Game, DeckCards, Seed, BudgetSeconds, InMaxIterations);
+}
+
+void FBattleAIJob::Restart(const FBattleSimCore& Game, TConstArrayView<FCard> DeckCards, int32 Seed, double BudgetSeconds, int64 InMaxIterations)
+{
+	SubmitTime = FPlatformTime::Seconds();
+	Deadline = SubmitTime + BudgetSeconds;
+	MaxIterations = FMath::Max<int64>(InMaxIterations, 1);
+	Result = FBattleAIJobResult();
+	bDone.store(false, std::memory_order_relaxed);
+	bCancelled.store(false, std::memory_order_relaxed);
+
+	Search.Reset(Game, DeckCards, Seed);
+}
+
+bool FBattleAIJob::RunSlice(double SliceSeconds)
+{
+	CARDGAME_SCOPE_CYCLE_COUNTER(AISlice);
+
+	const double SliceEnd = FMath::Min(FPlatformTime::Seconds() + SliceSeconds, Deadline);
+
+	bool bFinished = false;
+	while (!bFinished)
+	{
+		Search.RunIterations(BattleAIWorkerPool::IterationsPerCheck);
+
+		const double Now = FPlatformTime::Seconds();
+		bFinished = Now >= Deadline || Search.GetNumIterations() >= MaxIterations || bCancelled.load(std::memory_order_relaxed);
+		if (Now >= SliceEnd)
+		{
+			break;
+		}
+	}
+
+	++Result.NumSlices;
+
+	if (bFinished)
+	{
+		Result.CardValue = Search.GetBestCard();
+		Result.WinRate = Search.GetBestWinRate();
+		Result.Iterations = Search.GetNumIterations();
+		Result.MaxDepth = Search.GetMaxDepth();
+		Result.ElapsedSeconds = FPlatformTime::Seconds() - SubmitTime;
+		bDone.store(true, std::memory_order_release);
+	}
+
+	return bFinished;
+}
+
+FBattleAIWorkerPool& FBattleAIWorkerPool::Get()
+{
+	static FBattleAIWorkerPool Pool;
+	return Pool;
+}
+
+int32 FBattleAIWorkerPool::GetMaxWorkers()
+{
+	const int32 Configured = CVarBattleAIMaxWorkers.GetValueOnAnyThread();
+	if (Configured > 0)
+	{
+		return Configured;
+	}
+
+	return FMath::Max(1, FTaskGraphInterface::Get().GetNumWorkerThreads() / 2);
+}
+
+void FBattleAIWorkerPool::Submit(const TSharedRef<FBattleAIJob, ESPMode::ThreadSafe>& Job)
+{
+	bool bLaunchWorker = false;
+	{
+		FScopeLock Lock(&QueueLock);
+		Queue.Add(Job);
+
+		if (NumActiveWorkers < GetMaxWorkers())
+		{
+			++NumActiveWorkers;
+			bLaunchWorker = true;
+		}
+	}
+
+	if (bLaunchWorker)
+	{
+		UE::Tasks::Launch(UE_SOURCE_LOCATION, [this]() { Pump(); }, LowLevelTasks::ETaskPriority::BackgroundNormal);
+	}
+}
+
+void FBattleAIWorkerPool::Pump()
+{
+	const double SliceSeconds = FMath::Max(CVarBattleAISliceMs.GetValueOnAnyThread(), 0.05f) / 1000.0;
+
+	for (;;)
+	{
+		TSharedPtr<FBattleAIJob, ESPMode::ThreadSafe> Job;
+		{
+			FScopeLock Lock(&QueueLock);
+			if (Queue.Num() == 0)
+			{
+				--NumActiveWorkers;
+				return;
+			}
+
+			Job = Queue[0];
+			Queue.RemoveAt(0, 1, EAllowShrinking::No);
+		}
+
+		// 沒做完的搜尋排回佇列尾端，讓其他對戰先執行
+		if (!Job->RunSlice(SliceSeconds))
+		{
+			FScopeLock Lock(&QueueLock);
+			Queue.Add(MoveTemp(Job));
+		}
+	}
+}
+
+void FBattleAIWorkerPool::RunBenchmark(const FBattleSimCore& Prototype, TConstArrayView<FCard> DeckCards, int32 NumJobs, double BudgetSeconds, int32 Seed)
+{
+	NumJobs = FMath::Max(1, NumJobs);
+
+	TArray<FCard> DefaultDeck;
+	if (DeckCards.Num() == 0)
+	{
+		FBattleSimCore::GetDefaultDeck(DefaultDeck);
+		DeckCards = DefaultDeck;
+	}
+
+	FRandomStream Random(Seed);
+	FBattleSimCore Game = Prototype;
+
+	TArray<TSharedRef<FBattleAIJob, ESPMode::ThreadSafe>> Jobs;
+	Jobs.Reserve(NumJobs);
+
+	const double StartTime = FPlatformTime::Seconds();
+	for (int32 JobIndex = 0; JobIndex < NumJobs; ++JobIndex)
+	{
+		Game.Reset();
+		Game.DealHands(DeckCards, Random);
+		Game.Start(Random.RandRange(0, 1));
+
+		TSharedRef<FBattleAIJob, ESPMode::ThreadSafe> Job = MakeShared<FBattleAIJob, ESPMode::ThreadSafe>(Game, DeckCards, (int32)Random.GetUnsignedInt(), BudgetSeconds, MAX_int64);
+		Get().Submit(Job);
+		Jobs.Add(Job);
+	}
+
+	for (const TSharedRef<FBattleAIJob, ESPMode::ThreadSafe>& Job : Jobs)
+	{
+		while (!Job->IsDone())
+		{
+			FPlatformProcess::Sleep(0.001f);
+		}
+	}
+	const double WallSeconds = FPlatformTime::Seconds() - StartTime;
+
+	int64 TotalIterations = 0;
+	int64 MinIterations = MAX_int64;
+	double MaxLatency = 0.0;
+	int32 MaxDepth = 0;
+	for (const TSharedRef<FBattleAIJob, ESPMode::ThreadSafe>& Job : Jobs)
+	{
+		const FBattleAIJobResult& Result = Job->GetResult();
+		TotalIterations += Result.Iterations;
+		MinIterations = FMath::Min(MinIterations, Result.Iterations);
+		MaxLatency = FMath::Max(MaxLatency, Result.ElapsedSeconds);
+		MaxDepth = FMath::Max(MaxDepth, Result.MaxDepth);
+	}
+
+	const int32 NumWorkers = FMath::Min(GetMaxWorkers(), NumJobs);
+	const double PlayoutsPerSecond = (double)TotalIterations / FMath::Max(WallSeconds, 1e-9);
+
+	UE_LOG(LogTemp, Display, TEXT("========== ISMCTS POOL BENCHMARK =========="));
+	UE_LOG(LogTemp, Display, TEXT("Concurrent searches: %d, budget %.1f ms, %d workers, slice %.2f ms"),
+		NumJobs, BudgetSeconds * 1000.0, NumWorkers, CVarBattleAISliceMs.GetValueOnAnyThread());
+	UE_LOG(LogTemp, Display, TEXT("Playouts: %lld in %.3f s (%.0f playouts/s, %.0f playouts/s per core)"),
+		TotalIterations, WallSeconds, PlayoutsPerSecond, PlayoutsPerSecond / FMath::Max(NumWorkers, 1));
+	UE_LOG(LogTemp, Display, TEXT("Per search: %.0f playouts avg, %lld min, max tree depth %d, worst latency %.3f ms"),
+		(double)TotalIterations / NumJobs, MinIterations, MaxDepth, MaxLatency * 1000.0);
+	UE_LOG(LogTemp, Display, TEXT("==========================================="));
+}
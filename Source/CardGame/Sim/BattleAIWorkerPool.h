@@ -0,0 +1,96 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Card.h"
+#include "Sim/BattleISMCTS.h"
+#include <atomic>
+
+/**
+ * FBattleAIJobResult - 一次 AI 搜尋的結果
+ */
+struct FBattleAIJobResult
+{
+	// 選擇打出的卡牌數值 (0 表示沒有結果)
+	int32 CardValue = 0;
+
+	// 該出牌的估計勝率
+	float WinRate = 0.0f;
+
+	int64 Iterations = 0;
+	int32 MaxDepth = 0;
+
+	// 分到的時間片數
+	int32 NumSlices = 0;
+
+	// 從提交到完成的時間 (含排隊)
+	double ElapsedSeconds = 0.0;
+};
+
+/**
+ * FBattleAIJob - 提交給共用工作池的一次 ISMCTS 搜尋
+ * 預算從提交時開始計時 (排隊也算在內)，對戰越多每個搜尋分到的迭代越少，但延遲上限不變。
+ */
+class CARDGAME_API FBattleAIJob
+{
+public:
+	FBattleAIJob(const FBattleSimCore& Game, TConstArrayView<FCard> DeckCards, int32 Seed, double BudgetSeconds, int64 MaxIterations);
+
+	// 以新的局面重新開始 (沿用搜尋樹的記憶體)；只能在工作不在佇列中時呼叫
+	void Restart(const FBattleSimCore& Game, TConstArrayView<FCard> DeckCards, int32 Seed, double BudgetSeconds, int64 MaxIterations);
+
+	// 是否已完成 (完成後才能讀取結果)
+	bool IsDone() const { return bDone.load(std::memory_order_acquire); }
+
+	// 要求盡快停止 (不等待)
+	void Cancel() { bCancelled.store(true, std::memory_order_relaxed); }
+
+	const FBattleAIJobResult& GetResult() const { return Result; }
+
+private:
+	friend class FBattleAIWorkerPool;
+
+	// 在工作執行緒上執行一個時間片，回傳是否已完成
+	bool RunSlice(double SliceSeconds);
+
+	FBattleISMCTS Search;
+
+	double SubmitTime;
+	double Deadline;
+	int64 MaxIterations;
+
+	FBattleAIJobResult Result;
+
+	std::atomic<bool> bDone;
+	std::atomic<bool> bCancelled;
+};
+
+/**
+ * FBattleAIWorkerPool - 所有對戰共用的 AI 工作池
+ * 最多同時使用 CardGame.AI.MaxWorkers 個背景工作 (UE::Tasks)，
+ * 搜尋以固定長度的時間片輪流執行 (先進先出)，每場對戰公平分到計算時間，
+ * 對戰數量增加時只會降低每次搜尋的深度，不會超過各自的時間預算，也不會佔滿所有核心。
+ */
+class CARDGAME_API FBattleAIWorkerPool
+{
+public:
+	static FBattleAIWorkerPool& Get();
+
+	// 提交搜尋 (立刻回傳)
+	void Submit(const TSharedRef<FBattleAIJob, ESPMode::ThreadSafe>& Job);
+
+	// 同時執行的工作上限
+	static int32 GetMaxWorkers();
+
+	// 以 NumJobs 個同時進行的開局搜尋量測吞吐量 (會等待所有搜尋完成，只用於測試)
+	static void RunBenchmark(const FBattleSimCore& Prototype, TConstArrayView<FCard> DeckCards, int32 NumJobs, double BudgetSeconds, int32 Seed);
+
+private:
+	// 工作迴圈：輪流取出搜尋執行一個時間片，佇列清空時結束
+	void Pump();
+
+	FCriticalSection QueueLock;
+	TArray<TSharedPtr<FBattleAIJob, ESPMode::ThreadSafe>> Queue;
+	int32 NumActiveWorkers = 0;
+};
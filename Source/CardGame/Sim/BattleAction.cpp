@@ -0,0 +1,38 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Sim/BattleAction.h"
+
+FCard FBattleActionExecutor::Apply(FBattleSimCore& Game, const FBattleAction& Action, FRandomStream& Random)
+{
+	if (!Game.IsWaitingForPlay() || Game.GetCurrentTurnPlayerId() != Action.PlayerId)
+	{
+		return FCard(0);
+	}
+
+	switch (Action.Type)
+	{
+	case EBattleActionType::PlayCard:
+		return Game.PlayCardByValue(Action.PlayerId, Action.CardValue);
+
+	case EBattleActionType::PlayRandom:
+		return Game.PlayRandomCard(Random);
+	}
+
+	return FCard(0);
+}
+
+int32 FBattleActionExecutor::Execute(FBattleSimCore& Game, TConstArrayView<FBattleAction> Actions, FRandomStream& Random, TArray<FBattleActionResult>& OutResults)
+{
+	OutResults.Reserve(OutResults.Num() + Actions.Num());
+
+	int32 NumAccepted = 0;
+	for (const FBattleAction& Action : Actions)
+	{
+		FBattleActionResult& Result = OutResults.AddDefaulted_GetRef();
+		Result.Action = Action;
+		Result.PlayedCard = Apply(Game, Action, Random);
+		NumAccepted += Result.IsAccepted() ? 1 : 0;
+	}
+
+	return NumAccepted;
+}
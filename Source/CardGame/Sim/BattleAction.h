@@ -0,0 +1,79 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Card.h"
+#include "Sim/BattleSimCore.h"
+
+// 出牌指令的來源 (只用於記錄與事件，不影響規則)
+enum class EBattleActionSource : uint8
+{
+	Input,		// 本機玩家輸入
+	AI,			// AI 玩家
+	Timeout,	// 回合逾時由系統代打
+	Network,	// 網路層轉送
+};
+
+// 出牌指令的種類
+enum class EBattleActionType : uint8
+{
+	PlayCard,	// 打出指定數值的牌
+	PlayRandom,	// 以對戰的亂數流隨機打出一張
+};
+
+/**
+ * FBattleAction - 一個出牌指令
+ * 以卡牌數值 (而非手牌索引) 指定要打的牌，排隊期間手牌變動也不會打錯牌，
+ * 也可以原樣由網路傳送。
+ */
+struct FBattleAction
+{
+	EBattleActionType Type = EBattleActionType::PlayCard;
+	EBattleActionSource Source = EBattleActionSource::Input;
+	uint8 PlayerId = 0;
+	uint8 CardValue = 0;
+
+	static FBattleAction MakePlayCard(int32 PlayerId, int32 CardValue, EBattleActionSource Source)
+	{
+		FBattleAction Action;
+		Action.Type = EBattleActionType::PlayCard;
+		Action.Source = Source;
+		Action.PlayerId = (uint8)PlayerId;
+		Action.CardValue = (uint8)FMath::Clamp(CardValue, 0, (int32)MAX_uint8);
+		return Action;
+	}
+
+	static FBattleAction MakePlayRandom(int32 PlayerId, EBattleActionSource Source)
+	{
+		FBattleAction Action;
+		Action.Type = EBattleActionType::PlayRandom;
+		Action.Source = Source;
+		Action.PlayerId = (uint8)PlayerId;
+		return Action;
+	}
+};
+
+// 指令執行結果 (PlayedCard 無效表示指令被拒絕)
+struct FBattleActionResult
+{
+	FBattleAction Action;
+	FCard PlayedCard;
+
+	bool IsAccepted() const { return PlayedCard.IsValid(); }
+};
+
+/**
+ * FBattleActionExecutor - 出牌指令的唯一執行者
+ * 玩家輸入、AI、逾時與網路的出牌都經由這裡進入規則核心，
+ * 檢查回合、取牌、加分、歷史記錄與回合切換只有這一份實作 (FBattleSimCore::CommitPlay)。
+ */
+struct CARDGAME_API FBattleActionExecutor
+{
+	// 執行單一指令，回傳打出的牌 (不是該玩家的回合或沒有該牌時回傳無效牌)
+	static FCard Apply(FBattleSimCore& Game, const FBattleAction& Action, FRandomStream& Random);
+
+	// 依序執行一批指令並把結果附加到 OutResults，回傳被接受的指令數
+	// 伺服器可以一次處理整個佇列，不經過任何事件或 UObject
+	static int32 Execute(FBattleSimCore& Game, TConstArrayView<FBattleAction> Actions, FRandomStream& Random, TArray<FBattleActionResult>& OutResults);
+};
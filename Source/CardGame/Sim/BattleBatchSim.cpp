@@ -0,0 +1,408 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Sim/BattleBatchSim.h"
+#include "Sim/BattleSimCore.h"
+#include "HAL/PlatformTime.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define CARDGAME_BATCHSIM_NEON 1
+#endif
+
+namespace BattleBatchSim
+{
+	static constexpr int32 NumLanes = FBattleBatchSim::LaneCount;
+	static constexpr int32 MaxDeckNum = FBattleSimCore::MaxCardValue;
+
+	// FRandomStream::MutateSeed 使用的常數
+	static constexpr uint32 RandomMultiplier = 196314165u;
+	static constexpr uint32 RandomIncrement = 907633515u;
+
+	// 一組同時推進的對戰 (每個欄位都是 LaneCount 道)
+	struct alignas(32) FLaneGroup
+	{
+		uint32 Seeds[NumLanes];
+		uint32 Hands[2][NumLanes];
+		int32 Scores[2][NumLanes];
+
+		// 先手是玩家 1 的 lane 為全 1，否則為 0
+		uint32 FirstIsPlayer1[NumLanes];
+	};
+
+	// 單道版本的 FRandomStream::RandHelper (Range 必須大於 0)
+	static FORCEINLINE int32 RandHelperLane(uint32& Seed, int32 Range)
+	{
+		Seed = Seed * RandomMultiplier + RandomIncrement;
+		const float Fraction = FPlatformMath::AsFloat(0x3F800000u | (Seed >> 9)) - 1.0f;
+		return FMath::Min(FMath::TruncToInt(Fraction * (float)Range), Range - 1);
+	}
+
+	// 每一道各自抽一個 [0, Range) 的亂數 (所有 lane 的 Range 相同)
+	static FORCEINLINE void DrawIndices(FLaneGroup& Group, int32 Range, int32* OutIndices)
+	{
+#if defined(__AVX2__)
+		__m256i Seeds = _mm256_load_si256((const __m256i*)Group.Seeds);
+		Seeds = _mm256_add_epi32(_mm256_mullo_epi32(Seeds, _mm256_set1_epi32((int32)RandomMultiplier)), _mm256_set1_epi32((int32)RandomIncrement));
+		_mm256_store_si256((__m256i*)Group.Seeds, Seeds);
+
+		// 尾數放進 [1, 2) 的浮點數再減 1 (與 GetFraction 相同)
+		const __m256i Bits = _mm256_or_si256(_mm256_srli_epi32(Seeds, 9), _mm256_set1_epi32(0x3F800000));
+		const __m256 Fraction = _mm256_sub_ps(_mm256_castsi256_ps(Bits), _mm256_set1_ps(1.0f));
+		const __m256i Indices = _mm256_cvttps_epi32(_mm256_mul_ps(Fraction, _mm256_set1_ps((float)Range)));
+		_mm256_store_si256((__m256i*)OutIndices, _mm256_min_epi32(Indices, _mm256_set1_epi32(Range - 1)));
+#elif defined(CARDGAME_BATCHSIM_NEON)
+		for (int32 Half = 0; Half < NumLanes; Half += 4)
+		{
+			uint32x4_t Seeds = vld1q_u32(Group.Seeds + Half);
+			Seeds = vmlaq_u32(vdupq_n_u32(RandomIncrement), Seeds, vdupq_n_u32(RandomMultiplier));
+			vst1q_u32(Group.Seeds + Half, Seeds);
+
+			const uint32x4_t Bits = vorrq_u32(vshrq_n_u32(Seeds, 9), vdupq_n_u32(0x3F800000u));
+			const float32x4_t Fraction = vsubq_f32(vreinterpretq_f32_u32(Bits), vdupq_n_f32(1.0f));
+			const int32x4_t Indices = vcvtq_s32_f32(vmulq_f32(Fraction, vdupq_n_f32((float)Range)));
+			vst1q_s32(OutIndices + Half, vminq_s32(Indices, vdupq_n_s32(Range - 1)));
+		}
+#else
+		for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+		{
+			OutIndices[Lane] = RandHelperLane(Group.Seeds[Lane], Range);
+		}
+#endif
+	}
+
+	// 發牌並決定先手 (與 FBattleSimCore::DealHands 與 Start(RandRange(0, 1)) 相同的亂數順序)
+	static void DealGroup(FLaneGroup& Group, const uint8* DeckValues, int32 DeckNum)
+	{
+		alignas(32) int32 Indices[NumLanes];
+		uint8 Decks[NumLanes][MaxDeckNum];
+		const int32 HandNum = FMath::Min(DeckNum, FBattleSimCore::HandSize);
+
+		for (int32 PlayerId = 0; PlayerId < 2; ++PlayerId)
+		{
+			for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+			{
+				FMemory::Memcpy(Decks[Lane], DeckValues, DeckNum);
+			}
+
+			// Fisher-Yates：亂數一次抽 LaneCount 道，交換逐道進行
+			for (int32 i = DeckNum - 1; i > 0; --i)
+			{
+				DrawIndices(Group, i + 1, Indices);
+				for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+				{
+					Swap(Decks[Lane][i], Decks[Lane][Indices[Lane]]);
+				}
+			}
+
+			for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+			{
+				uint32 Hand = 0;
+				for (int32 i = 0; i < HandNum; ++i)
+				{
+					Hand |= 1u << Decks[Lane][i];
+				}
+				Group.Hands[PlayerId][Lane] = Hand;
+				Group.Scores[PlayerId][Lane] = 0;
+			}
+		}
+
+		DrawIndices(Group, 2, Indices);
+		for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+		{
+			Group.FirstIsPlayer1[Lane] = Indices[Lane] != 0 ? ~0u : 0u;
+		}
+	}
+
+	// 所有 lane 同時打出一手：當前玩家隨機出排序後的第 N 張牌並立即加分
+	// Range 是當前玩家的手牌張數 (每道都相同)
+	static FORCEINLINE void PlayGroupMove(FLaneGroup& Group, int32 MoveIndex, int32 Range, const int32* Power)
+	{
+		alignas(32) int32 Indices[NumLanes];
+		DrawIndices(Group, Range, Indices);
+
+		// 雙方輪流出牌：第偶數手是先手玩家
+		const uint32 ParityMask = (MoveIndex & 1) != 0 ? ~0u : 0u;
+
+#if defined(__AVX2__)
+		const __m256i MoverIsPlayer1 = _mm256_xor_si256(_mm256_load_si256((const __m256i*)Group.FirstIsPlayer1), _mm256_set1_epi32((int32)ParityMask));
+		const __m256i One = _mm256_set1_epi32(1);
+		__m256i Hand0 = _mm256_load_si256((const __m256i*)Group.Hands[0]);
+		__m256i Hand1 = _mm256_load_si256((const __m256i*)Group.Hands[1]);
+		const __m256i Selected = _mm256_load_si256((const __m256i*)Indices);
+
+		// 清掉前 Index 個最低位元，剩下的最低位元就是第 Index 張牌
+		__m256i Remaining = _mm256_blendv_epi8(Hand0, Hand1, MoverIsPlayer1);
+		for (int32 k = 0; k < Range - 1; ++k)
+		{
+			const __m256i Active = _mm256_cmpgt_epi32(Selected, _mm256_set1_epi32(k));
+			Remaining = _mm256_blendv_epi8(Remaining, _mm256_and_si256(Remaining, _mm256_sub_epi32(Remaining, One)), Active);
+		}
+		const __m256i LowBit = _mm256_and_si256(Remaining, _mm256_sub_epi32(_mm256_setzero_si256(), Remaining));
+
+		// 2 的次方轉成浮點數後，指數就是位元位置 (CardValue)
+		__m256i CardValues = _mm256_sub_epi32(_mm256_srli_epi32(_mm256_castps_si256(_mm256_cvtepi32_ps(LowBit)), 23), _mm256_set1_epi32(127));
+		CardValues = _mm256_max_epi32(CardValues, _mm256_setzero_si256());
+		const __m256i Powers = _mm256_i32gather_epi32(Power, CardValues, 4);
+
+		Hand0 = _mm256_andnot_si256(_mm256_andnot_si256(MoverIsPlayer1, LowBit), Hand0);
+		Hand1 = _mm256_andnot_si256(_mm256_and_si256(MoverIsPlayer1, LowBit), Hand1);
+		_mm256_store_si256((__m256i*)Group.Hands[0], Hand0);
+		_mm256_store_si256((__m256i*)Group.Hands[1], Hand1);
+
+		const __m256i Score0 = _mm256_load_si256((const __m256i*)Group.Scores[0]);
+		const __m256i Score1 = _mm256_load_si256((const __m256i*)Group.Scores[1]);
+		_mm256_store_si256((__m256i*)Group.Scores[0], _mm256_add_epi32(Score0, _mm256_andnot_si256(MoverIsPlayer1, Powers)));
+		_mm256_store_si256((__m256i*)Group.Scores[1], _mm256_add_epi32(Score1, _mm256_and_si256(MoverIsPlayer1, Powers)));
+#elif defined(CARDGAME_BATCHSIM_NEON)
+		for (int32 Half = 0; Half < NumLanes; Half += 4)
+		{
+			const uint32x4_t MoverIsPlayer1 = veorq_u32(vld1q_u32(Group.FirstIsPlayer1 + Half), vdupq_n_u32(ParityMask));
+			const uint32x4_t One = vdupq_n_u32(1);
+			uint32x4_t Hand0 = vld1q_u32(Group.Hands[0] + Half);
+			uint32x4_t Hand1 = vld1q_u32(Group.Hands[1] + Half);
+			const int32x4_t Selected = vld1q_s32(Indices + Half);
+
+			uint32x4_t Remaining = vbslq_u32(MoverIsPlayer1, Hand1, Hand0);
+			for (int32 k = 0; k < Range - 1; ++k)
+			{
+				const uint32x4_t Active = vcgtq_s32(Selected, vdupq_n_s32(k));
+				Remaining = vbslq_u32(Active, vandq_u32(Remaining, vsubq_u32(Remaining, One)), Remaining);
+			}
+			const uint32x4_t LowBit = vandq_u32(Remaining, vreinterpretq_u32_s32(vnegq_s32(vreinterpretq_s32_u32(Remaining))));
+
+			// NEON 沒有 gather，CardValue 以 clz 求出後逐道查表
+			const uint32x4_t CardValues = vsubq_u32(vdupq_n_u32(31), vreinterpretq_u32_s32(vclzq_s32(vreinterpretq_s32_u32(LowBit))));
+			alignas(16) uint32 CardValueLanes[4];
+			alignas(16) int32 PowerLanes[4];
+			vst1q_u32(CardValueLanes, CardValues);
+			for (int32 Lane = 0; Lane < 4; ++Lane)
+			{
+				PowerLanes[Lane] = Power[FMath::Min(CardValueLanes[Lane], (uint32)FCardPowerTable::InvalidIndex)];
+			}
+			const uint32x4_t Powers = vld1q_u32((const uint32*)PowerLanes);
+
+			vst1q_u32(Group.Hands[0] + Half, vbicq_u32(Hand0, vbicq_u32(LowBit, MoverIsPlayer1)));
+			vst1q_u32(Group.Hands[1] + Half, vbicq_u32(Hand1, vandq_u32(LowBit, MoverIsPlayer1)));
+
+			const uint32x4_t Score0 = vld1q_u32((const uint32*)Group.Scores[0] + Half);
+			const uint32x4_t Score1 = vld1q_u32((const uint32*)Group.Scores[1] + Half);
+			vst1q_u32((uint32*)Group.Scores[0] + Half, vaddq_u32(Score0, vbicq_u32(Powers, MoverIsPlayer1)));
+			vst1q_u32((uint32*)Group.Scores[1] + Half, vaddq_u32(Score1, vandq_u32(Powers, MoverIsPlayer1)));
+		}
+#else
+		for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+		{
+			const int32 PlayerId = (Group.FirstIsPlayer1[Lane] ^ ParityMask) != 0 ? 1 : 0;
+			uint32 Remaining = Group.Hands[PlayerId][Lane];
+			for (int32 k = 0; k < Indices[Lane]; ++k)
+			{
+				Remaining &= Remaining - 1u;
+			}
+			const uint32 LowBit = Remaining & (~Remaining + 1u);
+
+			Group.Hands[PlayerId][Lane] &= ~LowBit;
+			Group.Scores[PlayerId][Lane] += Power[FMath::Min((uint32)FMath::CountTrailingZeros(LowBit), (uint32)FCardPowerTable::InvalidIndex)];
+		}
+#endif
+	}
+
+	// 向量核心與 FRandomStream 的亂數是否一致 (FRandomStream 的實作改變時自動退回純量模擬)
+	static bool MatchesRandomStream()
+	{
+		static const bool bMatches = []()
+		{
+			FLaneGroup Group;
+			FRandomStream Streams[NumLanes];
+			for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+			{
+				const int32 Seed = Lane * 7919 - 12345;
+				Streams[Lane].Initialize(Seed);
+				Group.Seeds[Lane] = (uint32)Seed;
+			}
+
+			alignas(32) int32 Indices[NumLanes];
+			for (int32 Range = 1; Range <= MaxDeckNum; ++Range)
+			{
+				DrawIndices(Group, Range, Indices);
+				for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+				{
+					if (Indices[Lane] != Streams[Lane].RandRange(0, Range - 1))
+					{
+						return false;
+					}
+				}
+			}
+			return true;
+		}();
+
+		return bMatches;
+	}
+
+	// 將牌組整理成卡牌數值 (有重複或無效的牌時回傳 false)
+	static bool CompileDeck(TConstArrayView<FCard> DeckCards, uint8* OutValues, int32& OutNum)
+	{
+		OutNum = FMath::Min(DeckCards.Num(), MaxDeckNum);
+
+		uint32 Seen = 0;
+		for (int32 i = 0; i < OutNum; ++i)
+		{
+			const int32 CardValue = DeckCards[i].CardValue;
+			if (!DeckCards[i].IsValid() || (Seen & (1u << CardValue)) != 0)
+			{
+				return false;
+			}
+
+			Seen |= 1u << CardValue;
+			OutValues[i] = (uint8)CardValue;
+		}
+
+		return true;
+	}
+}
+
+void FBattleBatchSim::RunRandomGames(const FCardPowerTable& PowerTable, TConstArrayView<FCard> DeckCards, TConstArrayView<int32> Seeds, TArrayView<FBattleBatchGameResult> OutResults)
+{
+	using namespace BattleBatchSim;
+
+	check(Seeds.Num() == OutResults.Num());
+
+	TArray<FCard> DefaultDeck;
+	if (DeckCards.Num() == 0)
+	{
+		FBattleSimCore::GetDefaultDeck(DefaultDeck);
+		DeckCards = DefaultDeck;
+	}
+
+	// 重複的牌在 FCardHand 中只算一張，兩邊手牌張數可能不同，無法同步推進
+	uint8 DeckValues[MaxDeckNum];
+	int32 DeckNum = 0;
+	if (!CompileDeck(DeckCards, DeckValues, DeckNum) || !MatchesRandomStream())
+	{
+		RunRandomGamesScalar(PowerTable, DeckCards, Seeds, OutResults);
+		return;
+	}
+
+	// 直接以 CardValue 索引的 Power 表 (gather 使用)
+	alignas(32) int32 Power[FCardPowerTable::NumEntries];
+	for (int32 CardValue = 0; CardValue < FCardPowerTable::NumEntries; ++CardValue)
+	{
+		Power[CardValue] = PowerTable.GetPower(CardValue);
+	}
+
+	const int32 HandNum = FMath::Min(DeckNum, FBattleSimCore::HandSize);
+	FLaneGroup Group;
+
+	for (int32 First = 0; First < Seeds.Num(); First += NumLanes)
+	{
+		// 最後一組不足 LaneCount 局時重複最後一個種子補齊 (結果不寫回)
+		const int32 NumGames = FMath::Min(NumLanes, Seeds.Num() - First);
+		for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+		{
+			Group.Seeds[Lane] = (uint32)Seeds[First + FMath::Min(Lane, NumGames - 1)];
+		}
+
+		DealGroup(Group, DeckValues, DeckNum);
+
+		for (int32 MoveIndex = 0; MoveIndex < HandNum * 2; ++MoveIndex)
+		{
+			PlayGroupMove(Group, MoveIndex, HandNum - MoveIndex / 2, Power);
+		}
+
+		for (int32 Lane = 0; Lane < NumGames; ++Lane)
+		{
+			FBattleBatchGameResult& Result = OutResults[First + Lane];
+			Result.Scores[0] = Group.Scores[0][Lane];
+			Result.Scores[1] = Group.Scores[1][Lane];
+			Result.Winner = Result.Scores[0] > Result.Scores[1] ? 0 : (Result.Scores[1] > Result.Scores[0] ? 1 : -1);
+		}
+	}
+}
+
+void FBattleBatchSim::RunRandomGamesScalar(const FCardPowerTable& PowerTable, TConstArrayView<FCard> DeckCards, TConstArrayView<int32> Seeds, TArrayView<FBattleBatchGameResult> OutResults)
+{
+	check(Seeds.Num() == OutResults.Num());
+
+	TArray<FCard> DefaultDeck;
+	if (DeckCards.Num() == 0)
+	{
+		FBattleSimCore::GetDefaultDeck(DefaultDeck);
+		DeckCards = DefaultDeck;
+	}
+
+	FBattleSimCore Game;
+	Game.SetPowerTable(MakeShared<const FCardPowerTable, ESPMode::ThreadSafe>(PowerTable));
+
+	for (int32 GameIndex = 0; GameIndex < Seeds.Num(); ++GameIndex)
+	{
+		// 與 ACardBattle::StartGame 相同的亂數使用順序
+		FRandomStream Random(Seeds[GameIndex]);
+		Game.Reset();
+		Game.DealHands(DeckCards, Random);
+		Game.Start(Random.RandRange(0, 1));
+
+		FBattleBatchGameResult& Result = OutResults[GameIndex];
+		Result.Winner = Game.RunRandomGame(Random);
+		Result.Scores[0] = Game.GetScore(0);
+		Result.Scores[1] = Game.GetScore(1);
+	}
+}
+
+const TCHAR* FBattleBatchSim::GetKernelName()
+{
+#if defined(__AVX2__)
+	return TEXT("AVX2 x8");
+#elif defined(CARDGAME_BATCHSIM_NEON)
+	return TEXT("NEON 2x4");
+#else
+	return TEXT("Scalar x8");
+#endif
+}
+
+void FBattleBatchSim::RunBenchmark(const FCardPowerTable& PowerTable, TConstArrayView<FCard> DeckCards, int32 NumGames, int32 Seed)
+{
+	NumGames = FMath::Max(NumGames, 1);
+
+	TArray<int32> Seeds;
+	Seeds.SetNumUninitialized(NumGames);
+	FRandomStream SeedStream(Seed);
+	for (int32& GameSeed : Seeds)
+	{
+		GameSeed = (int32)SeedStream.GetUnsignedInt();
+	}
+
+	TArray<FBattleBatchGameResult> ScalarResults;
+	TArray<FBattleBatchGameResult> BatchResults;
+	ScalarResults.SetNum(NumGames);
+	BatchResults.SetNum(NumGames);
+
+	const double ScalarStart = FPlatformTime::Seconds();
+	RunRandomGamesScalar(PowerTable, DeckCards, Seeds, ScalarResults);
+	const double ScalarSeconds = FPlatformTime::Seconds() - ScalarStart;
+
+	const double BatchStart = FPlatformTime::Seconds();
+	RunRandomGames(PowerTable, DeckCards, Seeds, BatchResults);
+	const double BatchSeconds = FPlatformTime::Seconds() - BatchStart;
+
+	int32 NumMismatches = 0;
+	int32 Wins[3] = { 0, 0, 0 };
+	for (int32 GameIndex = 0; GameIndex < NumGames; ++GameIndex)
+	{
+		NumMismatches += ScalarResults[GameIndex] == BatchResults[GameIndex] ? 0 : 1;
+		++Wins[BatchResults[GameIndex].Winner + 1];
+	}
+
+	const double ScalarRate = ScalarSeconds > 0.0 ? (double)NumGames / ScalarSeconds : 0.0;
+	const double BatchRate = BatchSeconds > 0.0 ? (double)NumGames / BatchSeconds : 0.0;
+
+	UE_LOG(LogTemp, Display, TEXT("========== BATCH SIM BENCHMARK =========="));
+	UE_LOG(LogTemp, Display, TEXT("Games: %d, Seed: %d, Kernel: %s, Vector path: %s"),
+		NumGames, Seed, GetKernelName(), BattleBatchSim::MatchesRandomStream() ? TEXT("yes") : TEXT("no (FRandomStream mismatch)"));
+	UE_LOG(LogTemp, Display, TEXT("Scalar (FBattleSimCore): %.3f s (%.0f games/s)"), ScalarSeconds, ScalarRate);
+	UE_LOG(LogTemp, Display, TEXT("Batch (SoA lockstep):    %.3f s (%.0f games/s)"), BatchSeconds, BatchRate);
+	UE_LOG(LogTemp, Display, TEXT("Speedup: %.2fx"), ScalarRate > 0.0 ? BatchRate / ScalarRate : 0.0);
+	UE_LOG(LogTemp, Display, TEXT("Player0 wins: %d, Player1 wins: %d, Draws: %d"), Wins[1], Wins[2], Wins[0]);
+	UE_LOG(LogTemp, Display, TEXT("Mismatches vs scalar: %d"), NumMismatches);
+	UE_LOG(LogTemp, Display, TEXT("========================================="));
+}
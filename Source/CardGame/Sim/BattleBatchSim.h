@@ -0,0 +1,50 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Card.h"
+#include "Sim/CardPowerTable.h"
+
+/**
+ * FBattleBatchGameResult - 批次模擬中一局的結果
+ */
+struct FBattleBatchGameResult
+{
+	int32 Scores[2] = { 0, 0 };
+
+	// 獲勝者 (-1 表示平手)
+	int32 Winner = -1;
+
+	bool operator==(const FBattleBatchGameResult& Other) const
+	{
+		return Scores[0] == Other.Scores[0] && Scores[1] == Other.Scores[1] && Winner == Other.Winner;
+	}
+};
+
+/**
+ * FBattleBatchSim - 以 SoA 排列同時推進 LaneCount 局隨機對戰的批次模擬器
+ * 每局等同於 ACardBattle 的隨機出牌流程 (也就是 FBattleSimCore 的 DealHands、Start(RandRange(0, 1))、RunRandomGame)：
+ * 每一道 (lane) 有自己的 FRandomStream 狀態，結果與逐局的純量模擬完全相同。
+ * 雙方手牌張數相同且嚴格輪流出牌，所有 lane 每一手的手牌張數都一樣，可以完全同步推進。
+ * 亂數、選第 N 張牌、Power 查表與加分使用 AVX2 (8 道) 或 NEON (2 x 4 道) 核心，其他平台使用純量迴圈；
+ * 洗牌的交換仍然逐道進行 (只有亂數是向量化的)。
+ */
+struct CARDGAME_API FBattleBatchSim
+{
+	// 同時推進的局數
+	static constexpr int32 LaneCount = 8;
+
+	// 以每局的種子模擬隨機對戰 (OutResults 與 Seeds 等長)
+	// DeckCards 必須是不重複的有效卡牌，否則改用純量模擬；為空時使用 1-30
+	static void RunRandomGames(const FCardPowerTable& PowerTable, TConstArrayView<FCard> DeckCards, TConstArrayView<int32> Seeds, TArrayView<FBattleBatchGameResult> OutResults);
+
+	// 以 FBattleSimCore 逐局模擬 (對照用)
+	static void RunRandomGamesScalar(const FCardPowerTable& PowerTable, TConstArrayView<FCard> DeckCards, TConstArrayView<int32> Seeds, TArrayView<FBattleBatchGameResult> OutResults);
+
+	// 目前使用的向量核心名稱
+	static const TCHAR* GetKernelName();
+
+	// 比較批次與純量模擬的速度與結果，並輸出到日誌
+	static void RunBenchmark(const FCardPowerTable& PowerTable, TConstArrayView<FCard> DeckCards, int32 NumGames, int32 Seed);
+};
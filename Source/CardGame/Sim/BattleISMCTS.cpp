@@ -0,0 +1,224 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Sim/BattleISMCTS.h"
+
+FBattleISMCTS::FBattleISMCTS()
+	: RootPlayerId(0)
+	, UnseenBits(0)
+	, OpponentHandNum(0)
+	, NumIterations(0)
+	, MaxDepth(0)
+{
+}
+
+void FBattleISMCTS::Reset(const FBattleSimCore& Game, TConstArrayView<FCard> DeckCards, int32 Seed)
+{
+	RootGame = Game;
+	RootPlayerId = Game.GetCurrentTurnPlayerId();
+	const int32 OpponentId = 1 - RootPlayerId;
+
+	// 對手的牌組是另一副，只扣掉對手自己已打出的牌
+	FCardHand DeckHand;
+	if (DeckCards.Num() > 0)
+	{
+		for (const FCard& Card : DeckCards)
+		{
+			DeckHand.Add(Card.CardValue);
+		}
+	}
+	else
+	{
+		for (int32 CardValue = 1; CardValue <= FBattleSimCore::MaxCardValue; ++CardValue)
+		{
+			DeckHand.Add(CardValue);
+		}
+	}
+
+	UnseenBits = DeckHand.GetBits();
+	for (const FCard& Card : Game.GetPlayedCards(OpponentId))
+	{
+		UnseenBits &= ~(1u << Card.CardValue);
+	}
+
+	OpponentHandNum = Game.GetHandNum(OpponentId);
+	RootGame.SetHand(OpponentId, TConstArrayView<FCard>());
+
+	Nodes.Reset();
+	Nodes.AddDefaulted();
+	Nodes[0].PlayerId = (uint8)OpponentId;
+
+	Random.Initialize(Seed);
+	NumIterations = 0;
+	MaxDepth = 0;
+}
+
+uint32 FBattleISMCTS::SampleOpponentHand()
+{
+	uint8 Candidates[32];
+	int32 NumCandidates = 0;
+	for (uint32 Remaining = UnseenBits; Remaining != 0; Remaining &= Remaining - 1u)
+	{
+		Candidates[NumCandidates++] = (uint8)FMath::CountTrailingZeros(Remaining);
+	}
+
+	// 部分 Fisher-Yates：只洗出需要的張數
+	const int32 NumToDraw = FMath::Min(OpponentHandNum, NumCandidates);
+	uint32 Hand = 0;
+	for (int32 i = 0; i < NumToDraw; ++i)
+	{
+		const int32 Pick = Random.RandRange(i, NumCandidates - 1);
+		Swap(Candidates[i], Candidates[Pick]);
+		Hand |= 1u << Candidates[i];
+	}
+	return Hand;
+}
+
+void FBattleISMCTS::RunIterations(int32 NumIterationsToRun)
+{
+	if (!RootGame.IsWaitingForPlay())
+	{
+		return;
+	}
+
+	const int32 OpponentId = 1 - RootPlayerId;
+	FCard OpponentCards[FBattleSimCore::HandSize];
+
+	for (int32 Iteration = 0; Iteration < NumIterationsToRun; ++Iteration)
+	{
+		// 確定化：為對手抽一組手牌
+		FBattleSimCore Game = RootGame;
+		FCardHand OpponentHand;
+		const uint32 OpponentBits = SampleOpponentHand();
+		for (uint32 Remaining = OpponentBits; Remaining != 0; Remaining &= Remaining - 1u)
+		{
+			OpponentHand.Add((int32)FMath::CountTrailingZeros(Remaining));
+		}
+		const int32 NumOpponentCards = OpponentHand.CopyTo(OpponentCards);
+		Game.SetHand(OpponentId, TConstArrayView<FCard>(OpponentCards, NumOpponentCards));
+
+		// 選擇與展開
+		int32 NodeIndex = 0;
+		Path.Reset();
+		Path.Add(NodeIndex);
+
+		while (Game.IsWaitingForPlay())
+		{
+			const int32 MoverId = Game.GetCurrentTurnPlayerId();
+			const uint32 LegalBits = Game.GetHand(MoverId).GetBits();
+			if (LegalBits == 0)
+			{
+				break;
+			}
+
+			// 已有子節點的出牌，並更新在這個確定化下可用的子節點
+			uint32 TriedBits = 0;
+			for (int32 Child = Nodes[NodeIndex].FirstChild; Child != INDEX_NONE; Child = Nodes[Child].NextSibling)
+			{
+				const uint32 CardBit = 1u << Nodes[Child].CardValue;
+				TriedBits |= CardBit;
+				if (LegalBits & CardBit)
+				{
+					Nodes[Child].Availability++;
+				}
+			}
+
+			const uint32 UntriedBits = LegalBits & ~TriedBits;
+			if (UntriedBits != 0 && Nodes.Num() < MaxNodes)
+			{
+				// 展開一個還沒試過的出牌
+				uint8 Untried[32];
+				int32 NumUntried = 0;
+				for (uint32 Remaining = UntriedBits; Remaining != 0; Remaining &= Remaining - 1u)
+				{
+					Untried[NumUntried++] = (uint8)FMath::CountTrailingZeros(Remaining);
+				}
+				const uint8 CardValue = Untried[Random.RandRange(0, NumUntried - 1)];
+
+				const int32 NewIndex = Nodes.AddDefaulted();
+				FNode& NewNode = Nodes[NewIndex];
+				NewNode.PlayerId = (uint8)MoverId;
+				NewNode.CardValue = CardValue;
+				NewNode.Availability = 1;
+				NewNode.NextSibling = Nodes[NodeIndex].FirstChild;
+				Nodes[NodeIndex].FirstChild = NewIndex;
+
+				Game.PlayCardByValue(MoverId, CardValue);
+				NodeIndex = NewIndex;
+				Path.Add(NodeIndex);
+				break;
+			}
+
+			// 所有合法出牌都展開過：以 UCB (可用次數) 選擇
+			int32 BestChild = INDEX_NONE;
+			float BestScore = -MAX_flt;
+			for (int32 Child = Nodes[NodeIndex].FirstChild; Child != INDEX_NONE; Child = Nodes[Child].NextSibling)
+			{
+				const FNode& ChildNode = Nodes[Child];
+				if ((LegalBits & (1u << ChildNode.CardValue)) == 0 || ChildNode.Visits == 0)
+				{
+					continue;
+				}
+
+				const float Exploit = ChildNode.Reward / (float)ChildNode.Visits;
+				const float Explore = ExplorationConstant * FMath::Sqrt(FMath::Loge((float)ChildNode.Availability) / (float)ChildNode.Visits);
+				if (Exploit + Explore > BestScore)
+				{
+					BestScore = Exploit + Explore;
+					BestChild = Child;
+				}
+			}
+
+			if (BestChild == INDEX_NONE)
+			{
+				// 節點已達上限且沒有可用的子節點，直接隨機對局
+				break;
+			}
+
+			Game.PlayCardByValue(MoverId, Nodes[BestChild].CardValue);
+			NodeIndex = BestChild;
+			Path.Add(NodeIndex);
+		}
+
+		MaxDepth = FMath::Max(MaxDepth, Path.Num() - 1);
+
+		// 隨機對局到結束
+		const int32 Winner = Game.RunRandomGame(Random);
+
+		// 反向傳播：每個節點記錄對「打出該牌的玩家」而言的勝負
+		for (const int32 PathIndex : Path)
+		{
+			FNode& Node = Nodes[PathIndex];
+			Node.Visits++;
+			Node.Reward += Winner == Node.PlayerId ? 1.0f : (Winner < 0 ? 0.5f : 0.0f);
+		}
+
+		++NumIterations;
+	}
+}
+
+int32 FBattleISMCTS::FindBestRootChild() const
+{
+	int32 BestChild = INDEX_NONE;
+	uint32 BestVisits = 0;
+	for (int32 Child = Nodes.Num() > 0 ? Nodes[0].FirstChild : INDEX_NONE; Child != INDEX_NONE; Child = Nodes[Child].NextSibling)
+	{
+		if (BestChild == INDEX_NONE || Nodes[Child].Visits > BestVisits)
+		{
+			BestChild = Child;
+			BestVisits = Nodes[Child].Visits;
+		}
+	}
+	return BestChild;
+}
+
+int32 FBattleISMCTS::GetBestCard() const
+{
+	const int32 BestChild = FindBestRootChild();
+	return BestChild != INDEX_NONE ? Nodes[BestChild].CardValue : 0;
+}
+
+float FBattleISMCTS::GetBestWinRate() const
+{
+	const int32 BestChild = FindBestRootChild();
+	return (BestChild != INDEX_NONE && Nodes[BestChild].Visits > 0) ? Nodes[BestChild].Reward / (float)Nodes[BestChild].Visits : 0.0f;
+}
@@ -0,0 +1,85 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Card.h"
+#include "Sim/BattleSimCore.h"
+
+/**
+ * FBattleISMCTS - 資訊集 Monte Carlo 樹搜尋 (SO-ISMCTS)
+ * 只使用搜尋方看得到的資訊：自己的手牌、雙方已出的牌與對手的手牌張數。
+ * 每次迭代從對手可能持有的牌 (牌組扣掉對手已出的牌；雙方各有一副牌組) 隨機抽出一組手牌，
+ * 在這個確定化的局面上沿著共用的樹選擇、展開，再以隨機出牌跑完整局並回傳勝負。
+ * 樹的節點以出牌的卡牌數值區分，子節點以「可用次數」修正 UCB，
+ * 所以不同確定化之下不合法的出牌不會被過度探索。
+ * 不是執行緒安全的；同一時間只能有一條執行緒呼叫 RunIterations。
+ */
+class CARDGAME_API FBattleISMCTS
+{
+public:
+	FBattleISMCTS();
+
+	// 從當前局面開始新的搜尋 (搜尋方為當前回合的玩家；不會讀取對手的手牌內容)
+	// DeckCards 為空時使用 1-30
+	void Reset(const FBattleSimCore& Game, TConstArrayView<FCard> DeckCards, int32 Seed);
+
+	// 執行 NumIterations 次迭代 (每次一個確定化與一次隨機對局)
+	void RunIterations(int32 NumIterations);
+
+	// 訪問次數最多的出牌 (還沒有任何迭代時回傳 0)
+	int32 GetBestCard() const;
+
+	// 該出牌的平均勝率 (平手算 0.5)
+	float GetBestWinRate() const;
+
+	int64 GetNumIterations() const { return NumIterations; }
+	int32 GetNumNodes() const { return Nodes.Num(); }
+	int32 GetMaxDepth() const { return MaxDepth; }
+
+	// UCB 探索係數
+	float ExplorationConstant = 0.7f;
+
+	// 樹的節點上限 (超過後只做隨機對局，不再展開)
+	int32 MaxNodes = 100000;
+
+private:
+	struct FNode
+	{
+		int32 FirstChild = INDEX_NONE;
+		int32 NextSibling = INDEX_NONE;
+
+		// 打出這張牌進入此節點的玩家與卡牌
+		uint8 PlayerId = 0;
+		uint8 CardValue = 0;
+
+		uint32 Visits = 0;
+		uint32 Availability = 0;
+
+		// 對 PlayerId 而言的累計勝利 (平手 0.5)
+		float Reward = 0.0f;
+	};
+
+	// 為對手抽出一組可能的手牌
+	uint32 SampleOpponentHand();
+
+	int32 FindBestRootChild() const;
+
+	// 搜尋方看到的局面 (對手手牌已清空)
+	FBattleSimCore RootGame;
+
+	int32 RootPlayerId;
+
+	// 對手可能持有的牌與張數
+	uint32 UnseenBits;
+	int32 OpponentHandNum;
+
+	TArray<FNode> Nodes;
+
+	// 每次迭代走過的節點 (重複使用)
+	TArray<int32, TInlineAllocator<FBattleSimCore::HandSize * 2 + 1>> Path;
+
+	FRandomStream Random;
+	int64 NumIterations;
+	int32 MaxDepth;
+};
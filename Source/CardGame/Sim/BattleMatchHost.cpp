@@ -0,0 +1,256 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Sim/BattleMatchHost.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/PlatformTime.h"
+#include <atomic>
+
+FBattleMatchHost::FBattleMatchHost()
+	: TurnTimeLimit(5.0f)
+	, NumActiveMatches(0)
+{
+	FBattleSimCore::GetDefaultDeck(DeckCards);
+}
+
+void FBattleMatchHost::Configure(const FBattleSimCore& InPrototype, TConstArrayView<FCard> InDeckCards, float InTurnTimeLimit)
+{
+	Prototype = InPrototype;
+	Prototype.Reset();
+	TurnTimeLimit = InTurnTimeLimit;
+
+	DeckCards.Reset();
+	if (InDeckCards.Num() > 0)
+	{
+		DeckCards.Append(InDeckCards.GetData(), InDeckCards.Num());
+	}
+	else
+	{
+		FBattleSimCore::GetDefaultDeck(DeckCards);
+	}
+}
+
+void FBattleMatchHost::Reserve(int32 NumMatches)
+{
+	Matches.Reserve(NumMatches);
+	FinishedScratch.Reserve(NumMatches);
+}
+
+FBattleMatchHandle FBattleMatchHost::CreateMatch(int32 Seed, uint8 BotSeatMask)
+{
+	int32 Index;
+	if (FreeSlots.Num() > 0)
+	{
+		Index = FreeSlots.Pop(EAllowShrinking::No);
+	}
+	else
+	{
+		Index = Matches.AddDefaulted();
+	}
+
+	FBattleHostedMatch& Match = Matches[Index];
+	Match.Generation++;
+	Match.Seed = Seed;
+	Match.BotSeatMask = BotSeatMask;
+	Match.PendingActions.Reset();
+	Match.TurnRemainingTime = TurnTimeLimit;
+	Match.bActive = true;
+
+	// 與 ACardBattle::StartGame 相同：雙方洗牌，再決定先手
+	Match.Random.Initialize(Seed);
+	Match.Game = Prototype;
+	Match.Game.DealHands(DeckCards, Match.Random);
+	Match.Game.Start(Match.Random.RandRange(0, 1));
+
+	++NumActiveMatches;
+
+	FBattleMatchHandle Handle;
+	Handle.Index = Index;
+	Handle.Generation = Match.Generation;
+	return Handle;
+}
+
+void FBattleMatchHost::DestroyMatch(FBattleMatchHandle Handle)
+{
+	if (FBattleHostedMatch* Match = FindMatchMutable(Handle))
+	{
+		Match->bActive = false;
+		Match->PendingActions.Reset();
+		FreeSlots.Add(Handle.Index);
+		--NumActiveMatches;
+	}
+}
+
+bool FBattleMatchHost::SubmitAction(FBattleMatchHandle Handle, const FBattleAction& Action)
+{
+	if (FBattleHostedMatch* Match = FindMatchMutable(Handle))
+	{
+		Match->PendingActions.Add(Action);
+		return true;
+	}
+	return false;
+}
+
+const FBattleHostedMatch* FBattleMatchHost::FindMatch(FBattleMatchHandle Handle) const
+{
+	if (!Matches.IsValidIndex(Handle.Index))
+	{
+		return nullptr;
+	}
+
+	const FBattleHostedMatch& Match = Matches[Handle.Index];
+	return (Match.bActive && Match.Generation == Handle.Generation) ? &Match : nullptr;
+}
+
+FBattleHostedMatch* FBattleMatchHost::FindMatchMutable(FBattleMatchHandle Handle)
+{
+	return const_cast<FBattleHostedMatch*>(FindMatch(Handle));
+}
+
+bool FBattleMatchHost::StepMatch(FBattleHostedMatch& Match, float DeltaTime) const
+{
+	if (!Match.bActive || !Match.Game.IsWaitingForPlay())
+	{
+		return false;
+	}
+
+	// 先執行收到的指令 (不合法的指令由 Executor 拒絕)
+	for (const FBattleAction& Action : Match.PendingActions)
+	{
+		if (FBattleActionExecutor::Apply(Match.Game, Action, Match.Random).IsValid())
+		{
+			Match.TurnRemainingTime = TurnTimeLimit;
+		}
+	}
+	Match.PendingActions.Reset();
+
+	// 由主機代打的座位立刻出牌
+	while (Match.Game.IsWaitingForPlay() && (Match.BotSeatMask & (1u << Match.Game.GetCurrentTurnPlayerId())) != 0)
+	{
+		const FBattleAction BotAction = FBattleAction::MakePlayRandom(Match.Game.GetCurrentTurnPlayerId(), EBattleActionSource::AI);
+		if (!FBattleActionExecutor::Apply(Match.Game, BotAction, Match.Random).IsValid())
+		{
+			break;
+		}
+		Match.TurnRemainingTime = TurnTimeLimit;
+	}
+
+	// 回合逾時由系統隨機出牌
+	if (Match.Game.IsWaitingForPlay())
+	{
+		Match.TurnRemainingTime -= DeltaTime;
+		if (Match.TurnRemainingTime <= 0.0f)
+		{
+			const FBattleAction TimeoutAction = FBattleAction::MakePlayRandom(Match.Game.GetCurrentTurnPlayerId(), EBattleActionSource::Timeout);
+			FBattleActionExecutor::Apply(Match.Game, TimeoutAction, Match.Random);
+			Match.TurnRemainingTime = TurnTimeLimit;
+		}
+	}
+
+	return Match.Game.GetState() == EBattleState::GameOver;
+}
+
+void FBattleMatchHost::Step(float DeltaTime, TArray<FBattleMatchHandle>& OutFinished)
+{
+	const int32 NumMatches = Matches.Num();
+	if (NumActiveMatches == 0 || NumMatches == 0)
+	{
+		return;
+	}
+
+	const int32 TaskSize = FMath::Max(1, MatchesPerTask);
+	const int32 NumTasks = FMath::DivideAndRoundUp(NumMatches, TaskSize);
+
+	FinishedScratch.SetNumUninitialized(NumMatches, EAllowShrinking::No);
+	std::atomic<int32> NumFinished(0);
+
+	ParallelFor(NumTasks, [&](int32 TaskIndex)
+	{
+		const int32 First = TaskIndex * TaskSize;
+		const int32 Last = FMath::Min(First + TaskSize, NumMatches);
+		for (int32 MatchIndex = First; MatchIndex < Last; ++MatchIndex)
+		{
+			if (StepMatch(Matches[MatchIndex], DeltaTime))
+			{
+				FinishedScratch[NumFinished.fetch_add(1, std::memory_order_relaxed)] = MatchIndex;
+			}
+		}
+	}, NumTasks == 1 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+	// 依索引排序，讓結束順序與執行緒排程無關
+	TArrayView<int32> Finished(FinishedScratch.GetData(), NumFinished.load());
+	Finished.Sort();
+
+	OutFinished.Reserve(OutFinished.Num() + Finished.Num());
+	for (const int32 MatchIndex : Finished)
+	{
+		FBattleMatchHandle& Handle = OutFinished.AddDefaulted_GetRef();
+		Handle.Index = MatchIndex;
+		Handle.Generation = Matches[MatchIndex].Generation;
+	}
+}
+
+void FBattleMatchHost::RunBenchmark(const FBattleSimCore& Prototype, TConstArrayView<FCard> DeckCards, int32 NumMatches, int32 Seed)
+{
+	NumMatches = FMath::Max(1, NumMatches);
+
+	FBattleMatchHost Host;
+	Host.Configure(Prototype, DeckCards, 5.0f);
+	Host.Reserve(NumMatches);
+
+	FRandomStream SeedStream(Seed);
+	TArray<FBattleMatchHandle> Finished;
+	Finished.Reserve(NumMatches);
+
+	// 1. 整場對戰：建立 NumMatches 場雙方代打的對戰並跑到結束
+	const double CreateStart = FPlatformTime::Seconds();
+	for (int32 i = 0; i < NumMatches; ++i)
+	{
+		Host.CreateMatch(SeedStream.RandHelper(MAX_int32 - 1) + 1, 0x3);
+	}
+	const double StepStart = FPlatformTime::Seconds();
+	while (Host.GetNumActiveMatches() > Finished.Num())
+	{
+		const int32 NumBefore = Finished.Num();
+		Host.Step(1.0f / 60.0f, Finished);
+		if (Finished.Num() == NumBefore)
+		{
+			break;
+		}
+	}
+	const double StepEnd = FPlatformTime::Seconds();
+
+	// 2. 閒置成本：等待真人出牌的對戰每次 Tick 只有計時
+	for (const FBattleMatchHandle& Handle : Finished)
+	{
+		Host.DestroyMatch(Handle);
+	}
+	for (int32 i = 0; i < NumMatches; ++i)
+	{
+		Host.CreateMatch(SeedStream.RandHelper(MAX_int32 - 1) + 1, 0x0);
+	}
+
+	constexpr int32 NumIdleTicks = 60;
+	TArray<FBattleMatchHandle> IdleFinished;
+	const double IdleStart = FPlatformTime::Seconds();
+	for (int32 Tick = 0; Tick < NumIdleTicks; ++Tick)
+	{
+		Host.Step(1.0f / 60.0f, IdleFinished);
+	}
+	const double IdleEnd = FPlatformTime::Seconds();
+
+	const int32 NumWorkers = FMath::Max(1, FMath::Min(FMath::DivideAndRoundUp(NumMatches, Host.MatchesPerTask), FTaskGraphInterface::Get().GetNumWorkerThreads() + 1));
+	const double PlaySeconds = FMath::Max(StepEnd - StepStart, 1e-9);
+	const double MatchesPerSecond = (double)Finished.Num() / PlaySeconds;
+	const double IdleTickMicroseconds = (IdleEnd - IdleStart) * 1e6 / NumIdleTicks;
+
+	UE_LOG(LogTemp, Display, TEXT("========== MATCH HOST BENCHMARK =========="));
+	UE_LOG(LogTemp, Display, TEXT("Matches: %d, %d bytes per match, %d worker threads"),
+		NumMatches, (int32)sizeof(FBattleHostedMatch), NumWorkers);
+	UE_LOG(LogTemp, Display, TEXT("Create: %.3f ms"), (StepStart - CreateStart) * 1000.0);
+	UE_LOG(LogTemp, Display, TEXT("Full matches: %d in %.3f ms (%.0f matches/s, %.0f matches/s per core)"),
+		Finished.Num(), PlaySeconds * 1000.0, MatchesPerSecond, MatchesPerSecond / NumWorkers);
+	UE_LOG(LogTemp, Display, TEXT("Idle tick: %.1f us for %d waiting matches (%.1f ns per match)"),
+		IdleTickMicroseconds, NumMatches, IdleTickMicroseconds * 1000.0 / NumMatches);
+	UE_LOG(LogTemp, Display, TEXT("=========================================="));
+}
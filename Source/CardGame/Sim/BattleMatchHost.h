@@ -0,0 +1,112 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Card.h"
+#include "Sim/BattleSimCore.h"
+#include "Sim/BattleAction.h"
+
+/**
+ * FBattleMatchHandle - 指向主機中一場對戰的控制代碼
+ * 槽位重複使用時 Generation 會遞增，舊的控制代碼會失效
+ */
+struct FBattleMatchHandle
+{
+	int32 Index = INDEX_NONE;
+	uint32 Generation = 0;
+
+	bool IsValid() const { return Index != INDEX_NONE; }
+
+	bool operator==(const FBattleMatchHandle& Other) const { return Index == Other.Index && Generation == Other.Generation; }
+	bool operator!=(const FBattleMatchHandle& Other) const { return !(*this == Other); }
+};
+
+/**
+ * FBattleHostedMatch - 主機中一場對戰的完整狀態
+ * 只有規則核心、亂數流、回合計時與少量待執行指令，沒有 UWorld 或 UObject。
+ * Power 表是所有對戰共用的一份 (Configure 時原型規則核心的 FCardPowerTableRef)，每場對戰只保存參照。
+ */
+struct FBattleHostedMatch
+{
+	FBattleSimCore Game;
+	FRandomStream Random;
+
+	// 兩次 Step 之間收到的出牌指令
+	TArray<FBattleAction, TInlineAllocator<2>> PendingActions;
+
+	// 當前回合剩餘時間 (秒)
+	float TurnRemainingTime = 0.0f;
+
+	uint32 Generation = 0;
+	int32 Seed = 0;
+
+	// 由主機代打的座位 (第 PlayerId 位)
+	uint8 BotSeatMask = 0;
+
+	bool bActive = false;
+};
+
+/**
+ * FBattleMatchHost - 在同一個行程中管理大量獨立對戰
+ * 所有對戰存放在一個連續陣列中 (刪除後的槽位重複使用)，
+ * Step 以 ParallelFor 分批推進每場對戰：執行指令、AI 座位出牌、回合逾時代打。
+ * 發牌與先手的亂數使用順序與 ACardBattle 相同，同一個種子可以用 FBattleReplay 重現。
+ * 除了 Step 內部，所有函式都只能在同一條執行緒上呼叫。
+ */
+class CARDGAME_API FBattleMatchHost
+{
+public:
+	FBattleMatchHost();
+
+	// 設定規則 (Prototype 提供 Power 表；DeckCards 為空時使用 1-30) 與回合時間
+	void Configure(const FBattleSimCore& InPrototype, TConstArrayView<FCard> InDeckCards, float InTurnTimeLimit);
+
+	// 預先配置槽位
+	void Reserve(int32 NumMatches);
+
+	// 建立一場對戰並發牌；BotSeatMask 中的座位由主機隨機出牌
+	FBattleMatchHandle CreateMatch(int32 Seed, uint8 BotSeatMask);
+
+	// 刪除對戰 (槽位留給之後的 CreateMatch)
+	void DestroyMatch(FBattleMatchHandle Handle);
+
+	// 排入出牌指令，在下一次 Step 執行 (控制代碼失效時回傳 false)
+	bool SubmitAction(FBattleMatchHandle Handle, const FBattleAction& Action);
+
+	// 取得對戰狀態 (控制代碼失效時回傳 nullptr)
+	const FBattleHostedMatch* FindMatch(FBattleMatchHandle Handle) const;
+
+	// 推進所有對戰，並把這次 Step 中結束的對戰依索引順序附加到 OutFinished
+	void Step(float DeltaTime, TArray<FBattleMatchHandle>& OutFinished);
+
+	int32 GetNumActiveMatches() const { return NumActiveMatches; }
+	int32 GetNumSlots() const { return Matches.Num(); }
+
+	// 每個工作項目處理的對戰數
+	int32 MatchesPerTask = 256;
+
+	// 以雙方都由主機代打的對戰量測吞吐量，並輸出到日誌
+	static void RunBenchmark(const FBattleSimCore& Prototype, TConstArrayView<FCard> DeckCards, int32 NumMatches, int32 Seed);
+
+private:
+	// 推進一場對戰，回傳是否在這次 Step 中結束
+	bool StepMatch(FBattleHostedMatch& Match, float DeltaTime) const;
+
+	FBattleHostedMatch* FindMatchMutable(FBattleMatchHandle Handle);
+
+	FBattleSimCore Prototype;
+	TArray<FCard> DeckCards;
+	float TurnTimeLimit;
+
+	// 所有對戰 (連續存放)
+	TArray<FBattleHostedMatch> Matches;
+
+	// 可重複使用的槽位
+	TArray<int32> FreeSlots;
+
+	int32 NumActiveMatches;
+
+	// Step 時各工作項目寫入結束對戰索引的暫存區
+	TArray<int32> FinishedScratch;
+};
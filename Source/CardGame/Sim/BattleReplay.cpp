@@ -0,0 +1,324 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Sim/BattleReplay.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace BattleReplay
+{
+	// 每個驗證批次的局數
+	static constexpr int32 RecordsPerBatch = 8192;
+
+	// 最多記錄幾筆失敗的索引
+	static constexpr int32 MaxReportedFailures = 16;
+
+	static uint32 ZigZagEncode(int32 Value)
+	{
+		return ((uint32)Value << 1) ^ (uint32)(Value >> 31);
+	}
+
+	static int32 ZigZagDecode(uint32 Value)
+	{
+		return (int32)(Value >> 1) ^ -(int32)(Value & 1);
+	}
+
+	template <typename AllocatorType>
+	static void WriteVarUInt(TArray<uint8, AllocatorType>& Out, uint32 Value)
+	{
+		while (Value >= 0x80)
+		{
+			Out.Add((uint8)(Value | 0x80));
+			Value >>= 7;
+		}
+		Out.Add((uint8)Value);
+	}
+
+	static bool ReadVarUInt(const uint8*& Cursor, const uint8* End, uint32& OutValue)
+	{
+		OutValue = 0;
+		for (int32 Shift = 0; Shift < 35; Shift += 7)
+		{
+			if (Cursor >= End)
+			{
+				return false;
+			}
+
+			const uint8 Byte = *Cursor++;
+			OutValue |= (uint32)(Byte & 0x7F) << Shift;
+			if ((Byte & 0x80) == 0)
+			{
+				return true;
+			}
+		}
+
+		// 超過 5 bytes 不是合法的 32 位元 varint
+		return false;
+	}
+}
+
+void FBattleReplay::Reset(int32 InSeed)
+{
+	Seed = InSeed;
+	Moves.Reset();
+	FinalScores[0] = 0;
+	FinalScores[1] = 0;
+}
+
+void FBattleReplay::AddMove(FCard PlayedCard)
+{
+	if (PlayedCard.IsValid() && Moves.Num() < MaxMoves)
+	{
+		Moves.Add((uint8)PlayedCard.CardValue);
+	}
+}
+
+void FBattleReplay::SetResult(const FBattleSimCore& Game)
+{
+	FinalScores[0] = Game.GetScore(0);
+	FinalScores[1] = Game.GetScore(1);
+}
+
+void FBattleReplay::Serialize(TArray<uint8>& Out) const
+{
+	using namespace BattleReplay;
+
+	Out.Add(FormatVersion);
+	WriteVarUInt(Out, ZigZagEncode(Seed));
+	WriteVarUInt(Out, (uint32)Moves.Num());
+	for (const uint8 Move : Moves)
+	{
+		WriteVarUInt(Out, Move);
+	}
+	WriteVarUInt(Out, ZigZagEncode(FinalScores[0]));
+	WriteVarUInt(Out, ZigZagEncode(FinalScores[1]));
+}
+
+void FBattleReplay::SerializeRecord(TArray<uint8>& Out) const
+{
+	// 先寫內容再把長度插在前面，不需要暫存陣列
+	const int32 RecordStart = Out.Num();
+	Serialize(Out);
+	const uint32 PayloadNum = (uint32)(Out.Num() - RecordStart);
+
+	TArray<uint8, TInlineAllocator<5>> Length;
+	BattleReplay::WriteVarUInt(Length, PayloadNum);
+	Out.Insert(Length.GetData(), Length.Num(), RecordStart);
+}
+
+bool FBattleReplay::Deserialize(TConstArrayView<uint8> Data)
+{
+	using namespace BattleReplay;
+
+	const uint8* Cursor = Data.GetData();
+	const uint8* End = Cursor + Data.Num();
+
+	if (Cursor >= End || *Cursor++ != FormatVersion)
+	{
+		return false;
+	}
+
+	uint32 Value = 0;
+	if (!ReadVarUInt(Cursor, End, Value))
+	{
+		return false;
+	}
+	Seed = ZigZagDecode(Value);
+
+	uint32 NumMoves = 0;
+	if (!ReadVarUInt(Cursor, End, NumMoves) || NumMoves > (uint32)MaxMoves)
+	{
+		return false;
+	}
+
+	Moves.Reset();
+	for (uint32 i = 0; i < NumMoves; ++i)
+	{
+		if (!ReadVarUInt(Cursor, End, Value) || Value > (uint32)FCardHand::MaxCardValue)
+		{
+			return false;
+		}
+		Moves.Add((uint8)Value);
+	}
+
+	for (int32 PlayerId = 0; PlayerId < 2; ++PlayerId)
+	{
+		if (!ReadVarUInt(Cursor, End, Value))
+		{
+			return false;
+		}
+		FinalScores[PlayerId] = ZigZagDecode(Value);
+	}
+
+	return Cursor == End;
+}
+
+bool FBattleReplay::Execute(FBattleSimCore& Game, TConstArrayView<FCard> DeckCards) const
+{
+	// 與 ACardBattle::StartGame 相同的亂數使用順序：雙方洗牌，再決定先手
+	FRandomStream Random(Seed);
+	Game.Reset();
+	Game.DealHands(DeckCards, Random);
+	Game.Start(Random.RandRange(0, 1));
+
+	for (const uint8 Move : Moves)
+	{
+		if (!Game.PlayCardByValue(Game.GetCurrentTurnPlayerId(), Move).IsValid())
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool FBattleReplay::SplitRecords(TConstArrayView<uint8> Data, TArray<TConstArrayView<uint8>>& OutRecords)
+{
+	const uint8* Cursor = Data.GetData();
+	const uint8* End = Cursor + Data.Num();
+
+	while (Cursor < End)
+	{
+		uint32 Length = 0;
+		if (!BattleReplay::ReadVarUInt(Cursor, End, Length) || Length > (uint32)(End - Cursor))
+		{
+			return false;
+		}
+
+		OutRecords.Add(TConstArrayView<uint8>(Cursor, (int32)Length));
+		Cursor += Length;
+	}
+
+	return true;
+}
+
+FString FBattleReplay::GetDefaultArchivePath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("Replays") / TEXT("Matches.cardreplay");
+}
+
+bool FBattleReplay::AppendTo(FArchive& Archive, TArray<uint8>& Scratch) const
+{
+	Scratch.Reset(MaxRecordSize);
+	SerializeRecord(Scratch);
+
+	Archive.Serialize(Scratch.GetData(), Scratch.Num());
+	Archive.Flush();
+	return !Archive.IsError();
+}
+
+bool FBattleReplay::AppendToFile(const FString& FilePath) const
+{
+	TArray<uint8> Record;
+	SerializeRecord(Record);
+	return FFileHelper::SaveArrayToFile(Record, *FilePath, &IFileManager::Get(), FILEWRITE_Append);
+}
+
+void FBattleReplayVerifyResult::LogReport() const
+{
+	UE_LOG(LogTemp, Display, TEXT("========== REPLAY VERIFY RESULT =========="));
+	UE_LOG(LogTemp, Display, TEXT("Replays: %lld in %.3f s (%.0f replays/s)"), NumReplays, ElapsedSeconds, GetReplaysPerSecond());
+	UE_LOG(LogTemp, Display, TEXT("Matched: %lld, Score mismatch: %lld, Illegal move: %lld, Corrupt: %lld"),
+		NumMatched, NumScoreMismatch, NumIllegalMove, NumCorrupt);
+
+	for (const int64 Index : FirstFailures)
+	{
+		UE_LOG(LogTemp, Display, TEXT("  Failed replay #%lld"), Index);
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("=========================================="));
+}
+
+EBattleReplayVerdict FBattleReplayVerifier::Verify(const FBattleReplay& Replay, FBattleSimCore& Game, TConstArrayView<FCard> DeckCards)
+{
+	if (!Replay.Execute(Game, DeckCards) || Game.GetState() != EBattleState::GameOver)
+	{
+		return EBattleReplayVerdict::IllegalMove;
+	}
+
+	if (Game.GetScore(0) != Replay.FinalScores[0] || Game.GetScore(1) != Replay.FinalScores[1])
+	{
+		return EBattleReplayVerdict::ScoreMismatch;
+	}
+
+	return EBattleReplayVerdict::Match;
+}
+
+FBattleReplayVerifyResult FBattleReplayVerifier::VerifyRecords(TConstArrayView<uint8> Data, const FBattleSimCore& Prototype, TConstArrayView<FCard> DeckCards)
+{
+	using namespace BattleReplay;
+
+	FBattleReplayVerifyResult Result;
+
+	// 沒有指定牌組時使用 1-30
+	TArray<FCard> DefaultDeck;
+	if (DeckCards.Num() == 0)
+	{
+		FBattleSimCore::GetDefaultDeck(DefaultDeck);
+		DeckCards = DefaultDeck;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	TArray<TConstArrayView<uint8>> Records;
+	if (!FBattleReplay::SplitRecords(Data, Records))
+	{
+		// 尾端不完整的紀錄視為一筆損壞資料 (其餘仍然驗證)
+		++Result.NumCorrupt;
+		++Result.NumReplays;
+	}
+
+	struct FBatchResult
+	{
+		int64 Counts[4] = { 0, 0, 0, 0 };
+		TArray<int64> Failures;
+	};
+
+	const int32 NumBatches = FMath::DivideAndRoundUp(Records.Num(), RecordsPerBatch);
+	TArray<FBatchResult> BatchResults;
+	BatchResults.SetNum(NumBatches);
+
+	ParallelFor(NumBatches, [&](int32 BatchIndex)
+	{
+		FBatchResult& Batch = BatchResults[BatchIndex];
+		FBattleSimCore Game = Prototype;
+		FBattleReplay Replay;
+
+		const int32 First = BatchIndex * RecordsPerBatch;
+		const int32 Last = FMath::Min(First + RecordsPerBatch, Records.Num());
+		for (int32 RecordIndex = First; RecordIndex < Last; ++RecordIndex)
+		{
+			const EBattleReplayVerdict Verdict = Replay.Deserialize(Records[RecordIndex])
+				? FBattleReplayVerifier::Verify(Replay, Game, DeckCards)
+				: EBattleReplayVerdict::Corrupt;
+
+			++Batch.Counts[(int32)Verdict];
+			if (Verdict != EBattleReplayVerdict::Match && Batch.Failures.Num() < MaxReportedFailures)
+			{
+				Batch.Failures.Add(RecordIndex);
+			}
+		}
+	});
+
+	for (const FBatchResult& Batch : BatchResults)
+	{
+		Result.NumMatched += Batch.Counts[(int32)EBattleReplayVerdict::Match];
+		Result.NumCorrupt += Batch.Counts[(int32)EBattleReplayVerdict::Corrupt];
+		Result.NumIllegalMove += Batch.Counts[(int32)EBattleReplayVerdict::IllegalMove];
+		Result.NumScoreMismatch += Batch.Counts[(int32)EBattleReplayVerdict::ScoreMismatch];
+
+		for (const int64 Index : Batch.Failures)
+		{
+			if (Result.FirstFailures.Num() < MaxReportedFailures)
+			{
+				Result.FirstFailures.Add(Index);
+			}
+		}
+	}
+
+	Result.NumReplays += Records.Num();
+	Result.ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+	return Result;
+}
@@ -0,0 +1,126 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Card.h"
+#include "Sim/BattleSimCore.h"
+
+/**
+ * FBattleReplay - 一局對戰的精簡紀錄
+ * 只記錄亂數種子與依序打出的卡牌數值；發牌與先手由種子重現
+ * (與 ACardBattle::StartGame / FBattleSimCore::DealHands 的亂數使用順序一致)。
+ *
+ * 二進位格式 (皆為 varint，有號數以 zigzag 編碼):
+ *   [版本] [種子] [出牌數] [卡牌數值 x 出牌數] [玩家 0 分數] [玩家 1 分數]
+ * 一局 20 手約 30 bytes。多局存放時每筆前面再加上 varint 長度。
+ */
+struct CARDGAME_API FBattleReplay
+{
+	// 格式版本
+	static constexpr uint8 FormatVersion = 1;
+
+	// 一局最多的出牌數
+	static constexpr int32 MaxMoves = FBattleSimCore::HandSize * 2;
+
+	// 一筆帶長度前綴的紀錄最多的 bytes (每個 varint 最多 5 bytes，uint8 的卡牌數值最多 2 bytes)
+	static constexpr int32 MaxRecordSize = 1 + 5 + 5 + MaxMoves * 2 + 5 * 2 + 5;
+
+	// 亂數種子
+	int32 Seed = 0;
+
+	// 依序打出的卡牌數值
+	TArray<uint8, TInlineAllocator<MaxMoves>> Moves;
+
+	// 記錄時的最終分數 (驗證時與重新模擬的結果比對)
+	int32 FinalScores[2] = { 0, 0 };
+
+	// 開始記錄新的一局
+	void Reset(int32 InSeed);
+
+	// 記錄一手出牌
+	void AddMove(FCard PlayedCard);
+
+	// 記錄最終分數
+	void SetResult(const FBattleSimCore& Game);
+
+	// 寫出本局資料 (附加在 Out 尾端)
+	void Serialize(TArray<uint8>& Out) const;
+
+	// 寫出帶長度前綴的一筆紀錄 (用於存放多局)
+	void SerializeRecord(TArray<uint8>& Out) const;
+
+	// 把一筆紀錄附加到已開啟的檔案 (Scratch 由呼叫端重複使用，容量足夠時不配置記憶體)
+	bool AppendTo(FArchive& Archive, TArray<uint8>& Scratch) const;
+
+	// 讀取一局資料，格式錯誤時回傳 false
+	bool Deserialize(TConstArrayView<uint8> Data);
+
+	// 以種子發牌，並在規則核心中依序重新執行所有出牌
+	// 有不合法的出牌時回傳 false (Game 停在該手之前)
+	bool Execute(FBattleSimCore& Game, TConstArrayView<FCard> DeckCards) const;
+
+	// 將多筆帶長度前綴的紀錄切開，回傳是否完整解析
+	static bool SplitRecords(TConstArrayView<uint8> Data, TArray<TConstArrayView<uint8>>& OutRecords);
+
+	// ACardBattle 附加紀錄的預設檔案 (Saved/Replays/Matches.cardreplay)
+	static FString GetDefaultArchivePath();
+
+	// 把一筆紀錄附加到檔案尾端
+	bool AppendToFile(const FString& FilePath) const;
+};
+
+/**
+ * EBattleReplayVerdict - 單局驗證結果
+ */
+enum class EBattleReplayVerdict : uint8
+{
+	// 重新模擬的分數與紀錄相同
+	Match,
+
+	// 資料格式錯誤
+	Corrupt,
+
+	// 出牌不合法 (例如規則或牌組改變後手牌不同)
+	IllegalMove,
+
+	// 可以執行完，但分數與紀錄不同 (例如 DataTable 的 Power 改變)
+	ScoreMismatch,
+};
+
+/**
+ * FBattleReplayVerifyResult - 批次驗證報告
+ */
+struct CARDGAME_API FBattleReplayVerifyResult
+{
+	int64 NumReplays = 0;
+	int64 NumMatched = 0;
+	int64 NumCorrupt = 0;
+	int64 NumIllegalMove = 0;
+	int64 NumScoreMismatch = 0;
+
+	// 前幾筆不相符的紀錄索引 (方便追查)
+	TArray<int64> FirstFailures;
+
+	// 實際耗時 (秒)
+	double ElapsedSeconds = 0.0;
+
+	bool AllMatched() const { return NumMatched == NumReplays; }
+	double GetReplaysPerSecond() const { return ElapsedSeconds > 0.0 ? (double)NumReplays / ElapsedSeconds : 0.0; }
+
+	// 輸出到日誌
+	void LogReport() const;
+};
+
+/**
+ * FBattleReplayVerifier - 多執行緒重新執行大量對戰紀錄
+ * 用於 DataTable 或規則修改後的回歸檢查
+ */
+struct CARDGAME_API FBattleReplayVerifier
+{
+	// 驗證單局
+	static EBattleReplayVerdict Verify(const FBattleReplay& Replay, FBattleSimCore& Game, TConstArrayView<FCard> DeckCards);
+
+	// 驗證多筆帶長度前綴的紀錄 (Prototype 提供 Power 表；DeckCards 為空時使用 1-30)
+	static FBattleReplayVerifyResult VerifyRecords(TConstArrayView<uint8> Data, const FBattleSimCore& Prototype, TConstArrayView<FCard> DeckCards);
+};
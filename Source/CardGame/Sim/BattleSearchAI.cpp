@@ -0,0 +1,318 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Sim/BattleSearchAI.h"
+#include "CardGame.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Crc.h"
+
+namespace BattleSearchAI
+{
+	// 每隔多少節點檢查一次時間
+	static constexpr int64 TimeCheckInterval = 1024;
+
+	// 比較期望值時的容許誤差 (平均值有浮點誤差，相同時保留排序較前的出牌)
+	static constexpr float ValueEpsilon = 1.0e-4f;
+
+	static uint64 MakeKey(uint32 AIHand, uint32 OpponentHand, bool bAIToMove)
+	{
+		// 手牌只使用第 1-30 位，兩個遮罩加上輪到誰可以放進 63 位元；最高位標記有效項目
+		return (uint64)AIHand | ((uint64)OpponentHand << 31) | ((uint64)bAIToMove << 62) | (1ull << 63);
+	}
+}
+
+FBattleSearchAI::FBattleSearchAI(int32 TableSizeLog2)
+	: PowerHash(0)
+	, Nodes(0)
+	, MaxNodes(0)
+	, Deadline(0.0)
+	, CancelFlag(nullptr)
+	, bAborted(false)
+{
+	TableSizeLog2 = FMath::Clamp(TableSizeLog2, 10, 26);
+	Table.SetNum(1 << TableSizeLog2);
+	TableMask = (uint64)Table.Num() - 1;
+	FMemory::Memzero(Power, sizeof(Power));
+}
+
+void FBattleSearchAI::ClearTable()
+{
+	FMemory::Memzero(Table.GetData(), Table.Num() * sizeof(FTableEntry));
+}
+
+void FBattleSearchAI::BindPowerTable(const FCardPowerTable& InPowerTable)
+{
+	int32 NewPower[FCardPowerTable::NumEntries];
+	for (int32 CardValue = 0; CardValue < FCardPowerTable::NumEntries; ++CardValue)
+	{
+		NewPower[CardValue] = InPowerTable.GetPower(CardValue);
+	}
+
+	// 置換表的值取決於 Power，數值改變後舊的項目都失效
+	const uint32 NewHash = FCrc::MemCrc32(NewPower, sizeof(NewPower));
+	if (NewHash != PowerHash || FMemory::Memcmp(NewPower, Power, sizeof(Power)) != 0)
+	{
+		FMemory::Memcpy(Power, NewPower, sizeof(Power));
+		PowerHash = NewHash;
+		ClearTable();
+	}
+}
+
+int32 FBattleSearchAI::OrderMoves(uint32 Hand, uint8* OutCards) const
+{
+	int32 Count = 0;
+	for (uint32 Remaining = Hand; Remaining != 0; Remaining &= Remaining - 1u)
+	{
+		const uint8 CardValue = (uint8)FMath::CountTrailingZeros(Remaining);
+
+		// 插入排序：手牌最多十幾張
+		int32 Index = Count++;
+		while (Index > 0 && Power[OutCards[Index - 1]] < Power[CardValue])
+		{
+			OutCards[Index] = OutCards[Index - 1];
+			--Index;
+		}
+		OutCards[Index] = CardValue;
+	}
+	return Count;
+}
+
+int32 FBattleSearchAI::SumPower(uint32 Hand) const
+{
+	int32 Sum = 0;
+	for (uint32 Remaining = Hand; Remaining != 0; Remaining &= Remaining - 1u)
+	{
+		Sum += Power[FMath::CountTrailingZeros(Remaining)];
+	}
+	return Sum;
+}
+
+float FBattleSearchAI::Evaluate(uint32 AIHand, uint32 OpponentHand) const
+{
+	return (float)(SumPower(AIHand) - SumPower(OpponentHand));
+}
+
+float FBattleSearchAI::Search(uint32 AIHand, uint32 OpponentHand, bool bAIToMove, int32 Depth)
+{
+	using namespace BattleSearchAI;
+
+	const int32 Remaining = (int32)FMath::CountBits(AIHand) + (int32)FMath::CountBits(OpponentHand);
+	if (Remaining == 0)
+	{
+		return 0.0f;
+	}
+
+	if (Depth <= 0)
+	{
+		return Evaluate(AIHand, OpponentHand);
+	}
+
+	const uint32 MoverHand = bAIToMove ? AIHand : OpponentHand;
+	if (MoverHand == 0)
+	{
+		// 出牌方沒有手牌時換另一方 (正常對戰中雙方張數相同，不會發生)
+		return Search(AIHand, OpponentHand, !bAIToMove, Depth);
+	}
+
+	// 搜尋到遊戲結束的值是精確的，可以滿足任何更深的需求
+	const int32 EffectiveDepth = FMath::Min(Depth, Remaining);
+	const uint64 Key = MakeKey(AIHand, OpponentHand, bAIToMove);
+	FTableEntry& Entry = Table[((Key * 0x9E3779B97F4A7C15ull) >> 32) & TableMask];
+	if (Entry.Key == Key && Entry.Depth >= EffectiveDepth)
+	{
+		return Entry.Value;
+	}
+
+	++Nodes;
+	if (Nodes >= MaxNodes || ((Nodes % TimeCheckInterval) == 0 && (FPlatformTime::Seconds() > Deadline || (CancelFlag && CancelFlag->load(std::memory_order_relaxed)))))
+	{
+		bAborted = true;
+		return 0.0f;
+	}
+
+	uint8 Moves[32];
+	const int32 NumMoves = OrderMoves(MoverHand, Moves);
+
+	float Value;
+	if (bAIToMove)
+	{
+		Value = -MAX_flt;
+		for (int32 MoveIndex = 0; MoveIndex < NumMoves; ++MoveIndex)
+		{
+			const uint8 CardValue = Moves[MoveIndex];
+			const float ChildValue = (float)Power[CardValue] + Search(AIHand & ~(1u << CardValue), OpponentHand, false, Depth - 1);
+			if (bAborted)
+			{
+				return 0.0f;
+			}
+			Value = FMath::Max(Value, ChildValue);
+		}
+	}
+	else
+	{
+		// 對手視為隨機出牌 (與逾時代打相同)
+		float Sum = 0.0f;
+		for (int32 MoveIndex = 0; MoveIndex < NumMoves; ++MoveIndex)
+		{
+			const uint8 CardValue = Moves[MoveIndex];
+			Sum += -(float)Power[CardValue] + Search(AIHand, OpponentHand & ~(1u << CardValue), true, Depth - 1);
+			if (bAborted)
+			{
+				return 0.0f;
+			}
+		}
+		Value = Sum / (float)NumMoves;
+	}
+
+	Entry.Key = Key;
+	Entry.Value = Value;
+	Entry.Depth = (uint8)EffectiveDepth;
+	return Value;
+}
+
+FBattleSearchResult FBattleSearchAI::ChooseMove(const FBattleSimCore& Game, const FBattleSearchSettings& Settings)
+{
+	CARDGAME_SCOPE_CYCLE_COUNTER(AISearch);
+
+	using namespace BattleSearchAI;
+
+	FBattleSearchResult Result;
+	if (!Game.IsWaitingForPlay())
+	{
+		return Result;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	BindPowerTable(Game.GetPowerTable());
+
+	const int32 PlayerId = Game.GetCurrentTurnPlayerId();
+	const uint32 AIHand = Game.GetHand(PlayerId).GetBits();
+	const uint32 OpponentHand = Game.GetHand(1 - PlayerId).GetBits();
+
+	uint8 Moves[32];
+	const int32 NumMoves = OrderMoves(AIHand, Moves);
+	if (NumMoves == 0)
+	{
+		return Result;
+	}
+
+	Nodes = 0;
+	MaxNodes = FMath::Max<int64>(Settings.MaxNodes, 1);
+	Deadline = StartTime + Settings.MaxSeconds;
+	CancelFlag = Settings.CancelFlag;
+	bAborted = false;
+
+	// 預算連第一層都不夠時，打出排序第一的牌
+	Result.CardValue = Moves[0];
+	Result.ExpectedScoreDelta = Evaluate(AIHand, OpponentHand);
+
+	const int32 Remaining = (int32)FMath::CountBits(AIHand) + (int32)FMath::CountBits(OpponentHand);
+	for (int32 Depth = 1; Depth <= Remaining; ++Depth)
+	{
+		float BestValue = -MAX_flt;
+		int32 BestIndex = 0;
+
+		for (int32 MoveIndex = 0; MoveIndex < NumMoves; ++MoveIndex)
+		{
+			const uint8 CardValue = Moves[MoveIndex];
+			const float Value = (float)Power[CardValue] + Search(AIHand & ~(1u << CardValue), OpponentHand, false, Depth - 1);
+			if (bAborted)
+			{
+				break;
+			}
+
+			if (Value > BestValue + ValueEpsilon)
+			{
+				BestValue = Value;
+				BestIndex = MoveIndex;
+			}
+		}
+
+		if (bAborted)
+		{
+			break;
+		}
+
+		Result.CardValue = Moves[BestIndex];
+		Result.ExpectedScoreDelta = BestValue;
+		Result.Depth = Depth;
+		Result.bExact = Depth >= Remaining;
+
+		// 下一次迭代先搜尋目前最好的出牌
+		if (BestIndex > 0)
+		{
+			const uint8 BestCard = Moves[BestIndex];
+			FMemory::Memmove(Moves + 1, Moves, BestIndex);
+			Moves[0] = BestCard;
+		}
+	}
+
+	Result.Nodes = Nodes;
+	Result.ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+	return Result;
+}
+
+void FBattleSearchAI::RunBenchmark(const FBattleSimCore& Prototype, TConstArrayView<FCard> DeckCards, int32 NumPositions, int32 Seed, const FBattleSearchSettings& Settings)
+{
+	NumPositions = FMath::Max(1, NumPositions);
+
+	TArray<FCard> DefaultDeck;
+	if (DeckCards.Num() == 0)
+	{
+		FBattleSimCore::GetDefaultDeck(DefaultDeck);
+		DeckCards = DefaultDeck;
+	}
+
+	FBattleSearchAI AI;
+	FRandomStream Random(Seed);
+	FBattleSimCore Game = Prototype;
+
+	TArray<double> Latencies;
+	Latencies.Reserve(NumPositions);
+	int64 TotalNodes = 0;
+	int32 NumExact = 0;
+	double ColdOpeningSeconds = 0.0;
+
+	for (int32 PositionIndex = 0; PositionIndex < NumPositions; ++PositionIndex)
+	{
+		Game.Reset();
+		Game.DealHands(DeckCards, Random);
+		Game.Start(Random.RandRange(0, 1));
+
+		// 隨機推進到局中的某一手 (第一個局面是開局，且置換表是空的：最壞情況)
+		const int32 NumPlies = PositionIndex == 0 ? 0 : Random.RandRange(0, FBattleSimCore::HandSize * 2 - 1);
+		for (int32 Ply = 0; Ply < NumPlies && Game.IsWaitingForPlay(); ++Ply)
+		{
+			Game.PlayRandomCard(Random);
+		}
+
+		if (PositionIndex == 0)
+		{
+			AI.ClearTable();
+		}
+
+		const FBattleSearchResult Result = AI.ChooseMove(Game, Settings);
+		Latencies.Add(Result.ElapsedSeconds);
+		TotalNodes += Result.Nodes;
+		NumExact += Result.bExact ? 1 : 0;
+
+		if (PositionIndex == 0)
+		{
+			ColdOpeningSeconds = Result.ElapsedSeconds;
+		}
+	}
+
+	Latencies.Sort();
+	auto Percentile = [&Latencies](double Fraction)
+	{
+		return Latencies[FMath::Clamp((int32)(Fraction * (Latencies.Num() - 1)), 0, Latencies.Num() - 1)] * 1000.0;
+	};
+
+	UE_LOG(LogTemp, Display, TEXT("========== SEARCH AI BENCHMARK =========="));
+	UE_LOG(LogTemp, Display, TEXT("Positions: %d, budget %lld nodes / %.1f ms, table %d entries (%d KB)"),
+		NumPositions, Settings.MaxNodes, Settings.MaxSeconds * 1000.0, AI.Table.Num(), (int32)(AI.Table.Num() * sizeof(FTableEntry) / 1024));
+	UE_LOG(LogTemp, Display, TEXT("Latency ms: p50 %.3f, p90 %.3f, p99 %.3f, max %.3f (cold opening %.3f)"),
+		Percentile(0.5), Percentile(0.9), Percentile(0.99), Latencies.Last() * 1000.0, ColdOpeningSeconds * 1000.0);
+	UE_LOG(LogTemp, Display, TEXT("Nodes per move: %.0f, solved exactly: %.1f%%"),
+		(double)TotalNodes / NumPositions, 100.0 * NumExact / NumPositions);
+	UE_LOG(LogTemp, Display, TEXT("========================================="));
+}
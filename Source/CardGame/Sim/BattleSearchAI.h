@@ -0,0 +1,105 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Card.h"
+#include "Sim/BattleSimCore.h"
+#include <atomic>
+
+/**
+ * FBattleSearchSettings - 每一步的搜尋預算
+ */
+struct FBattleSearchSettings
+{
+	// 最多展開的節點數
+	int64 MaxNodes = 500000;
+
+	// 最多使用的時間 (秒)
+	double MaxSeconds = 0.02;
+
+	// 由其他執行緒設為 true 時盡快停止 (可為 nullptr)
+	const std::atomic<bool>* CancelFlag = nullptr;
+};
+
+/**
+ * FBattleSearchResult - 搜尋結果
+ */
+struct FBattleSearchResult
+{
+	// 選擇打出的卡牌數值 (0 表示沒有可出的牌)
+	int32 CardValue = 0;
+
+	// 預期的最終分差 (AI 減對手，不含已得分數)
+	float ExpectedScoreDelta = 0.0f;
+
+	// 完成的搜尋深度 (出牌數)
+	int32 Depth = 0;
+
+	// 是否搜尋到遊戲結束 (結果為精確值)
+	bool bExact = false;
+
+	int64 Nodes = 0;
+	double ElapsedSeconds = 0.0;
+};
+
+/**
+ * FBattleSearchAI - 以 Expectimax 選牌的 AI
+ * 狀態只有雙方手牌的位元遮罩與輪到誰 (已得分數與之後的選擇無關，不放入狀態)，
+ * 以雜湊置換表快取子樹的值。AI 的節點取最大值，對手的節點視為隨機出牌取平均。
+ * 以迭代加深在節點與時間預算內搜尋，預算用完時使用最後完成的深度；
+ * 每層依 GetCardPower 由高到低排序出牌，葉節點以雙方剩餘手牌的 Power 總和估值。
+ * 目前的規則下每張牌最後都會打出、分數只是 Power 的總和，因此所有出牌的期望值相同；
+ * 搜尋會在第一次迭代就確認這點，並依排序打出 Power 最高的牌。
+ */
+class CARDGAME_API FBattleSearchAI
+{
+public:
+	// TableSizeLog2: 置換表大小 (2 的次方個項目，每項 16 bytes)
+	explicit FBattleSearchAI(int32 TableSizeLog2 = 18);
+
+	// 為當前回合的玩家選一張牌
+	FBattleSearchResult ChooseMove(const FBattleSimCore& Game, const FBattleSearchSettings& Settings);
+
+	// 清空置換表
+	void ClearTable();
+
+	// 以隨機局面量測每步的延遲分佈，並輸出到日誌
+	static void RunBenchmark(const FBattleSimCore& Prototype, TConstArrayView<FCard> DeckCards, int32 NumPositions, int32 Seed, const FBattleSearchSettings& Settings);
+
+private:
+	struct FTableEntry
+	{
+		uint64 Key = 0;
+		float Value = 0.0f;
+		uint8 Depth = 0;
+	};
+
+	// 回傳 AI 減對手的預期分差 (從這個狀態之後)
+	float Search(uint32 AIHand, uint32 OpponentHand, bool bAIToMove, int32 Depth);
+
+	// 依 Power 由高到低排列手牌，回傳張數
+	int32 OrderMoves(uint32 Hand, uint8* OutCards) const;
+
+	// 雙方剩餘手牌的 Power 差 (葉節點估值)
+	float Evaluate(uint32 AIHand, uint32 OpponentHand) const;
+
+	int32 SumPower(uint32 Hand) const;
+
+	// Power 表改變時清空置換表
+	void BindPowerTable(const FCardPowerTable& InPowerTable);
+
+	TArray<FTableEntry> Table;
+	uint64 TableMask;
+
+	// 目前的 Power (以 CardValue 索引)
+	int32 Power[FCardPowerTable::NumEntries];
+	uint32 PowerHash;
+
+	// 本次搜尋的預算狀態
+	int64 Nodes;
+	int64 MaxNodes;
+	double Deadline;
+	const std::atomic<bool>* CancelFlag;
+	bool bAborted;
+};
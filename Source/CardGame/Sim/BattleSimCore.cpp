@@ -0,0 +1,269 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Sim/BattleSimCore.h"
+#include "Engine/DataTable.h"
+
+FBattleSimCore::FBattleSimCore()
+	: PowerTable(FCardPowerTable::GetDefault())
+{
+	Reset();
+}
+
+void FBattleSimCore::Reset()
+{
+	for (int32 i = 0; i < 2; ++i)
+	{
+		Hands[i].Reset();
+		PlayedNum[i] = 0;
+		Scores[i] = 0;
+		CurrentRoundCards[i] = FCard(0);
+		bCardPlayed[i] = false;
+	}
+
+	State = EBattleState::Idle;
+	CurrentTurnPlayerId = 0;
+	Winner = -1;
+	LastRoundInfo = FRoundInfo();
+}
+
+void FBattleSimCore::SetHand(int32 PlayerId, TConstArrayView<FCard> Cards)
+{
+	check(PlayerId == 0 || PlayerId == 1);
+
+	FCardHand& Hand = Hands[PlayerId];
+	Hand.Reset();
+	for (int32 i = 0; i < Cards.Num() && Hand.Num() < HandSize; ++i)
+	{
+		Hand.Add(Cards[i].CardValue);
+	}
+}
+
+void FBattleSimCore::GetDefaultDeck(TArray<FCard>& OutCards)
+{
+	OutCards.Reset(MaxCardValue);
+	for (int32 CardValue = 1; CardValue <= MaxCardValue; ++CardValue)
+	{
+		OutCards.Add(FCard(CardValue));
+	}
+}
+
+void FBattleSimCore::BuildDeck(const UDataTable* DataTable, TArray<FCard>& OutCards)
+{
+	OutCards.SetNumUninitialized(MaxCardValue);
+	OutCards.SetNum(BuildDeck(DataTable, OutCards.GetData(), MaxCardValue), EAllowShrinking::No);
+}
+
+int32 FBattleSimCore::BuildDeck(const UDataTable* DataTable, FCard* OutCards, int32 MaxCards)
+{
+	if (!DataTable)
+	{
+		return 0;
+	}
+
+	MaxCards = FMath::Min(MaxCards, MaxCardValue);
+
+	int32 NumCards = 0;
+	uint32 SeenMask = 0;
+	for (const TPair<FName, uint8*>& Row : DataTable->GetRowMap())
+	{
+		if (NumCards == MaxCards)
+		{
+			break;
+		}
+
+		// RowName 就是 CardValue 的字串形式 (寫到堆疊上的字串，不配置記憶體)
+		TStringBuilder<NAME_SIZE> RowString;
+		Row.Key.AppendString(RowString);
+		if (!FCString::IsNumeric(*RowString))
+		{
+			continue;
+		}
+
+		// 超出範圍的牌無法放進 FCardHand，多出的牌 DealHands 也不會洗到
+		const FCard Card(FCString::Atoi(*RowString));
+		if (!Card.IsValid() || (SeenMask & (1u << Card.CardValue)) != 0)
+		{
+			continue;
+		}
+
+		SeenMask |= 1u << Card.CardValue;
+		OutCards[NumCards++] = Card;
+	}
+
+	return NumCards;
+}
+
+void FBattleSimCore::DealHands(TConstArrayView<FCard> DeckCards, FRandomStream& Random)
+{
+	FCard Deck[MaxCardValue];
+	const int32 DeckNum = FMath::Min(DeckCards.Num(), MaxCardValue);
+
+	for (int32 PlayerId = 0; PlayerId < 2; ++PlayerId)
+	{
+		for (int32 i = 0; i < DeckNum; ++i)
+		{
+			Deck[i] = DeckCards[i];
+		}
+
+		// Fisher-Yates 洗牌 (與 UCardDeck::ShuffleDeck 相同)
+		for (int32 i = DeckNum - 1; i > 0; --i)
+		{
+			const int32 RandomIndex = Random.RandRange(0, i);
+			Swap(Deck[i], Deck[RandomIndex]);
+		}
+
+		SetHand(PlayerId, TConstArrayView<FCard>(Deck, FMath::Min(DeckNum, HandSize)));
+	}
+}
+
+void FBattleSimCore::Start(int32 FirstPlayerId)
+{
+	State = EBattleState::Started;
+
+	// BeginNextRound 會先切換玩家，所以這裡先設為對手
+	CurrentTurnPlayerId = 1 - FirstPlayerId;
+
+	if (CheckGameOver())
+	{
+		DetermineWinner();
+		State = EBattleState::GameOver;
+		return;
+	}
+
+	BeginNextRound();
+}
+
+FCard FBattleSimCore::PlayCard(int32 PlayerId, int32 CardIndex)
+{
+	// 檢查是否是當前玩家的回合
+	if (!IsWaitingForPlay() || PlayerId != CurrentTurnPlayerId)
+	{
+		return FCard(0);
+	}
+
+	// 從手牌移除 (超出範圍時回傳無效牌)
+	const FCard PlayedCard = Hands[PlayerId].RemoveAt(CardIndex);
+	if (!PlayedCard.IsValid())
+	{
+		return FCard(0);
+	}
+
+	CommitPlay(PlayerId, PlayedCard);
+	return PlayedCard;
+}
+
+FCard FBattleSimCore::PlayCardByValue(int32 PlayerId, int32 CardValue)
+{
+	if (!IsWaitingForPlay() || PlayerId != CurrentTurnPlayerId)
+	{
+		return FCard(0);
+	}
+
+	if (!Hands[PlayerId].Remove(CardValue))
+	{
+		return FCard(0);
+	}
+
+	const FCard PlayedCard(CardValue);
+	CommitPlay(PlayerId, PlayedCard);
+	return PlayedCard;
+}
+
+void FBattleSimCore::CommitPlay(int32 PlayerId, FCard PlayedCard)
+{
+	// 記錄出牌並立刻加分
+	CurrentRoundCards[PlayerId] = PlayedCard;
+	bCardPlayed[PlayerId] = true;
+	Scores[PlayerId] += GetCardPower(PlayedCard.CardValue);
+	PlayedCards[PlayerId][PlayedNum[PlayerId]++] = PlayedCard;
+
+	// 如果雙方都出牌了，結算本回合
+	if (bCardPlayed[0] && bCardPlayed[1])
+	{
+		ResolveRound();
+
+		if (CheckGameOver())
+		{
+			DetermineWinner();
+			State = EBattleState::GameOver;
+		}
+		else
+		{
+			BeginNextRound();
+		}
+	}
+	else
+	{
+		// 切換到另一玩家的回合
+		CurrentTurnPlayerId = 1 - CurrentTurnPlayerId;
+		State = CurrentTurnPlayerId == 0 ? EBattleState::WaitingForPlayer0 : EBattleState::WaitingForPlayer1;
+	}
+}
+
+FCard FBattleSimCore::PlayRandomCard(FRandomStream& Random)
+{
+	const int32 PlayerId = CurrentTurnPlayerId;
+	const int32 NumCards = Hands[PlayerId].Num();
+	if (!IsWaitingForPlay() || NumCards <= 0)
+	{
+		return FCard(0);
+	}
+
+	return PlayCard(PlayerId, Random.RandRange(0, NumCards - 1));
+}
+
+int32 FBattleSimCore::RunRandomGame(FRandomStream& Random)
+{
+	while (IsWaitingForPlay())
+	{
+		if (!PlayRandomCard(Random).IsValid())
+		{
+			// 當前玩家沒有手牌可出，遊戲無法繼續
+			break;
+		}
+	}
+
+	return Winner;
+}
+
+void FBattleSimCore::BeginNextRound()
+{
+	// 切換讓另一位玩家開始新的一回合 (避免同一人連續出牌)
+	CurrentTurnPlayerId = 1 - CurrentTurnPlayerId;
+
+	// 重置本回合的出牌狀態
+	bCardPlayed[0] = false;
+	bCardPlayed[1] = false;
+	CurrentRoundCards[0] = FCard(0);
+	CurrentRoundCards[1] = FCard(0);
+
+	State = CurrentTurnPlayerId == 0 ? EBattleState::WaitingForPlayer0 : EBattleState::WaitingForPlayer1;
+}
+
+void FBattleSimCore::ResolveRound()
+{
+	LastRoundInfo.Player0Card = CurrentRoundCards[0];
+	LastRoundInfo.Player1Card = CurrentRoundCards[1];
+	LastRoundInfo.WinnerID = -1;  // 不再判定回合勝負
+}
+
+bool FBattleSimCore::CheckGameOver() const
+{
+	return Hands[0].IsEmpty() && Hands[1].IsEmpty();
+}
+
+void FBattleSimCore::DetermineWinner()
+{
+	if (Scores[0] > Scores[1])
+	{
+		Winner = 0;
+	}
+	else if (Scores[1] > Scores[0])
+	{
+		Winner = 1;
+	}
+	else
+	{
+		Winner = -1;
+	}
+}
@@ -0,0 +1,138 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Card.h"
+#include "Sim/BattleTypes.h"
+#include "Sim/CardHand.h"
+#include "Sim/CardPowerTable.h"
+
+/**
+ * FBattleSimCore - 卡牌對戰的規則核心
+ * 純 C++ 值型別：手牌以位元遮罩 (FCardHand) 表示，分數、出牌歷史與回合狀態都存放在固定大小的陣列中，
+ * 不需要 UWorld、Tick 或任何 UObject，可直接複製並大量模擬整局遊戲。
+ * ACardBattle 的所有規則判定都委派給這裡，確保遊戲與模擬使用同一套規則。
+ */
+struct CARDGAME_API FBattleSimCore
+{
+public:
+	// 卡牌數值上限 (與 FCard::IsValid 一致)
+	static constexpr int32 MaxCardValue = FCardPowerTable::MaxCardValue;
+
+	// 每位玩家起手抽的牌數
+	static constexpr int32 HandSize = 10;
+
+	FBattleSimCore();
+
+	// 清空對戰狀態 (保留 Power 表)
+	void Reset();
+
+	// 設定卡牌數值表 (出牌時以 Power 加到分數上)；只保存共用表的參照，複製規則核心時不會複製整張表
+	void SetPowerTable(const FCardPowerTableRef& InPowerTable) { PowerTable = InPowerTable; }
+	const FCardPowerTable& GetPowerTable() const { return *PowerTable; }
+	const FCardPowerTableRef& GetSharedPowerTable() const { return PowerTable; }
+
+	// 獲取卡牌的 Power
+	int32 GetCardPower(int32 CardValue) const { return PowerTable->GetPower(CardValue); }
+
+	// 直接設定玩家手牌 (超過 HandSize 的部分、無效或重複的牌會被忽略)
+	void SetHand(int32 PlayerId, TConstArrayView<FCard> Cards);
+
+	// 預設牌組 (1-30，沒有 DataTable 時使用)
+	static void GetDefaultDeck(TArray<FCard>& OutCards);
+
+	// 從 DataTable 的 RowName 建立牌組：只收有效 (1-MaxCardValue) 且不重複的卡牌，最多 MaxCardValue 張
+	// (沒有可用的列時為空)。遊戲的 UCardDeck 與 DealHands 都用這份牌組，同一個種子才會發出相同的手牌
+	static void BuildDeck(const class UDataTable* DataTable, TArray<FCard>& OutCards);
+
+	// 同上，寫入呼叫端的空間 (最多 MaxCards 張，不配置記憶體)，回傳寫入的張數
+	static int32 BuildDeck(const class UDataTable* DataTable, FCard* OutCards, int32 MaxCards);
+
+	// 雙方各自以 DeckCards 的拷貝洗牌，並抽 HandSize 張作為手牌
+	void DealHands(TConstArrayView<FCard> DeckCards, FRandomStream& Random);
+
+	// 開始對戰，由 FirstPlayerId 先出牌
+	void Start(int32 FirstPlayerId);
+
+	// 玩家出牌 - CardIndex 為依 CardValue 排序後的手牌索引
+	// 成功時回傳打出的牌，不合法時回傳無效牌 (CardValue 0)
+	FCard PlayCard(int32 PlayerId, int32 CardIndex);
+
+	// 以卡牌數值出牌 (沒有持有該牌時回傳無效牌)
+	FCard PlayCardByValue(int32 PlayerId, int32 CardValue);
+
+	// 當前回合玩家從手牌隨機出一張
+	FCard PlayRandomCard(FRandomStream& Random);
+
+	// 以雙方隨機出牌跑完整局，回傳獲勝者 (-1 表示平手)
+	int32 RunRandomGame(FRandomStream& Random);
+
+	// 是否正在等待玩家出牌
+	bool IsWaitingForPlay() const
+	{
+		return State == EBattleState::WaitingForPlayer0 || State == EBattleState::WaitingForPlayer1;
+	}
+
+	EBattleState GetState() const { return State; }
+	int32 GetCurrentTurnPlayerId() const { return CurrentTurnPlayerId; }
+	int32 GetWinner() const { return Winner; }
+	const FRoundInfo& GetLastRoundInfo() const { return LastRoundInfo; }
+
+	int32 GetScore(int32 PlayerId) const { return Scores[PlayerId]; }
+	int32 GetHandNum(int32 PlayerId) const { return Hands[PlayerId].Num(); }
+	bool HasCards(int32 PlayerId) const { return !Hands[PlayerId].IsEmpty(); }
+	bool HasCard(int32 PlayerId, int32 CardValue) const { return Hands[PlayerId].Contains(CardValue); }
+
+	// 手牌 (依 CardValue 排序)
+	const FCardHand& GetHand(int32 PlayerId) const { return Hands[PlayerId]; }
+
+	TConstArrayView<FCard> GetPlayedCards(int32 PlayerId) const
+	{
+		return TConstArrayView<FCard>(PlayedCards[PlayerId], PlayedNum[PlayerId]);
+	}
+
+	FCard GetCurrentRoundCard(int32 PlayerId) const { return CurrentRoundCards[PlayerId]; }
+	bool HasPlayedThisRound(int32 PlayerId) const { return bCardPlayed[PlayerId]; }
+
+private:
+	// 進入下一個回合 (換另一位玩家先出)
+	void BeginNextRound();
+
+	// 雙方都出牌後記錄本回合結果
+	void ResolveRound();
+
+	// 打出一張已從手牌移除的牌 (加分、記錄與回合切換)
+	void CommitPlay(int32 PlayerId, FCard PlayedCard);
+
+	// 雙方都沒有手牌時遊戲結束
+	bool CheckGameOver() const;
+
+	// 依分數決定最終獲勝者
+	void DetermineWinner();
+
+	// CardValue -> Power / Range / 稀有度 (不可修改的共用表，所有複本共用同一份)
+	FCardPowerTableRef PowerTable;
+
+	// 雙方手牌
+	FCardHand Hands[2];
+
+	// 已出牌歷史記錄
+	FCard PlayedCards[2][HandSize];
+	int32 PlayedNum[2];
+
+	// 累計分數
+	int32 Scores[2];
+
+	// 本回合出牌
+	FCard CurrentRoundCards[2];
+	bool bCardPlayed[2];
+
+	EBattleState State;
+	int32 CurrentTurnPlayerId;
+
+	// 最終獲勝者 (-1 表示平手或遊戲未結束)
+	int32 Winner;
+
+	FRoundInfo LastRoundInfo;
+};
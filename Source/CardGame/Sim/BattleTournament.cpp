@@ -0,0 +1,255 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Sim/BattleTournament.h"
+#include "Engine/DataTable.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformTime.h"
+
+void FBattleTournamentStats::AddGame(const FBattleSimCore& Game)
+{
+	++NumGames;
+
+	const int32 Winner = Game.GetWinner();
+	if (Winner == 0 || Winner == 1)
+	{
+		++Wins[Winner];
+	}
+	else
+	{
+		++Draws;
+	}
+
+	for (int32 PlayerId = 0; PlayerId < 2; ++PlayerId)
+	{
+		const int32 Score = Game.GetScore(PlayerId);
+		ScoreSum[PlayerId] += Score;
+		ScoreSquaredSum[PlayerId] += (int64)Score * Score;
+		MinScore[PlayerId] = FMath::Min(MinScore[PlayerId], Score);
+		MaxScore[PlayerId] = FMath::Max(MaxScore[PlayerId], Score);
+
+		const int32 Bucket = FMath::Max(Score, 0);
+		TArray<int64>& Histogram = ScoreHistogram[PlayerId];
+		if (Bucket >= Histogram.Num())
+		{
+			Histogram.SetNumZeroed(Bucket + 1);
+		}
+		++Histogram[Bucket];
+	}
+}
+
+void FBattleTournamentStats::Merge(const FBattleTournamentStats& Other)
+{
+	NumGames += Other.NumGames;
+	Draws += Other.Draws;
+
+	for (int32 PlayerId = 0; PlayerId < 2; ++PlayerId)
+	{
+		Wins[PlayerId] += Other.Wins[PlayerId];
+		ScoreSum[PlayerId] += Other.ScoreSum[PlayerId];
+		ScoreSquaredSum[PlayerId] += Other.ScoreSquaredSum[PlayerId];
+		MinScore[PlayerId] = FMath::Min(MinScore[PlayerId], Other.MinScore[PlayerId]);
+		MaxScore[PlayerId] = FMath::Max(MaxScore[PlayerId], Other.MaxScore[PlayerId]);
+
+		TArray<int64>& Histogram = ScoreHistogram[PlayerId];
+		const TArray<int64>& OtherHistogram = Other.ScoreHistogram[PlayerId];
+		if (OtherHistogram.Num() > Histogram.Num())
+		{
+			Histogram.SetNumZeroed(OtherHistogram.Num());
+		}
+		for (int32 i = 0; i < OtherHistogram.Num(); ++i)
+		{
+			Histogram[i] += OtherHistogram[i];
+		}
+	}
+}
+
+double FBattleTournamentResult::GetWinRate(int32 PlayerId) const
+{
+	return Stats.NumGames > 0 ? (double)Stats.Wins[PlayerId] / (double)Stats.NumGames : 0.0;
+}
+
+double FBattleTournamentResult::GetDrawRate() const
+{
+	return Stats.NumGames > 0 ? (double)Stats.Draws / (double)Stats.NumGames : 0.0;
+}
+
+double FBattleTournamentResult::GetMeanScore(int32 PlayerId) const
+{
+	return Stats.NumGames > 0 ? (double)Stats.ScoreSum[PlayerId] / (double)Stats.NumGames : 0.0;
+}
+
+double FBattleTournamentResult::GetScoreStdDev(int32 PlayerId) const
+{
+	if (Stats.NumGames <= 0)
+	{
+		return 0.0;
+	}
+
+	const double Mean = GetMeanScore(PlayerId);
+	const double Variance = (double)Stats.ScoreSquaredSum[PlayerId] / (double)Stats.NumGames - Mean * Mean;
+	return FMath::Sqrt(FMath::Max(Variance, 0.0));
+}
+
+int32 FBattleTournamentResult::GetScorePercentile(int32 PlayerId, double Fraction) const
+{
+	const TArray<int64>& Histogram = Stats.ScoreHistogram[PlayerId];
+
+	int64 Total = 0;
+	for (int64 Count : Histogram)
+	{
+		Total += Count;
+	}
+
+	if (Total <= 0)
+	{
+		return 0;
+	}
+
+	// 第 Rank 筆 (由 0 起算) 落在哪個分數
+	const int64 Rank = FMath::Clamp((int64)(Fraction * (double)(Total - 1)), (int64)0, Total - 1);
+	int64 Cumulative = 0;
+	for (int32 Score = 0; Score < Histogram.Num(); ++Score)
+	{
+		Cumulative += Histogram[Score];
+		if (Cumulative > Rank)
+		{
+			return Score;
+		}
+	}
+
+	return Histogram.Num() - 1;
+}
+
+double FBattleTournamentResult::GetGamesPerSecond() const
+{
+	return ElapsedSeconds > 0.0 ? (double)Stats.NumGames / ElapsedSeconds : 0.0;
+}
+
+void FBattleTournamentResult::LogScoreHistogram(int32 PlayerId) const
+{
+	const TArray<int64>& Histogram = Stats.ScoreHistogram[PlayerId];
+	if (Histogram.Num() == 0)
+	{
+		return;
+	}
+
+	// 從最低分到最高分分成固定數量的區間，以長條顯示比例
+	const int32 FirstScore = FMath::Clamp(Stats.MinScore[PlayerId], 0, Histogram.Num() - 1);
+	const int32 LastScore = Histogram.Num() - 1;
+	const int32 BucketWidth = FMath::Max(FMath::DivideAndRoundUp(LastScore - FirstScore + 1, HistogramBuckets), 1);
+	constexpr int32 MaxBarLength = 40;
+
+	TArray<int64, TInlineAllocator<HistogramBuckets>> BucketCounts;
+	int64 MaxCount = 1;
+	for (int32 BucketStart = FirstScore; BucketStart <= LastScore; BucketStart += BucketWidth)
+	{
+		int64 Count = 0;
+		for (int32 Score = BucketStart; Score <= FMath::Min(BucketStart + BucketWidth - 1, LastScore); ++Score)
+		{
+			Count += Histogram[Score];
+		}
+		BucketCounts.Add(Count);
+		MaxCount = FMath::Max(MaxCount, Count);
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("Player %d score distribution:"), PlayerId);
+	for (int32 Bucket = 0; Bucket < BucketCounts.Num(); ++Bucket)
+	{
+		const int32 BucketStart = FirstScore + Bucket * BucketWidth;
+		const int32 BucketEnd = FMath::Min(BucketStart + BucketWidth - 1, LastScore);
+		const int32 BarLength = (int32)((BucketCounts[Bucket] * MaxBarLength + MaxCount - 1) / MaxCount);
+
+		UE_LOG(LogTemp, Display, TEXT("  %4d - %4d: %6.2f%% %s"),
+			BucketStart, BucketEnd, (double)BucketCounts[Bucket] * 100.0 / (double)Stats.NumGames, *FString::ChrN(BarLength, TEXT('#')));
+	}
+}
+
+void FBattleTournamentResult::LogReport() const
+{
+	UE_LOG(LogTemp, Display, TEXT("========== TOURNAMENT RESULT =========="));
+	UE_LOG(LogTemp, Display, TEXT("Games: %lld in %.3f s (%.0f games/s)"), Stats.NumGames, ElapsedSeconds, GetGamesPerSecond());
+	UE_LOG(LogTemp, Display, TEXT("Player 0 wins: %.2f%%, Player 1 wins: %.2f%%, Draws: %.2f%%"),
+		GetWinRate(0) * 100.0, GetWinRate(1) * 100.0, GetDrawRate() * 100.0);
+
+	for (int32 PlayerId = 0; PlayerId < 2; ++PlayerId)
+	{
+		if (Stats.NumGames > 0)
+		{
+			UE_LOG(LogTemp, Display, TEXT("Player %d score: mean %.2f, stddev %.2f, min %d, max %d"),
+				PlayerId, GetMeanScore(PlayerId), GetScoreStdDev(PlayerId), Stats.MinScore[PlayerId], Stats.MaxScore[PlayerId]);
+			UE_LOG(LogTemp, Display, TEXT("Player %d score percentiles: p10 %d, p25 %d, p50 %d, p75 %d, p90 %d, p99 %d"),
+				PlayerId, GetScorePercentile(PlayerId, 0.1), GetScorePercentile(PlayerId, 0.25), GetScorePercentile(PlayerId, 0.5),
+				GetScorePercentile(PlayerId, 0.75), GetScorePercentile(PlayerId, 0.9), GetScorePercentile(PlayerId, 0.99));
+			LogScoreHistogram(PlayerId);
+		}
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("======================================="));
+}
+
+FBattleTournamentResult FBattleTournament::Run(const FBattleTournamentSettings& Settings)
+{
+	FBattleTournamentResult Result;
+
+	const int32 NumGames = FMath::Max(Settings.NumGames, 0);
+	const int32 GamesPerBatch = FMath::Max(Settings.GamesPerBatch, 1);
+	const int32 NumBatches = FMath::DivideAndRoundUp(NumGames, GamesPerBatch);
+
+	// 沒有指定牌組時使用 1-30
+	TArray<FCard> DefaultDeck;
+	TConstArrayView<FCard> DeckCards = Settings.DeckCards;
+	if (DeckCards.Num() == 0)
+	{
+		FBattleSimCore::GetDefaultDeck(DefaultDeck);
+		DeckCards = DefaultDeck;
+	}
+
+	TArray<FBattleTournamentStats> BatchStats;
+	BatchStats.SetNum(NumBatches);
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	ParallelFor(NumBatches, [&](int32 BatchIndex)
+	{
+		// 每個批次有自己的亂數流，種子只與 Seed 和批次索引有關
+		FRandomStream Random((int32)HashCombine(GetTypeHash(Settings.Seed), GetTypeHash(BatchIndex)));
+		FBattleTournamentStats LocalStats;
+		FBattleSimCore Game = Settings.Prototype;
+
+		const int32 FirstGame = BatchIndex * GamesPerBatch;
+		const int32 LastGame = FMath::Min(FirstGame + GamesPerBatch, NumGames);
+		for (int32 GameIndex = FirstGame; GameIndex < LastGame; ++GameIndex)
+		{
+			Game.Reset();
+			Game.DealHands(DeckCards, Random);
+			Game.Start(Random.RandRange(0, 1));
+			Game.RunRandomGame(Random);
+			LocalStats.AddGame(Game);
+		}
+
+		BatchStats[BatchIndex] = MoveTemp(LocalStats);
+	});
+
+	Result.ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+
+	for (const FBattleTournamentStats& Stats : BatchStats)
+	{
+		Result.Stats.Merge(Stats);
+	}
+
+	return Result;
+}
+
+void FBattleTournament::ConfigureFromDataTable(FBattleTournamentSettings& Settings, const UDataTable* DataTable)
+{
+	if (!DataTable)
+	{
+		return;
+	}
+
+	TSharedRef<FCardPowerTable, ESPMode::ThreadSafe> PowerTable = MakeShared<FCardPowerTable, ESPMode::ThreadSafe>();
+	PowerTable->Build(DataTable);
+	Settings.Prototype.SetPowerTable(PowerTable);
+
+	FBattleSimCore::BuildDeck(DataTable, Settings.DeckCards);
+}
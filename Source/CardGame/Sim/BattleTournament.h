@@ -0,0 +1,96 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Card.h"
+#include "Sim/BattleSimCore.h"
+
+/**
+ * FBattleTournamentSettings - 批次模擬設定
+ */
+struct CARDGAME_API FBattleTournamentSettings
+{
+	// 要模擬的局數
+	int32 NumGames = 10000;
+
+	// 亂數種子 (同一種子與設定會得到相同結果，與執行緒數量無關)
+	int32 Seed = 0;
+
+	// 每個工作批次的局數 (每批次有自己的亂數流與統計)
+	int32 GamesPerBatch = 4096;
+
+	// 已設定好 Power 的規則核心，每局都從它複製
+	FBattleSimCore Prototype;
+
+	// 牌組內容 (為空時使用 1-30)
+	TArray<FCard> DeckCards;
+};
+
+/**
+ * FBattleTournamentStats - 模擬結果累計
+ * 每個批次在自己的堆疊上累計，最後再合併，避免執行緒間共用寫入
+ */
+struct CARDGAME_API FBattleTournamentStats
+{
+	int64 NumGames = 0;
+	int64 Wins[2] = { 0, 0 };
+	int64 Draws = 0;
+
+	// 分數統計
+	int64 ScoreSum[2] = { 0, 0 };
+	int64 ScoreSquaredSum[2] = { 0, 0 };
+	int32 MinScore[2] = { MAX_int32, MAX_int32 };
+	int32 MaxScore[2] = { MIN_int32, MIN_int32 };
+
+	// 分數分佈 (索引為分數，負分計入 0)
+	TArray<int64> ScoreHistogram[2];
+
+	// 記錄一局結束後的結果
+	void AddGame(const FBattleSimCore& Game);
+
+	// 合併另一份統計
+	void Merge(const FBattleTournamentStats& Other);
+};
+
+/**
+ * FBattleTournamentResult - 模擬報告
+ */
+struct CARDGAME_API FBattleTournamentResult
+{
+	FBattleTournamentStats Stats;
+
+	// 實際耗時 (秒)
+	double ElapsedSeconds = 0.0;
+
+	double GetWinRate(int32 PlayerId) const;
+	double GetDrawRate() const;
+	double GetMeanScore(int32 PlayerId) const;
+	double GetScoreStdDev(int32 PlayerId) const;
+
+	// 由分數分佈計算百分位數 (Fraction 0-1；沒有資料時為 0)
+	int32 GetScorePercentile(int32 PlayerId, double Fraction) const;
+	double GetGamesPerSecond() const;
+
+	// 輸出到日誌
+	void LogReport() const;
+
+	// 分數分佈在日誌中分成的區間數
+	static constexpr int32 HistogramBuckets = 12;
+
+private:
+	void LogScoreHistogram(int32 PlayerId) const;
+};
+
+/**
+ * FBattleTournament - 多執行緒 Monte Carlo 對戰模擬
+ * 以 ParallelFor 將局數分成固定大小的批次，雙方都使用隨機出牌策略
+ */
+struct CARDGAME_API FBattleTournament
+{
+	// 執行模擬
+	static FBattleTournamentResult Run(const FBattleTournamentSettings& Settings);
+
+	// 從卡牌 DataTable 設定牌組與 Power (與 ACardBattle 的規則一致)
+	static void ConfigureFromDataTable(FBattleTournamentSettings& Settings, const class UDataTable* DataTable);
+};
@@ -0,0 +1,168 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Sim/BattleTrace.h"
+#include "Sim/BattleAction.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/OutputDeviceRedirector.h"
+
+int32 FBattleTrace::CategoryMask = (1 << (int32)EBattleTraceCategory::Count) - 1;
+int32 FBattleTrace::bEchoToLog = 0;
+FBattleTraceRecord FBattleTrace::Records[FBattleTrace::Capacity];
+std::atomic<uint32> FBattleTrace::WriteIndex{ 0 };
+
+// 直接綁定靜態變數，熱路徑讀取時不經過 Console Manager
+static FAutoConsoleVariableRef CVarBattleTraceMask(
+	TEXT("CardGame.Trace.Mask"),
+	FBattleTrace::CategoryMask,
+	TEXT("Battle trace category mask. Bits: 1 = Match, 2 = Play, 4 = Turn, 8 = AI, 16 = UI (default: all)."));
+
+static FAutoConsoleVariableRef CVarBattleTraceEcho(
+	TEXT("CardGame.Trace.Echo"),
+	FBattleTrace::bEchoToLog,
+	TEXT("If non-zero, also format every recorded battle trace event to the log immediately (development only)."));
+
+static FAutoConsoleCommandWithArgs GBattleTraceDumpCommand(
+	TEXT("CardGame.TraceDump"),
+	TEXT("Print the most recent battle trace events. Usage: CardGame.TraceDump [Count=64]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		FBattleTrace::DumpToLog(Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 64);
+	}));
+
+namespace BattleTrace
+{
+	static const TCHAR* GetActionDescription(int32 Source)
+	{
+		switch ((EBattleActionSource)Source)
+		{
+		case EBattleActionSource::AI:		return TEXT("(AI) played");
+		case EBattleActionSource::Timeout:	return TEXT("auto-played");
+		case EBattleActionSource::Network:	return TEXT("(remote) played");
+		default:							return TEXT("played");
+		}
+	}
+}
+
+void FBattleTrace::Write(EBattleTraceEvent Event, int32 Arg0, int32 Arg1, int32 Arg2, int32 Arg3, int32 Arg4)
+{
+	const uint32 Slot = WriteIndex.fetch_add(1, std::memory_order_relaxed) & (Capacity - 1);
+
+	FBattleTraceRecord& Record = Records[Slot];
+	Record.Cycles = FPlatformTime::Cycles64();
+	Record.Event = Event;
+	Record.Args[0] = Arg0;
+	Record.Args[1] = Arg1;
+	Record.Args[2] = Arg2;
+	Record.Args[3] = Arg3;
+	Record.Args[4] = Arg4;
+
+	if (bEchoToLog != 0)
+	{
+		UE_LOG(LogTemp, Display, TEXT("[Trace] %s"), *FormatRecord(Record));
+	}
+}
+
+void FBattleTrace::CopyRecent(int32 MaxEvents, TArray<FBattleTraceRecord>& OutRecords)
+{
+	const uint32 End = WriteIndex.load(std::memory_order_relaxed);
+	const uint32 Count = FMath::Min3(End, Capacity, (uint32)FMath::Max(MaxEvents, 0));
+
+	OutRecords.Reset(Count);
+	for (uint32 Index = End - Count; Index != End; ++Index)
+	{
+		OutRecords.Add(Records[Index & (Capacity - 1)]);
+	}
+}
+
+const TCHAR* FBattleTrace::GetCategoryName(EBattleTraceCategory Category)
+{
+	switch (Category)
+	{
+	case EBattleTraceCategory::Match:	return TEXT("Match");
+	case EBattleTraceCategory::Play:	return TEXT("Play");
+	case EBattleTraceCategory::Turn:	return TEXT("Turn");
+	case EBattleTraceCategory::AI:		return TEXT("AI");
+	case EBattleTraceCategory::UI:		return TEXT("UI");
+	default:							return TEXT("?");
+	}
+}
+
+FString FBattleTrace::FormatRecord(const FBattleTraceRecord& Record)
+{
+	const int32* A = Record.Args;
+
+	switch (Record.Event)
+	{
+	case EBattleTraceEvent::MatchStarted:
+		return FString::Printf(TEXT("Match seed: %d"), A[0]);
+	case EBattleTraceEvent::HandsDealt:
+		return FString::Printf(TEXT("Game initialized. Player 0 hand size: %d, Player 1 hand size: %d"), A[0], A[1]);
+	case EBattleTraceEvent::FirstPlayer:
+		return FString::Printf(TEXT("Player %d goes first"), A[0]);
+	case EBattleTraceEvent::GameOver:
+		return A[2] >= 0
+			? FString::Printf(TEXT("Final scores - Player 0: %d, Player 1: %d. Player %d wins the game!"), A[0], A[1], A[2])
+			: FString::Printf(TEXT("Final scores - Player 0: %d, Player 1: %d. Game is a draw!"), A[0], A[1]);
+	case EBattleTraceEvent::CardCommitted:
+		return FString::Printf(TEXT("Player %d %s %d (Power: %d), score now: %d"), A[0], BattleTrace::GetActionDescription(A[1]), A[2], A[3], A[4]);
+	case EBattleTraceEvent::ActionRejected:
+		return FString::Printf(TEXT("Player %d action rejected (%s %d, source %d): not their turn or card not in hand"),
+			A[0], (EBattleActionType)A[1] == EBattleActionType::PlayRandom ? TEXT("random card") : TEXT("card"), A[2], A[3]);
+	case EBattleTraceEvent::InvalidCardIndex:
+		return FString::Printf(TEXT("Invalid card index %d for player %d"), A[1], A[0]);
+	case EBattleTraceEvent::RoundResolved:
+		return FString::Printf(TEXT("Round completed: Player0 played %d, Player1 played %d. Scores - Player 0: %d, Player 1: %d"), A[0], A[1], A[2], A[3]);
+	case EBattleTraceEvent::TurnTimeout:
+		return FString::Printf(TEXT("Player %d time's up, system plays random card"), A[0]);
+	case EBattleTraceEvent::AIRequested:
+		return FString::Printf(TEXT("AI (Player 1) plays a card (AI type %d)"), A[0]);
+	case EBattleTraceEvent::AISearchDone:
+		return FString::Printf(TEXT("AI search: card %d, expected delta %.2f, depth %d%s, %d nodes, %.3f ms"),
+			A[0], A[1] / 100.0, A[2] >> 1, (A[2] & 1) != 0 ? TEXT(" (exact)") : TEXT(""), A[3], A[4] / 1000.0);
+	case EBattleTraceEvent::AIMCTSDone:
+		return FString::Printf(TEXT("AI ISMCTS: card %d, win rate %.3f, %d playouts in %d slices, %.3f ms"),
+			A[0], A[1] / 1000.0, A[2], A[3], A[4] / 1000.0);
+	case EBattleTraceEvent::CardWidgetBound:
+		return FString::Printf(TEXT("CardWidget: ClickButton bound (index %d)"), A[0]);
+	case EBattleTraceEvent::CardClicked:
+		return A[1] != 0
+			? FString::Printf(TEXT("CardWidget: Clicked! Index: %d"), A[0])
+			: FString::Printf(TEXT("CardWidget: Clicked but no delegate bound! Index: %d"), A[0]);
+	case EBattleTraceEvent::CardArtMissing:
+		return FString::Printf(TEXT("CardWidget: CardData.CardImage is NULL for card %d"), A[0]);
+	case EBattleTraceEvent::CardResized:
+		return FString::Printf(TEXT("CardWidget: %s SizeBox set to %dx%d"), A[2] != 0 ? TEXT("Inner") : TEXT("Outer"), A[0], A[1]);
+	default:
+		return FString::Printf(TEXT("Unknown event %d"), (int32)Record.Event);
+	}
+}
+
+void FBattleTrace::DumpToLog(int32 MaxEvents)
+{
+	TArray<FBattleTraceRecord> Recent;
+	CopyRecent(MaxEvents, Recent);
+
+	// 時間以輸出當下為基準 (負值表示多久以前)
+	const uint64 Now = FPlatformTime::Cycles64();
+
+	UE_LOG(LogTemp, Display, TEXT("========== BATTLE TRACE (last %d of %u events) =========="), Recent.Num(), WriteIndex.load(std::memory_order_relaxed));
+	for (const FBattleTraceRecord& Record : Recent)
+	{
+		UE_LOG(LogTemp, Display, TEXT("[%9.3f s] %-5s %s"),
+			-FPlatformTime::ToSeconds64(Now - Record.Cycles), GetCategoryName(GetCategory(Record.Event)), *FormatRecord(Record));
+	}
+	UE_LOG(LogTemp, Display, TEXT("=========================================================="));
+}
+
+void FBattleTrace::DumpOnCrash()
+{
+	// 崩潰時其他執行緒可能還在寫入，個別紀錄有可能不完整，只作為線索
+	UE_LOG(LogTemp, Error, TEXT("Dumping the last %d battle trace events"), CrashDumpCount);
+	DumpToLog(CrashDumpCount);
+
+	if (GLog)
+	{
+		GLog->Flush();
+	}
+}
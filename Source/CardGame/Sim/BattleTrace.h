@@ -0,0 +1,130 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+/**
+ * EBattleTraceCategory - 事件分類 (CardGame.Trace.Mask 的位元)
+ */
+enum class EBattleTraceCategory : uint8
+{
+	Match,		// 開局、發牌、結束
+	Play,		// 出牌與指令
+	Turn,		// 回合計時
+	AI,			// AI 請求與搜尋結果
+	UI,			// 卡牌元件
+	Count
+};
+
+/**
+ * EBattleTraceEvent - 事件種類 (參數的意義見 FBattleTrace::FormatRecord)
+ */
+enum class EBattleTraceEvent : uint8
+{
+	// Match
+	MatchStarted,		// Seed
+	HandsDealt,			// Hand0Num, Hand1Num
+	FirstPlayer,		// PlayerId
+	GameOver,			// Score0, Score1, Winner
+
+	// Play
+	CardCommitted,		// PlayerId, EBattleActionSource, CardValue, Power, Score
+	ActionRejected,		// PlayerId, EBattleActionType, CardValue, EBattleActionSource
+	InvalidCardIndex,	// PlayerId, CardIndex
+	RoundResolved,		// Card0, Card1, Score0, Score1
+
+	// Turn
+	TurnTimeout,		// PlayerId
+
+	// AI
+	AIRequested,		// EBattleAIType
+	AISearchDone,		// CardValue, ExpectedDelta x100, Depth * 2 + bExact, Nodes, Microseconds
+	AIMCTSDone,			// CardValue, WinRate x1000, Playouts, Slices, Microseconds
+
+	// UI
+	CardWidgetBound,	// CardIndex
+	CardClicked,		// CardIndex, bBound
+	CardArtMissing,		// CardValue
+	CardResized,		// Width, Height, bInner
+
+	Count
+};
+
+/**
+ * FBattleTraceRecord - 固定 32 bytes 的事件紀錄，只存數值，輸出時才格式化
+ */
+struct FBattleTraceRecord
+{
+	uint64 Cycles = 0;
+	EBattleTraceEvent Event = EBattleTraceEvent::Count;
+	uint8 Reserved[3] = { 0, 0, 0 };
+	int32 Args[5] = { 0, 0, 0, 0, 0 };
+};
+static_assert(sizeof(FBattleTraceRecord) == 32, "FBattleTraceRecord should stay one half cache line");
+
+/**
+ * FBattleTrace - 取代對戰流程中 UE_LOG 的二進位環狀事件紀錄
+ * 寫入只有一次遮罩判斷、一次原子遞增與 32 bytes 的存放，不做字串格式化也不碰日誌 I/O；
+ * 最近 Capacity 筆事件在 CardGame.TraceDump 或程式崩潰時才格式化輸出。
+ * 多條執行緒可以同時寫入；環狀緩衝被追上時最舊的紀錄直接覆蓋。
+ */
+struct CARDGAME_API FBattleTrace
+{
+	// 保留的事件數 (2 的次方)
+	static constexpr uint32 Capacity = 4096;
+
+	// 崩潰時輸出的事件數
+	static constexpr int32 CrashDumpCount = 256;
+
+	// 事件所屬的分類
+	static constexpr EBattleTraceCategory GetCategory(EBattleTraceEvent Event)
+	{
+		return Event <= EBattleTraceEvent::GameOver ? EBattleTraceCategory::Match
+			: Event <= EBattleTraceEvent::RoundResolved ? EBattleTraceCategory::Play
+			: Event <= EBattleTraceEvent::TurnTimeout ? EBattleTraceCategory::Turn
+			: Event <= EBattleTraceEvent::AIMCTSDone ? EBattleTraceCategory::AI
+			: EBattleTraceCategory::UI;
+	}
+
+	static bool IsEnabled(EBattleTraceCategory Category)
+	{
+		return ((uint32)CategoryMask & (1u << (uint32)Category)) != 0;
+	}
+
+	// 記錄一個事件 (分類被關閉時只有一次位元判斷)
+	static FORCEINLINE void Record(EBattleTraceEvent Event, int32 Arg0 = 0, int32 Arg1 = 0, int32 Arg2 = 0, int32 Arg3 = 0, int32 Arg4 = 0)
+	{
+		if (IsEnabled(GetCategory(Event)))
+		{
+			Write(Event, Arg0, Arg1, Arg2, Arg3, Arg4);
+		}
+	}
+
+	// 由舊到新複製最近 MaxEvents 筆事件
+	static void CopyRecent(int32 MaxEvents, TArray<FBattleTraceRecord>& OutRecords);
+
+	// 將一筆事件轉成文字
+	static FString FormatRecord(const FBattleTraceRecord& Record);
+
+	// 將最近 MaxEvents 筆事件輸出到日誌
+	static void DumpToLog(int32 MaxEvents);
+
+	// 程式崩潰時輸出最近的事件 (由 CardGame 模組註冊到 FCoreDelegates::OnHandleSystemError)
+	static void DumpOnCrash();
+
+	static const TCHAR* GetCategoryName(EBattleTraceCategory Category);
+
+	// 分類遮罩 (CardGame.Trace.Mask)
+	static int32 CategoryMask;
+
+	// 非 0 時每個事件同時格式化輸出到日誌 (CardGame.Trace.Echo，開發時使用)
+	static int32 bEchoToLog;
+
+private:
+	static void Write(EBattleTraceEvent Event, int32 Arg0, int32 Arg1, int32 Arg2, int32 Arg3, int32 Arg4);
+
+	static FBattleTraceRecord Records[Capacity];
+	static std::atomic<uint32> WriteIndex;
+};
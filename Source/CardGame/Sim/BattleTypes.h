@@ -0,0 +1,44 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Card.h"
+#include "BattleTypes.generated.h"
+
+
+// 遊戲狀態枚舉
+UENUM(BlueprintType)
+enum class EBattleState : uint8
+{
+	Idle = 0,			// 空閒
+	Started = 1,		// 遊戲已開始
+	WaitingForPlayer0 = 2,	// 等待玩家0出牌
+	WaitingForPlayer1 = 3,	// 等待玩家1出牌
+	RoundEnd = 4,		// 回合結束
+	GameOver = 5		// 遊戲結束
+};
+
+// 回合信息
+USTRUCT(BlueprintType)
+struct FRoundInfo
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(BlueprintReadWrite)
+	FCard Player0Card;
+
+	UPROPERTY(BlueprintReadWrite)
+	FCard Player1Card;
+
+	UPROPERTY(BlueprintReadWrite)
+	int32 WinnerID; // 0, 1 或 -1 (平手)
+
+	FRoundInfo()
+		: Player0Card(FCard(0))
+		, Player1Card(FCard(0))
+		, WinnerID(-1)
+	{
+	}
+};
@@ -0,0 +1,132 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Card.h"
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+/**
+ * FCardHand - 以位元遮罩表示的手牌
+ * CardValue 1-30 各佔一個位元 (第 CardValue 位)，同一張牌最多一張。
+ * 加入、移除、查詢都是 O(1)，手牌數量是 popcount；
+ * 「第 i 張牌」依 CardValue 由小到大排序，供出牌索引與 UI 顯示使用。
+ */
+struct FCardHand
+{
+public:
+	// 可放入的最大卡牌數值 (與 FCard::IsValid 一致)
+	static constexpr int32 MaxCardValue = 30;
+
+	FCardHand() = default;
+
+	// 清空手牌
+	void Reset() { Bits = 0; }
+
+	// 加入一張牌 (無效或已持有的牌會被忽略)，回傳是否成功加入
+	bool Add(int32 CardValue)
+	{
+		if (CardValue < 1 || CardValue > MaxCardValue || Contains(CardValue))
+		{
+			return false;
+		}
+
+		Bits |= 1u << CardValue;
+		return true;
+	}
+
+	// 移除一張牌，回傳是否持有該牌
+	bool Remove(int32 CardValue)
+	{
+		if (!Contains(CardValue))
+		{
+			return false;
+		}
+
+		Bits &= ~(1u << CardValue);
+		return true;
+	}
+
+	// 是否持有該牌
+	bool Contains(int32 CardValue) const
+	{
+		return CardValue >= 1 && CardValue <= MaxCardValue && (Bits & (1u << CardValue)) != 0;
+	}
+
+	// 手牌數量
+	int32 Num() const { return (int32)FMath::CountBits(Bits); }
+
+	bool IsEmpty() const { return Bits == 0; }
+
+	// 依 CardValue 由小到大的第 Index 張牌 (超出範圍時回傳無效牌)
+	FCard GetCard(int32 Index) const
+	{
+		if (Index < 0 || Index >= Num())
+		{
+			return FCard(0);
+		}
+
+		return FCard((int32)FMath::CountTrailingZeros(SelectBit(Index)));
+	}
+
+	// 該牌在排序後手牌中的索引 (沒有持有時回傳 INDEX_NONE)
+	int32 IndexOf(int32 CardValue) const
+	{
+		if (!Contains(CardValue))
+		{
+			return INDEX_NONE;
+		}
+
+		return (int32)FMath::CountBits(Bits & ((1u << CardValue) - 1u));
+	}
+
+	// 移除並回傳排序後的第 Index 張牌 (超出範圍時回傳無效牌)
+	FCard RemoveAt(int32 Index)
+	{
+		const FCard Card = GetCard(Index);
+		if (Card.IsValid())
+		{
+			Bits &= ~(1u << Card.CardValue);
+		}
+		return Card;
+	}
+
+	// 依排序寫出手牌，回傳寫入的張數 (OutCards 至少要有 Num() 格)
+	int32 CopyTo(FCard* OutCards) const
+	{
+		int32 Count = 0;
+		for (uint32 Remaining = Bits; Remaining != 0; Remaining &= Remaining - 1u)
+		{
+			OutCards[Count++] = FCard((int32)FMath::CountTrailingZeros(Remaining));
+		}
+		return Count;
+	}
+
+	// 原始位元 (第 CardValue 位表示持有該牌)
+	uint32 GetBits() const { return Bits; }
+
+	bool operator==(const FCardHand& Other) const { return Bits == Other.Bits; }
+	bool operator!=(const FCardHand& Other) const { return Bits != Other.Bits; }
+
+private:
+	// 取出第 Index 個為 1 的位元 (只保留該位元)
+	uint32 SelectBit(int32 Index) const
+	{
+#if defined(__BMI2__)
+		return _pdep_u32(1u << Index, Bits);
+#else
+		// 手牌最多十幾張，逐一清掉最低位元即可
+		uint32 Remaining = Bits;
+		for (int32 i = 0; i < Index; ++i)
+		{
+			Remaining &= Remaining - 1u;
+		}
+		return Remaining & (~Remaining + 1u);
+#endif
+	}
+
+	uint32 Bits = 0;
+};
@@ -0,0 +1,83 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Sim/CardPowerTable.h"
+#include "Data/DT_CardData.h"
+#include "Engine/DataTable.h"
+
+FCardPowerTable::FCardPowerTable()
+{
+	for (int32 i = 0; i < NumEntries; ++i)
+	{
+		Power[i] = i <= MaxCardValue ? i : 0;
+		Range[i] = 0.0f;
+		Rarity[i] = ECardRarity::Common;
+	}
+}
+
+const FCardPowerTableRef& FCardPowerTable::GetDefault()
+{
+	static const FCardPowerTableRef DefaultTable = MakeShared<const FCardPowerTable, ESPMode::ThreadSafe>();
+	return DefaultTable;
+}
+
+void FCardPowerTable::Build(const UDataTable* DataTable)
+{
+	*this = FCardPowerTable();
+
+	if (!DataTable || !DataTable->GetRowStruct() || !DataTable->GetRowStruct()->IsChildOf(FCardData::StaticStruct()))
+	{
+		return;
+	}
+
+	// 有 DataTable 時，找不到資料的卡牌 Power 為 0
+	for (int32 i = 0; i < NumEntries; ++i)
+	{
+		Power[i] = 0;
+	}
+
+	for (const TPair<FName, uint8*>& Row : DataTable->GetRowMap())
+	{
+		// RowName 就是 CardValue 的字串形式
+		const FString RowString = Row.Key.ToString();
+		if (!RowString.IsNumeric())
+		{
+			continue;
+		}
+
+		const int32 CardValue = FCString::Atoi(*RowString);
+		if (CardValue < 0 || CardValue > MaxCardValue)
+		{
+			continue;
+		}
+
+		const FCardData* CardData = reinterpret_cast<const FCardData*>(Row.Value);
+		Power[CardValue] = CardData->Power;
+		Range[CardValue] = CardData->Range;
+		Rarity[CardValue] = ParseRarity(CardData->Rare);
+	}
+}
+
+void FCardPowerTable::SetPower(int32 CardValue, int32 InPower)
+{
+	if (CardValue >= 0 && CardValue <= MaxCardValue)
+	{
+		Power[CardValue] = InPower;
+	}
+}
+
+ECardRarity FCardPowerTable::ParseRarity(const FString& RarityString)
+{
+	if (RarityString.Equals(TEXT("Legendary"), ESearchCase::IgnoreCase))
+	{
+		return ECardRarity::Legendary;
+	}
+	if (RarityString.Equals(TEXT("Epic"), ESearchCase::IgnoreCase))
+	{
+		return ECardRarity::Epic;
+	}
+	if (RarityString.Equals(TEXT("Rare"), ESearchCase::IgnoreCase))
+	{
+		return ECardRarity::Rare;
+	}
+	return ECardRarity::Common;
+}
@@ -0,0 +1,65 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// 卡牌稀有度 (由 FCardData::Rare 字串編譯而來)
+enum class ECardRarity : uint8
+{
+	Common = 0,
+	Rare = 1,
+	Epic = 2,
+	Legendary = 3
+};
+
+/**
+ * FCardPowerTable - 編譯後的卡牌數值表
+ * 在 InitializeGame 時由 DataTable 建立，以 CardValue 直接索引。
+ * 欄位以 SoA 方式排列並對齊 cache line，規則計算只會碰到 Power 陣列 (兩條 cache line)，
+ * 每次查詢都是一次陣列讀取，不需要 FName 或 FindRow。
+ */
+struct alignas(PLATFORM_CACHE_LINE_SIZE) FCardPowerTable
+{
+public:
+	// 卡牌數值上限 (與 FCard::IsValid 一致)
+	static constexpr int32 MaxCardValue = 30;
+
+	// 表格大小；最後一格是超出範圍時使用的哨兵 (Power 0)
+	static constexpr int32 NumEntries = 32;
+	static constexpr int32 InvalidIndex = NumEntries - 1;
+
+	// 建立預設表 (沒有 DataTable 時 Power 等於 CardValue)
+	FCardPowerTable();
+
+	// 從卡牌 DataTable 重新建立 (DataTable 中找不到的卡牌 Power 為 0)
+	void Build(const class UDataTable* DataTable);
+
+	// 設定單張卡牌的 Power
+	void SetPower(int32 CardValue, int32 InPower);
+
+	int32 GetPower(int32 CardValue) const { return Power[ToIndex(CardValue)]; }
+	float GetRange(int32 CardValue) const { return Range[ToIndex(CardValue)]; }
+	ECardRarity GetRarity(int32 CardValue) const { return Rarity[ToIndex(CardValue)]; }
+
+	// 將稀有度字串轉換為枚舉
+	static ECardRarity ParseRarity(const FString& RarityString);
+
+	// 預設表的共用實例 (沒有設定數值表的規則核心都參照這一份)
+	static const TSharedRef<const FCardPowerTable, ESPMode::ThreadSafe>& GetDefault();
+
+private:
+	// 超出範圍的數值 (含負數) 都映射到哨兵格，不需要分支
+	static uint32 ToIndex(int32 CardValue)
+	{
+		return FMath::Min((uint32)CardValue, (uint32)InvalidIndex);
+	}
+
+	int32 Power[NumEntries];
+	float Range[NumEntries];
+	ECardRarity Rarity[NumEntries];
+};
+
+// 共用且不可修改的數值表：由 UCardCatalogSubsystem 擁有，規則核心的所有複本 (對戰主機、AI 工作) 都參照同一份，
+// 資料表重建時換成新的一份，舊的在最後一個參照釋放時刪除
+using FCardPowerTableRef = TSharedRef<const FCardPowerTable, ESPMode::ThreadSafe>;
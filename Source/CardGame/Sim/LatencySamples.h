@@ -0,0 +1,84 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * FLatencySamples - 保留最近 N 筆延遲並計算百分位數
+ * 固定容量的環狀緩衝區，記錄時不配置記憶體
+ */
+struct FLatencySamples
+{
+	// 保留的筆數
+	static constexpr int32 Capacity = 1024;
+
+	// 記錄一筆延遲 (秒)
+	void Add(double Seconds)
+	{
+		Samples[NextIndex] = (float)Seconds;
+		NextIndex = (NextIndex + 1) % Capacity;
+		NumSamples = FMath::Min(NumSamples + 1, Capacity);
+		++TotalSamples;
+	}
+
+	void Reset()
+	{
+		NextIndex = 0;
+		NumSamples = 0;
+		TotalSamples = 0;
+	}
+
+	int32 Num() const { return NumSamples; }
+	int64 GetTotalNum() const { return TotalSamples; }
+
+	// 保留樣本的百分位數與平均 (秒；沒有樣本時為 0)
+	double GetPercentile(double Fraction) const
+	{
+		if (NumSamples == 0)
+		{
+			return 0.0;
+		}
+
+		TArray<float, TInlineAllocator<Capacity>> Sorted(Samples, NumSamples);
+		Sorted.Sort();
+		return Sorted[FMath::Clamp((int32)(Fraction * (Sorted.Num() - 1)), 0, Sorted.Num() - 1)];
+	}
+
+	double GetMean() const
+	{
+		double Sum = 0.0;
+		for (int32 i = 0; i < NumSamples; ++i)
+		{
+			Sum += Samples[i];
+		}
+		return NumSamples > 0 ? Sum / NumSamples : 0.0;
+	}
+
+	// 輸出 p50/p90/p99/max 到日誌 (毫秒)
+	void LogPercentiles(const TCHAR* Label) const
+	{
+		if (NumSamples == 0)
+		{
+			UE_LOG(LogTemp, Display, TEXT("%s: no samples"), Label);
+			return;
+		}
+
+		TArray<float, TInlineAllocator<Capacity>> Sorted(Samples, NumSamples);
+		Sorted.Sort();
+
+		auto Percentile = [&Sorted](double Fraction)
+		{
+			return Sorted[FMath::Clamp((int32)(Fraction * (Sorted.Num() - 1)), 0, Sorted.Num() - 1)] * 1000.0;
+		};
+
+		UE_LOG(LogTemp, Display, TEXT("%s (last %d of %lld): p50 %.3f ms, p90 %.3f ms, p99 %.3f ms, max %.3f ms"),
+			Label, NumSamples, TotalSamples, Percentile(0.5), Percentile(0.9), Percentile(0.99), Sorted.Last() * 1000.0);
+	}
+
+private:
+	float Samples[Capacity];
+	int32 NextIndex = 0;
+	int32 NumSamples = 0;
+	int64 TotalSamples = 0;
+};
@@ -0,0 +1,170 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "CardBattle.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformTLS.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace BattleAllocationTest
+{
+	/**
+	 * FCountingMalloc - 轉發給原本 GMalloc 的代理，計算遊戲執行緒上的配置次數
+	 * 只在量測期間放進 GMalloc；其他執行緒的配置照常轉發但不計入。
+	 */
+	class FCountingMalloc final : public FMalloc
+	{
+	public:
+		explicit FCountingMalloc(FMalloc* InInner)
+			: Inner(InInner)
+			, CountedThreadId(FPlatformTLS::GetCurrentThreadId())
+		{
+		}
+
+		FMalloc* GetInner() const { return Inner; }
+
+		int32 GetNumAllocations() const { return NumAllocations.load(std::memory_order_relaxed); }
+
+		virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+		{
+			CountAllocation();
+			return Inner->Malloc(Count, Alignment);
+		}
+
+		virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override
+		{
+			CountAllocation();
+			return Inner->TryMalloc(Count, Alignment);
+		}
+
+		virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			// 縮小到 0 等同釋放，不算配置
+			if (Count > 0)
+			{
+				CountAllocation();
+			}
+			return Inner->Realloc(Original, Count, Alignment);
+		}
+
+		virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			if (Count > 0)
+			{
+				CountAllocation();
+			}
+			return Inner->TryRealloc(Original, Count, Alignment);
+		}
+
+		virtual void Free(void* Original) override { Inner->Free(Original); }
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+		virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+		virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+		virtual void MarkTLSCachesAsUsedOnCurrentThread() override { Inner->MarkTLSCachesAsUsedOnCurrentThread(); }
+		virtual void MarkTLSCachesAsUnusedOnCurrentThread() override { Inner->MarkTLSCachesAsUnusedOnCurrentThread(); }
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+		virtual void UpdateStats() override { Inner->UpdateStats(); }
+		virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override { Inner->GetAllocatorStats(OutStats); }
+		virtual void DumpAllocatorStats(FOutputDevice& Ar) override { Inner->DumpAllocatorStats(Ar); }
+		virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+		virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+		virtual const TCHAR* GetDescriptiveName() override { return Inner->GetDescriptiveName(); }
+
+	private:
+		void CountAllocation()
+		{
+			if (FPlatformTLS::GetCurrentThreadId() == CountedThreadId)
+			{
+				NumAllocations.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+
+		FMalloc* Inner;
+		uint32 CountedThreadId;
+		std::atomic<int32> NumAllocations { 0 };
+	};
+
+	// 以逾時代打走完一整局 (隨機出牌，不經過 Tick 與回合計時)
+	static void PlayMatch(ACardBattle* Battle, int32 Seed)
+	{
+		Battle->StartGame(Seed);
+
+		const FBattleSimCore& Sim = Battle->GetSimCore();
+		while (Sim.IsWaitingForPlay())
+		{
+			Battle->SubmitAction(FBattleAction::MakePlayRandom(Sim.GetCurrentTurnPlayerId(), EBattleActionSource::Timeout));
+			Battle->ProcessPendingActions();
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBattleMatchAllocationTest, "CardGame.Performance.MatchAllocations",
+	EAutomationTestFlags::EngineFilter | EAutomationTestFlags::ServerContext | EAutomationTestFlags::ClientContext)
+
+bool FBattleMatchAllocationTest::RunTest(const FString& Parameters)
+{
+	using namespace BattleAllocationTest;
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	const FString ArchivePath = FPaths::AutomationTransientDir() / TEXT("MatchAllocations.cardreplay");
+	IFileManager::Get().Delete(*ArchivePath);
+
+	ACardBattle* Battle = World->SpawnActor<ACardBattle>();
+	if (TestNotNull(TEXT("Spawned the battle game mode"), Battle))
+	{
+		Battle->SetAIType(EBattleAIType::Random);
+		Battle->SetReplayArchivePath(ArchivePath);
+
+		// 第一局建立牌組物件、開啟紀錄檔與暫存 (只在第一次使用時配置)
+		PlayMatch(Battle, 1);
+		TestTrue(TEXT("Warm-up match reached game over"), Battle->GetSimCore().GetState() == EBattleState::GameOver);
+		Battle->EndGame();
+
+		// 程式結束前都不釋放：量測結束後仍可能有其他執行緒透過它釋放記憶體
+		static FCountingMalloc* CountingMalloc = nullptr;
+		if (!CountingMalloc || CountingMalloc->GetInner() != GMalloc)
+		{
+			CountingMalloc = new FCountingMalloc(GMalloc);
+		}
+
+		FMalloc* PreviousMalloc = GMalloc;
+		const int32 NumAllocationsBefore = CountingMalloc->GetNumAllocations();
+		GMalloc = CountingMalloc;
+
+		PlayMatch(Battle, 2);
+
+		GMalloc = PreviousMalloc;
+		const int32 NumAllocations = CountingMalloc->GetNumAllocations() - NumAllocationsBefore;
+
+		TestTrue(TEXT("Measured match reached game over"), Battle->GetSimCore().GetState() == EBattleState::GameOver);
+		TestEqual(TEXT("Heap allocations on the game thread from StartGame to GameOver"), NumAllocations, 0);
+
+		// 關閉紀錄檔後檢查兩局都已寫入
+		Battle->EndGame();
+		Battle->SetReplayArchivePath(FString());
+
+		TArray<uint8> ArchiveData;
+		TArray<TConstArrayView<uint8>> Records;
+		TestTrue(TEXT("Replay archive was written"), FFileHelper::LoadFileToArray(ArchiveData, *ArchivePath));
+		TestTrue(TEXT("Replay archive parses"), FBattleReplay::SplitRecords(ArchiveData, Records));
+		TestEqual(TEXT("Both matches were appended to the replay archive"), Records.Num(), 2);
+	}
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+
+	IFileManager::Get().Delete(*ArchivePath);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
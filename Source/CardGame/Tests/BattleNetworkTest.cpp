@@ -0,0 +1,241 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_EDITOR && WITH_DEV_AUTOMATION_TESTS
+
+#include "CardBattle.h"
+#include "CardBattleGameState.h"
+#include "CardBattlePlayerState.h"
+#include "Editor.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Settings/LevelEditorPlaySettings.h"
+#include "Tests/AutomationEditorCommon.h"
+#include "UObject/StrongObjectPtr.h"
+
+namespace BattleNetworkTest
+{
+	// 對戰地圖 (BP_CardBattle 是預設 GameMode)
+	static const TCHAR* BattleMapName = TEXT("/Game/Maps/TheFirstMap");
+
+	static constexpr int32 NumClients = 2;
+
+	// 等待 PIE 啟動與兩個客戶端入座、以及整局對戰的時間上限 (秒)
+	static constexpr double ConnectTimeoutSeconds = 60.0;
+	static constexpr double MatchTimeoutSeconds = 120.0;
+
+	// 每個客戶端每次出牌的平均位元組上限 (包含這段時間的連線固定開銷)
+	// 每次出牌應該只送出狀態變更與一個 FastArray 項目；超過表示又開始複製整個陣列或每幀的值
+	static constexpr double MaxBytesPerPlayPerClient = 512.0;
+
+	// 各個 latent command 共用的狀態
+	struct FState
+	{
+		TStrongObjectPtr<ULevelEditorPlaySettings> PlaySettings;
+
+		TWeakObjectPtr<ACardBattle> ServerBattle;
+		TWeakObjectPtr<ACardBattleGameState> ServerGameState;
+
+		// 每個客戶端上次出牌時雙方的手牌總數 (同一回合只送一次)
+		int32 LastRequestedTurn[NumClients] = { INDEX_NONE, INDEX_NONE };
+	};
+
+	// 伺服器 (專用伺服器) 的 PIE 世界
+	static UWorld* FindServerWorld()
+	{
+		for (const FWorldContext& Context : GEngine->GetWorldContexts())
+		{
+			UWorld* World = Context.World();
+			if (Context.WorldType == EWorldType::PIE && World && World->GetNetMode() == NM_DedicatedServer)
+			{
+				return World;
+			}
+		}
+		return nullptr;
+	}
+
+	// 客戶端的 PIE 世界 (依 PIE 實例順序)
+	static int32 FindClientWorlds(UWorld* OutWorlds[NumClients])
+	{
+		int32 NumFound = 0;
+		for (const FWorldContext& Context : GEngine->GetWorldContexts())
+		{
+			UWorld* World = Context.World();
+			if (Context.WorldType == EWorldType::PIE && World && World->GetNetMode() == NM_Client && NumFound < NumClients)
+			{
+				OutWorlds[NumFound++] = World;
+			}
+		}
+		return NumFound;
+	}
+
+	// 輪到這個客戶端的座位且手牌已複製時，透過伺服器 RPC 打出第一張牌
+	static void PlayIfMyTurn(UWorld* ClientWorld, int32& LastRequestedTurn)
+	{
+		const ACardBattleGameState* GameState = ClientWorld->GetGameState<ACardBattleGameState>();
+		const APlayerController* PC = ClientWorld->GetFirstPlayerController();
+		ACardBattlePlayerState* PlayerState = PC ? PC->GetPlayerState<ACardBattlePlayerState>() : nullptr;
+		if (!GameState || !PlayerState || PlayerState->GetSeatId() == INDEX_NONE)
+		{
+			return;
+		}
+
+		const EBattleState State = GameState->GetBattleState();
+		const int32 SeatId = PlayerState->GetSeatId();
+		if ((State != EBattleState::WaitingForPlayer0 && State != EBattleState::WaitingForPlayer1) || GameState->GetCurrentTurnPlayerId() != SeatId)
+		{
+			return;
+		}
+
+		const int32 Turn = GameState->GetHandCount(0) + GameState->GetHandCount(1);
+		const FCardHand Hand = PlayerState->GetHand();
+		if (Turn == LastRequestedTurn || Hand.IsEmpty() || Hand.Num() != GameState->GetHandCount(SeatId))
+		{
+			return;
+		}
+
+		LastRequestedTurn = Turn;
+		PlayerState->ServerPlayCard(Hand.GetCard(0).CardValue);
+	}
+}
+
+// 以專用伺服器 + 兩個客戶端 (同一個行程) 開始 PIE
+DEFINE_LATENT_AUTOMATION_COMMAND_ONE_PARAMETER(FStartTwoClientPIECommand, TSharedRef<BattleNetworkTest::FState>, State);
+
+bool FStartTwoClientPIECommand::Update()
+{
+	ULevelEditorPlaySettings* PlaySettings = NewObject<ULevelEditorPlaySettings>();
+	PlaySettings->SetPlayNetMode(EPlayNetMode::PIE_Client);
+	PlaySettings->SetPlayNumberOfClients(BattleNetworkTest::NumClients);
+	PlaySettings->SetRunUnderOneProcess(true);
+	State->PlaySettings.Reset(PlaySettings);
+
+	FRequestPlaySessionParams Params;
+	Params.WorldType = EPlaySessionWorldType::PlayInEditor;
+	Params.EditorPlaySettings = PlaySettings;
+	GEditor->RequestPlaySession(Params);
+	return true;
+}
+
+// 等待兩個客戶端都坐上座位，之後在伺服器上重新開局 (只量測入座之後的對戰)
+DEFINE_LATENT_AUTOMATION_COMMAND_TWO_PARAMETER(FWaitForSeatedClientsCommand, FAutomationTestBase*, Test, TSharedRef<BattleNetworkTest::FState>, State);
+
+bool FWaitForSeatedClientsCommand::Update()
+{
+	using namespace BattleNetworkTest;
+
+	UWorld* ServerWorld = FindServerWorld();
+	ACardBattle* Battle = ServerWorld ? ServerWorld->GetAuthGameMode<ACardBattle>() : nullptr;
+	ACardBattleGameState* GameState = ServerWorld ? ServerWorld->GetGameState<ACardBattleGameState>() : nullptr;
+
+	UWorld* ClientWorlds[NumClients] = {};
+	const bool bReady = Battle && GameState
+		&& GameState->GetNumClientConnections() == NumClients
+		&& GameState->IsSeatHuman(0) && GameState->IsSeatHuman(1)
+		&& FindClientWorlds(ClientWorlds) == NumClients;
+
+	if (!bReady)
+	{
+		if (GetCurrentRunTime() > ConnectTimeoutSeconds)
+		{
+			Test->AddError(TEXT("Timed out waiting for a dedicated server with an ACardBattle and two seated clients"));
+			return true;
+		}
+		return false;
+	}
+
+	State->ServerBattle = Battle;
+	State->ServerGameState = GameState;
+
+	Battle->EndGame();
+	Battle->StartGame();
+	return true;
+}
+
+// 兩個客戶端輪流出牌直到遊戲結束，再檢查本局送給客戶端的位元組
+DEFINE_LATENT_AUTOMATION_COMMAND_TWO_PARAMETER(FPlayNetworkMatchCommand, FAutomationTestBase*, Test, TSharedRef<BattleNetworkTest::FState>, State);
+
+bool FPlayNetworkMatchCommand::Update()
+{
+	using namespace BattleNetworkTest;
+
+	const ACardBattle* Battle = State->ServerBattle.Get();
+	const ACardBattleGameState* GameState = State->ServerGameState.Get();
+	if (!Battle || !GameState)
+	{
+		// 前一步已經回報錯誤，或 PIE 中途結束
+		if (!Test->HasAnyErrors())
+		{
+			Test->AddError(TEXT("The PIE server world went away before the match finished"));
+		}
+		return true;
+	}
+
+	if (Battle->GetSimCore().GetState() != EBattleState::GameOver)
+	{
+		if (GetCurrentRunTime() > MatchTimeoutSeconds)
+		{
+			Test->AddError(TEXT("Timed out waiting for the networked match to finish"));
+			return true;
+		}
+
+		UWorld* ClientWorlds[NumClients] = {};
+		const int32 NumClientWorlds = FindClientWorlds(ClientWorlds);
+		for (int32 ClientIndex = 0; ClientIndex < NumClientWorlds; ++ClientIndex)
+		{
+			PlayIfMyTurn(ClientWorlds[ClientIndex], State->LastRequestedTurn[ClientIndex]);
+		}
+		return false;
+	}
+
+	const int64 MatchBytes = GameState->GetLastMatchOutBytes();
+	const int32 NumPlays = Battle->GetReplay().Moves.Num();
+	const int32 NumConnections = GameState->GetNumClientConnections();
+
+	Test->TestEqual(TEXT("Every hand was played"), NumPlays, FBattleReplay::MaxMoves);
+	Test->TestEqual(TEXT("Both clients stayed connected"), NumConnections, NumClients);
+	if (!Test->TestTrue(TEXT("The server measured the match bytes"), MatchBytes > 0) || NumPlays == 0 || NumConnections == 0)
+	{
+		return true;
+	}
+
+	const double BytesPerPlayPerClient = (double)MatchBytes / NumConnections / NumPlays;
+	Test->AddInfo(FString::Printf(TEXT("Match: %lld bytes to %d clients, %d plays (%.0f bytes/play/client)"),
+		MatchBytes, NumConnections, NumPlays, BytesPerPlayPerClient));
+	Test->TestTrue(FString::Printf(TEXT("Bytes per play per client (%.0f) is within %.0f"), BytesPerPlayPerClient, MaxBytesPerPlayPerClient),
+		BytesPerPlayPerClient <= MaxBytesPerPlayPerClient);
+	return true;
+}
+
+// 結束 PIE
+DEFINE_LATENT_AUTOMATION_COMMAND_ONE_PARAMETER(FEndTwoClientPIECommand, TSharedRef<BattleNetworkTest::FState>, State);
+
+bool FEndTwoClientPIECommand::Update()
+{
+	if (GEditor->IsPlaySessionInProgress())
+	{
+		GEditor->RequestEndPlayMap();
+	}
+	State->PlaySettings.Reset();
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBattleNetworkBandwidthTest, "CardGame.Performance.NetworkBandwidth",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FBattleNetworkBandwidthTest::RunTest(const FString& Parameters)
+{
+	using namespace BattleNetworkTest;
+
+	TSharedRef<FState> State = MakeShared<FState>();
+
+	FAutomationEditorCommonUtils::LoadMap(BattleMapName);
+	ADD_LATENT_AUTOMATION_COMMAND(FStartTwoClientPIECommand(State));
+	ADD_LATENT_AUTOMATION_COMMAND(FWaitForSeatedClientsCommand(this, State));
+	ADD_LATENT_AUTOMATION_COMMAND(FPlayNetworkMatchCommand(this, State));
+	ADD_LATENT_AUTOMATION_COMMAND(FEndTwoClientPIECommand(State));
+	return true;
+}
+
+#endif // WITH_EDITOR && WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,60 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "Tests/AutomationCommon.h"
+#include "UI/CardHUDBenchmark.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace CardHUDBenchmarkTest
+{
+	// 對戰地圖 (BP_CardBattle 是預設 GameMode)
+	static const TCHAR* BattleMapName = TEXT("/Game/Maps/TheFirstMap");
+
+	// 三種手牌數 x (暖身 + 量測) 幀，加上載入與慢速機器的餘裕
+	static constexpr double TimeoutSeconds = 300.0;
+}
+
+// 在對戰地圖的 HUD 上開始 CardGame.HUDBench
+DEFINE_LATENT_AUTOMATION_COMMAND_ONE_PARAMETER(FStartCardHUDBenchmarkCommand, FAutomationTestBase*, Test);
+
+bool FStartCardHUDBenchmarkCommand::Update()
+{
+	if (!FCardHUDBenchmark::Start(AutomationCommon::GetAnyGameWorld(), FCardHUDBenchmarkSettings()))
+	{
+		Test->AddError(TEXT("Could not start the HUD benchmark (no ACardBattle HUD in the loaded map)"));
+	}
+	return true;
+}
+
+// 等待測試結束並檢查每種手牌數的 p95 都有基準且沒有退步
+DEFINE_LATENT_AUTOMATION_COMMAND_ONE_PARAMETER(FWaitForCardHUDBenchmarkCommand, FAutomationTestBase*, Test);
+
+bool FWaitForCardHUDBenchmarkCommand::Update()
+{
+	if (FCardHUDBenchmark::IsRunning())
+	{
+		if (GetCurrentRunTime() > CardHUDBenchmarkTest::TimeoutSeconds)
+		{
+			Test->AddError(TEXT("HUD benchmark timed out"));
+			return true;
+		}
+		return false;
+	}
+
+	Test->TestTrue(TEXT("HUD frame p95 is within the checked-in baseline for every hand size (see the HUD BENCHMARK log)"), FCardHUDBenchmark::DidLastRunPass());
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCardHUDBenchmarkPerfTest, "CardGame.Performance.HUDBenchmark",
+	EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+bool FCardHUDBenchmarkPerfTest::RunTest(const FString& Parameters)
+{
+	AutomationOpenMap(CardHUDBenchmarkTest::BattleMapName);
+	ADD_LATENT_AUTOMATION_COMMAND(FStartCardHUDBenchmarkCommand(this));
+	ADD_LATENT_AUTOMATION_COMMAND(FWaitForCardHUDBenchmarkCommand(this));
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,112 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CardArtLoader.h"
+#include "CardGame.h"
+#include "Engine/AssetManager.h"
+#include "Engine/Texture2D.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+
+FCardArtLoadStats FCardArtLoader::Stats;
+
+static FAutoConsoleCommand GCardArtStatsCommand(
+	TEXT("CardGame.ArtStats"),
+	TEXT("Print card art streaming statistics. Pass 'reset' to clear them."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		FCardArtLoader::LogStats();
+		if (Args.Num() > 0 && Args[0] == TEXT("reset"))
+		{
+			FCardArtLoader::ResetStats();
+		}
+	}));
+
+TSharedPtr<FStreamableHandle> FCardArtLoader::RequestTexture(const TSoftObjectPtr<UTexture2D>& Texture, ECardArtPriority Priority, FOnTextureLoaded OnLoaded)
+{
+	if (Texture.IsNull())
+	{
+		OnLoaded.ExecuteIfBound(nullptr);
+		return nullptr;
+	}
+
+	// 已經載入過的貼圖直接套用
+	if (UTexture2D* ResidentTexture = Texture.Get())
+	{
+		++Stats.NumResidentHits;
+		INC_DWORD_STAT(STAT_CardGame_TextureResidentHits);
+		TRACE_COUNTER_INCREMENT(CardGame_TextureResidentHits);
+		OnLoaded.ExecuteIfBound(ResidentTexture);
+		return nullptr;
+	}
+
+	++Stats.NumAsyncRequests;
+	INC_DWORD_STAT(STAT_CardGame_TextureLoads);
+	TRACE_COUNTER_INCREMENT(CardGame_TextureLoads);
+
+	const double RequestTime = FPlatformTime::Seconds();
+	return GetStreamableManager().RequestAsyncLoad(
+		Texture.ToSoftObjectPath(),
+		FStreamableDelegate::CreateLambda([Texture, RequestTime, OnLoaded]()
+		{
+			UTexture2D* LoadedTexture = Texture.Get();
+			if (LoadedTexture)
+			{
+				++Stats.NumCompleted;
+				Stats.StallSecondsAvoided += FPlatformTime::Seconds() - RequestTime;
+			}
+			else
+			{
+				++Stats.NumFailed;
+				UE_LOG(LogTemp, Error, TEXT("CardArtLoader: Failed to load texture %s!"), *Texture.ToString());
+			}
+
+			OnLoaded.ExecuteIfBound(LoadedTexture);
+		}),
+		ToAsyncLoadPriority(Priority));
+}
+
+void FCardArtLoader::CancelRequest(TSharedPtr<FStreamableHandle>& Handle)
+{
+	if (Handle.IsValid())
+	{
+		if (Handle->IsLoadingInProgress())
+		{
+			++Stats.NumCancelled;
+			Handle->CancelHandle();
+		}
+		Handle.Reset();
+	}
+}
+
+void FCardArtLoader::LogStats()
+{
+	UE_LOG(LogTemp, Display, TEXT("CardArtLoader: %d async requests (%d completed, %d failed, %d cancelled), %d resident hits, %.2f ms game-thread stall avoided."),
+		Stats.NumAsyncRequests, Stats.NumCompleted, Stats.NumFailed, Stats.NumCancelled,
+		Stats.NumResidentHits, Stats.StallSecondsAvoided * 1000.0);
+}
+
+FStreamableManager& FCardArtLoader::GetStreamableManager()
+{
+	if (UAssetManager::IsInitialized())
+	{
+		return UAssetManager::GetStreamableManager();
+	}
+
+	// AssetManager 尚未建立時 (例如部分工具流程) 使用自己的 StreamableManager
+	static FStreamableManager FallbackStreamableManager;
+	return FallbackStreamableManager;
+}
+
+TAsyncLoadPriority FCardArtLoader::ToAsyncLoadPriority(ECardArtPriority Priority)
+{
+	switch (Priority)
+	{
+	case ECardArtPriority::PlayerHand:
+		return FStreamableManager::AsyncLoadHighPriority;
+	case ECardArtPriority::Board:
+		return FStreamableManager::AsyncLoadHighPriority / 2;
+	case ECardArtPriority::OpponentHand:
+	default:
+		return FStreamableManager::DefaultAsyncLoadPriority;
+	}
+}
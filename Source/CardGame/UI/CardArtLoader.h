@@ -0,0 +1,73 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/StreamableManager.h"
+
+class UTexture2D;
+
+/**
+ * ECardArtPriority - 卡牌圖片的載入優先順序
+ * 同一幀提出的請求依此順序完成：自己的手牌 > 檯面 > 對手手牌
+ */
+enum class ECardArtPriority : uint8
+{
+	OpponentHand,
+	Board,
+	PlayerHand,
+};
+
+/**
+ * FCardArtLoadStats - 卡牌圖片載入統計
+ */
+struct FCardArtLoadStats
+{
+	// 需要非同步載入的請求數
+	int32 NumAsyncRequests = 0;
+
+	// 請求時已在記憶體中、直接套用的次數
+	int32 NumResidentHits = 0;
+
+	// 已完成 / 失敗的非同步請求數
+	int32 NumCompleted = 0;
+	int32 NumFailed = 0;
+
+	// 被取消 (Widget 換了資料或被銷毀) 的請求數
+	int32 NumCancelled = 0;
+
+	// 避免的遊戲執行緒阻塞時間 (秒)
+	// 以請求到完成的時間估計，原本 LoadSynchronous 會在遊戲執行緒上等這麼久
+	double StallSecondsAvoided = 0.0;
+};
+
+/**
+ * FCardArtLoader - 以 FStreamableManager 非同步載入卡牌圖片
+ * 所有回調都在遊戲執行緒上執行
+ */
+class CARDGAME_API FCardArtLoader
+{
+public:
+	DECLARE_DELEGATE_OneParam(FOnTextureLoaded, UTexture2D* /*Texture*/);
+
+	// 請求載入貼圖
+	// 已在記憶體中時立刻呼叫 OnLoaded 並回傳 nullptr；否則回傳可取消的 Handle
+	// 載入失敗時 OnLoaded 會收到 nullptr
+	static TSharedPtr<FStreamableHandle> RequestTexture(const TSoftObjectPtr<UTexture2D>& Texture, ECardArtPriority Priority, FOnTextureLoaded OnLoaded);
+
+	// 取消尚未完成的請求並清空 Handle
+	static void CancelRequest(TSharedPtr<FStreamableHandle>& Handle);
+
+	static const FCardArtLoadStats& GetStats() { return Stats; }
+	static void ResetStats() { Stats = FCardArtLoadStats(); }
+
+	// 輸出到日誌
+	static void LogStats();
+
+private:
+	static FStreamableManager& GetStreamableManager();
+
+	static TAsyncLoadPriority ToAsyncLoadPriority(ECardArtPriority Priority);
+
+	static FCardArtLoadStats Stats;
+};
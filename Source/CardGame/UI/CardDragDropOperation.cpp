@@ -1,3 +1,30 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "CardDragDropOperation.h"
+#include "CardWidget.h"
+#include "CardWidgetPool.h"
+
+void UCardDragDropOperation::Drop_Implementation(const FPointerEvent& PointerEvent)
+{
+	Super::Drop_Implementation(PointerEvent);
+	ReleaseDragVisual();
+}
+
+void UCardDragDropOperation::DragCancelled_Implementation(const FPointerEvent& PointerEvent)
+{
+	Super::DragCancelled_Implementation(PointerEvent);
+	ReleaseDragVisual();
+}
+
+void UCardDragDropOperation::ReleaseDragVisual()
+{
+	UCardWidgetPool* Pool = VisualPool.Get();
+	UCardWidget* DragVisual = Cast<UCardWidget>(DefaultDragVisual);
+	if (Pool && DragVisual)
+	{
+		Pool->Release(DragVisual);
+	}
+
+	DefaultDragVisual = nullptr;
+	VisualPool.Reset();
+}
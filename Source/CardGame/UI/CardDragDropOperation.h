@@ -8,7 +8,7 @@
 
 /**
  * UCardDragDropOperation
- * 手牌拖曳時攜帶卡牌索引
+ * 手牌拖曳時攜帶卡牌索引，拖曳結束後把拖曳顯示歸還到物件池
  */
 UCLASS()
 class CARDGAME_API UCardDragDropOperation : public UDragDropOperation
@@ -18,4 +18,14 @@ class CARDGAME_API UCardDragDropOperation : public UDragDropOperation
 public:
 	UPROPERTY(BlueprintReadWrite, Category = "Card")
 	int32 CardIndex = -1;
+
+	// 拖曳顯示來自這個物件池時，拖曳結束後歸還
+	TWeakObjectPtr<class UCardWidgetPool> VisualPool;
+
+	virtual void Drop_Implementation(const FPointerEvent& PointerEvent) override;
+	virtual void DragCancelled_Implementation(const FPointerEvent& PointerEvent) override;
+
+private:
+	// 歸還拖曳顯示的 Widget
+	void ReleaseDragVisual();
 };
@@ -0,0 +1,467 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CardHUDBenchmark.h"
+#include "CardWidgetPool.h"
+#include "CardBattle.h"
+#include "Engine/World.h"
+#include "Framework/Application/SlateApplication.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace CardHUDBenchmark
+{
+	// DefaultGame.ini 中的基準區段
+	static const TCHAR* BaselineSection = TEXT("CardGame.HUDBenchmark");
+
+	// 容許的退步比例 (基準區段沒有設定 RegressionTolerance 時使用)
+	static constexpr float DefaultRegressionTolerance = 0.2f;
+
+	// 結束後在下一次 Core Ticker 或 World 清除時釋放，不會留到程式結束的靜態解構
+	static TUniquePtr<FCardHUDBenchmark> ActiveBenchmark;
+
+	// 最近一次完成的測試結果 (自動化測試在測試物件釋放後讀取)
+	static bool bLastRunPassed = false;
+
+	static int32 GetWidgetsCreated(const UCardGameHUD* HUD)
+	{
+		const UCardWidgetPool* Pool = HUD ? HUD->GetCardWidgetPoolIfCreated() : nullptr;
+		return Pool ? Pool->GetStats().NumCreated : 0;
+	}
+}
+
+static FAutoConsoleCommandWithWorldAndArgs GCardHUDBenchCommand(
+	TEXT("CardGame.HUDBench"),
+	TEXT("Drive the battle HUD through scripted matches and record UpdateUI/Slate frame times. Usage: CardGame.HUDBench [Frames=300] [Sizes=10,50,200] [record] [exit]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		FCardHUDBenchmarkSettings Settings;
+		for (const FString& Arg : Args)
+		{
+			if (Arg.Equals(TEXT("exit"), ESearchCase::IgnoreCase))
+			{
+				Settings.bExitWhenDone = true;
+			}
+			else if (Arg.Equals(TEXT("record"), ESearchCase::IgnoreCase))
+			{
+				Settings.bRecordBaselines = true;
+			}
+			else if (Arg.Contains(TEXT(",")))
+			{
+				TArray<FString> Sizes;
+				Arg.ParseIntoArray(Sizes, TEXT(","));
+
+				Settings.HandSizes.Reset();
+				for (const FString& Size : Sizes)
+				{
+					Settings.HandSizes.Add(FMath::Clamp(FCString::Atoi(*Size), 1, UCardGameHUD::MaxKeyedCardValue - 1));
+				}
+			}
+			else if (Arg.IsNumeric())
+			{
+				Settings.MeasureFrames = FMath::Max(FCString::Atoi(*Arg), 1);
+			}
+		}
+
+		FCardHUDBenchmark::Start(World, Settings);
+	}));
+
+bool FCardHUDBenchmark::Start(UWorld* World, const FCardHUDBenchmarkSettings& Settings)
+{
+	using namespace CardHUDBenchmark;
+
+	if (IsRunning())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("CardHUDBenchmark: A benchmark is already running"));
+		return false;
+	}
+
+	ACardBattle* Battle = World ? World->GetAuthGameMode<ACardBattle>() : nullptr;
+	UCardGameHUD* HUD = Battle ? Battle->GetGameHUD() : nullptr;
+	if (!HUD || Settings.HandSizes.Num() == 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("CardHUDBenchmark: No ACardBattle HUD in this world (load the battle map first)"));
+		if (Settings.bExitWhenDone)
+		{
+			FPlatformMisc::RequestExitWithStatus(false, 1);
+		}
+		return false;
+	}
+
+	bLastRunPassed = false;
+	ActiveBenchmark.Reset(new FCardHUDBenchmark(World, Battle, HUD, Settings));
+	return true;
+}
+
+bool FCardHUDBenchmark::IsRunning()
+{
+	return CardHUDBenchmark::ActiveBenchmark.IsValid() && !CardHUDBenchmark::ActiveBenchmark->bFinished;
+}
+
+bool FCardHUDBenchmark::DidLastRunPass()
+{
+	return CardHUDBenchmark::bLastRunPassed;
+}
+
+FCardHUDBenchmark::FCardHUDBenchmark(UWorld* InWorld, ACardBattle* InBattle, UCardGameHUD* InHUD, const FCardHUDBenchmarkSettings& InSettings)
+	: Settings(InSettings)
+	, Battle(InBattle)
+	, HUD(InHUD)
+	, World(InWorld)
+	, Random(InSettings.Seed)
+{
+	// 對戰保持閒置，避免計時器或 AI 在測試期間改動 HUD
+	InBattle->EndGame();
+	InHUD->SetDisplayOverride(&Display);
+
+	if (FSlateApplication::IsInitialized())
+	{
+		SlatePreTickHandle = FSlateApplication::Get().OnPreTick().AddRaw(this, &FCardHUDBenchmark::OnSlatePreTick);
+		SlatePostTickHandle = FSlateApplication::Get().OnPostTick().AddRaw(this, &FCardHUDBenchmark::OnSlatePostTick);
+	}
+
+	PreGCHandle = FCoreUObjectDelegates::GetPreGarbageCollectDelegate().AddRaw(this, &FCardHUDBenchmark::OnPreGarbageCollect);
+	PostGCHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FCardHUDBenchmark::OnPostGarbageCollect);
+	WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddRaw(this, &FCardHUDBenchmark::OnWorldCleanup);
+
+	UE_LOG(LogTemp, Display, TEXT("CardHUDBenchmark: %d hand sizes, %d warmup + %d measured frames each"),
+		Settings.HandSizes.Num(), Settings.WarmupFrames, Settings.MeasureFrames);
+
+	BeginSize();
+}
+
+FCardHUDBenchmark::~FCardHUDBenchmark()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(ReleaseTickerHandle);
+	Unbind();
+}
+
+void FCardHUDBenchmark::Unbind()
+{
+	if (FSlateApplication::IsInitialized())
+	{
+		FSlateApplication::Get().OnPreTick().Remove(SlatePreTickHandle);
+		FSlateApplication::Get().OnPostTick().Remove(SlatePostTickHandle);
+	}
+	SlatePreTickHandle.Reset();
+	SlatePostTickHandle.Reset();
+
+	FCoreUObjectDelegates::GetPreGarbageCollectDelegate().Remove(PreGCHandle);
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGCHandle);
+	FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+	PreGCHandle.Reset();
+	PostGCHandle.Reset();
+	WorldCleanupHandle.Reset();
+
+	if (UCardGameHUD* CardHUD = HUD.Get())
+	{
+		CardHUD->SetDisplayOverride(nullptr);
+	}
+}
+
+TStatId FCardHUDBenchmark::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(FCardHUDBenchmark, STATGROUP_Tickables);
+}
+
+void FCardHUDBenchmark::Tick(float DeltaTime)
+{
+	UCardGameHUD* CardHUD = HUD.Get();
+	if (!CardHUD)
+	{
+		UE_LOG(LogTemp, Error, TEXT("CardHUDBenchmark: HUD was destroyed, aborting"));
+		Finish(true);
+		return;
+	}
+
+	// 記錄上一幀 (UpdateUI 之後的 Slate Tick 也算在內)
+	const double Now = FPlatformTime::Seconds();
+	if (IsMeasuring())
+	{
+		FSizeResult& Result = Results.Last();
+		Result.UpdateUI.Add(PendingUpdateUISeconds);
+		Result.Slate.Add(PendingSlateSeconds);
+		Result.HUDFrame.Add(PendingUpdateUISeconds + PendingSlateSeconds);
+		Result.Frame.Add(Now - LastTickTime);
+		Result.PeakCardWidgets = FMath::Max(Result.PeakCardWidgets, CardHUD->GetNumCardWidgets());
+	}
+	PendingSlateSeconds = 0.0;
+
+	if (FrameIndex >= Settings.WarmupFrames + Settings.MeasureFrames)
+	{
+		FinishSize();
+		if (SizeIndex + 1 < Settings.HandSizes.Num())
+		{
+			BeginSize();
+		}
+		else
+		{
+			Finish(false);
+		}
+		return;
+	}
+
+	PlayScriptedMove();
+
+	const double UpdateStartTime = FPlatformTime::Seconds();
+	CardHUD->UpdateUI();
+	PendingUpdateUISeconds = FPlatformTime::Seconds() - UpdateStartTime;
+
+	LastTickTime = Now;
+	++FrameIndex;
+}
+
+void FCardHUDBenchmark::BeginSize()
+{
+	++SizeIndex;
+	FrameIndex = 0;
+	MoveIndex = 0;
+
+	FSizeResult& Result = Results.AddDefaulted_GetRef();
+	Result.HandSize = Settings.HandSizes[SizeIndex];
+
+	DealHands();
+	WidgetsCreatedAtStart = CardHUDBenchmark::GetWidgetsCreated(HUD.Get());
+}
+
+void FCardHUDBenchmark::DealHands()
+{
+	const int32 HandSize = Settings.HandSizes[SizeIndex];
+
+	for (int32 PlayerId = 0; PlayerId < 2; ++PlayerId)
+	{
+		TArray<FCard>& Hand = Display.Hands[PlayerId];
+		Display.PlayedCards[PlayerId].Reset();
+
+		if (HandSize <= FBattleSimCore::MaxCardValue)
+		{
+			// 一般牌組：從 1-30 隨機抽 HandSize 張 (與對戰一樣依數值排序)
+			TArray<FCard> Deck;
+			FBattleSimCore::GetDefaultDeck(Deck);
+			for (int32 i = Deck.Num() - 1; i > 0; --i)
+			{
+				Deck.Swap(i, Random.RandRange(0, i));
+			}
+
+			Hand.Reset(HandSize);
+			Hand.Append(Deck.GetData(), HandSize);
+			Hand.Sort([](const FCard& A, const FCard& B) { return A.CardValue < B.CardValue; });
+		}
+		else
+		{
+			// 超過牌組大小時以不重複的數值模擬更大的手牌 (仍在 HUD 以 CardValue 對應 Widget 的範圍內)
+			check(HandSize < UCardGameHUD::MaxKeyedCardValue);
+			Hand.Reset(HandSize);
+			for (int32 CardValue = 1; CardValue <= HandSize; ++CardValue)
+			{
+				Hand.Add(FCard(CardValue));
+			}
+		}
+	}
+}
+
+void FCardHUDBenchmark::PlayScriptedMove()
+{
+	if (Display.Hands[0].Num() == 0 && Display.Hands[1].Num() == 0)
+	{
+		DealHands();
+	}
+
+	int32 PlayerId = MoveIndex++ & 1;
+	if (Display.Hands[PlayerId].Num() == 0)
+	{
+		PlayerId = 1 - PlayerId;
+	}
+
+	TArray<FCard>& Hand = Display.Hands[PlayerId];
+	const int32 CardIndex = Random.RandRange(0, Hand.Num() - 1);
+	Display.PlayedCards[PlayerId].Add(Hand[CardIndex]);
+	Hand.RemoveAt(CardIndex);
+}
+
+void FCardHUDBenchmark::FinishSize()
+{
+	using namespace CardHUDBenchmark;
+
+	FSizeResult& Result = Results.Last();
+	Result.WidgetsCreated = GetWidgetsCreated(HUD.Get()) - WidgetsCreatedAtStart;
+
+	float BaselineP95Ms = 0.0f;
+	float Tolerance = DefaultRegressionTolerance;
+	GConfig->GetFloat(BaselineSection, TEXT("RegressionTolerance"), Tolerance, GGameIni);
+	if (GConfig->GetFloat(BaselineSection, *FString::Printf(TEXT("BaselineP95Ms_%d"), Result.HandSize), BaselineP95Ms, GGameIni) && BaselineP95Ms > 0.0f)
+	{
+		Result.BaselineP95Ms = BaselineP95Ms;
+		Result.bRegressed = Result.HUDFrame.GetPercentile(0.95) * 1000.0 > BaselineP95Ms * (1.0f + Tolerance);
+	}
+	else
+	{
+		// 沒有基準就無法判斷是否退步，不能當作通過
+		Result.bMissingBaseline = true;
+	}
+}
+
+void FCardHUDBenchmark::Finish(bool bAborted)
+{
+	bFinished = true;
+
+	Unbind();
+	if (UCardGameHUD* CardHUD = HUD.Get())
+	{
+		CardHUD->UpdateUI();
+	}
+
+	// 這裡可能在自己的 Tick 中，不能直接刪除；下一次 Core Ticker 時釋放 (期間若已開始新的測試則不動)
+	ReleaseTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([this](float)
+	{
+		if (CardHUDBenchmark::ActiveBenchmark.Get() == this)
+		{
+			CardHUDBenchmark::ActiveBenchmark.Reset();
+		}
+		return false;
+	}));
+
+	bool bRegressed = false;
+	bool bMissingBaseline = false;
+
+	UE_LOG(LogTemp, Display, TEXT("========== HUD BENCHMARK =========="));
+	for (const FSizeResult& Result : Results)
+	{
+		const FString Baseline = Result.BaselineP95Ms > 0.0 ? FString::Printf(TEXT("baseline %.3f ms"), Result.BaselineP95Ms) : FString(TEXT("no baseline"));
+		UE_LOG(LogTemp, Display, TEXT("Hand %d: UpdateUI p95 %.3f ms, Slate p95 %.3f ms, HUD frame p95 %.3f ms (%s) %s"),
+			Result.HandSize, Result.UpdateUI.GetPercentile(0.95) * 1000.0, Result.Slate.GetPercentile(0.95) * 1000.0,
+			Result.HUDFrame.GetPercentile(0.95) * 1000.0, *Baseline,
+			Result.bRegressed ? TEXT("REGRESSED") : Result.bMissingBaseline ? TEXT("MISSING BASELINE") : TEXT("ok"));
+		UE_LOG(LogTemp, Display, TEXT("  Frame p50 %.3f ms, p95 %.3f ms; %d card widgets (peak), %d created; GC %d times, max %.3f ms"),
+			Result.Frame.GetPercentile(0.5) * 1000.0, Result.Frame.GetPercentile(0.95) * 1000.0,
+			Result.PeakCardWidgets, Result.WidgetsCreated, Result.NumGC, Result.MaxGCSeconds * 1000.0);
+
+		bRegressed |= Result.bRegressed;
+		bMissingBaseline |= Result.bMissingBaseline;
+	}
+
+	const FString FilePath = FPaths::ProjectSavedDir() / TEXT("Benchmarks")
+		/ FString::Printf(TEXT("HUDBenchmark_%s.csv"), *FDateTime::Now().ToString());
+	if (WriteCsv(FilePath))
+	{
+		UE_LOG(LogTemp, Display, TEXT("Results written to %s"), *FilePath);
+	}
+
+	// 記錄模式只輸出基準，不檢查
+	bool bPassed;
+	if (Settings.bRecordBaselines && !bAborted)
+	{
+		const FString BaselinePath = FPaths::ProjectSavedDir() / TEXT("Benchmarks")
+			/ FString::Printf(TEXT("HUDBaseline_%s.ini"), *FDateTime::Now().ToString());
+		bPassed = WriteBaselines(BaselinePath);
+		UE_LOG(LogTemp, Display, TEXT("Result: %s"), bPassed ? TEXT("RECORDED") : TEXT("FAILED (could not write baselines)"));
+		if (bPassed)
+		{
+			UE_LOG(LogTemp, Display, TEXT("Copy the keys in %s into [CardGame.HUDBenchmark] in Config/DefaultGame.ini"), *BaselinePath);
+		}
+	}
+	else
+	{
+		bPassed = !bAborted && !bRegressed && !bMissingBaseline;
+		UE_LOG(LogTemp, Display, TEXT("Result: %s"), bAborted ? TEXT("ABORTED")
+			: bRegressed ? TEXT("FAILED (p95 regressed past baseline)")
+			: bMissingBaseline ? TEXT("FAILED (no BaselineP95Ms_<HandSize> in [CardGame.HUDBenchmark]; record one with CardGame.HUDBench record)")
+			: TEXT("PASSED"));
+	}
+	UE_LOG(LogTemp, Display, TEXT("==================================="));
+
+	CardHUDBenchmark::bLastRunPassed = bPassed;
+
+	if (Settings.bExitWhenDone)
+	{
+		FPlatformMisc::RequestExitWithStatus(false, bPassed ? 0 : 1);
+	}
+}
+
+bool FCardHUDBenchmark::WriteCsv(const FString& FilePath) const
+{
+	FString Csv = TEXT("HandSize,Frames,UpdateUIMeanMs,UpdateUIP95Ms,SlateMeanMs,SlateP95Ms,HUDFrameP50Ms,HUDFrameP95Ms,HUDFrameMaxMs,")
+		TEXT("FrameP50Ms,FrameP95Ms,PeakCardWidgets,WidgetsCreated,GCCount,GCMaxMs,GCTotalMs,BaselineP95Ms,Result\n");
+
+	for (const FSizeResult& Result : Results)
+	{
+		Csv += FString::Printf(TEXT("%d,%d,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%d,%d,%d,%.4f,%.4f,%.4f,%s\n"),
+			Result.HandSize, Result.HUDFrame.Num(),
+			Result.UpdateUI.GetMean() * 1000.0, Result.UpdateUI.GetPercentile(0.95) * 1000.0,
+			Result.Slate.GetMean() * 1000.0, Result.Slate.GetPercentile(0.95) * 1000.0,
+			Result.HUDFrame.GetPercentile(0.5) * 1000.0, Result.HUDFrame.GetPercentile(0.95) * 1000.0, Result.HUDFrame.GetPercentile(1.0) * 1000.0,
+			Result.Frame.GetPercentile(0.5) * 1000.0, Result.Frame.GetPercentile(0.95) * 1000.0,
+			Result.PeakCardWidgets, Result.WidgetsCreated,
+			Result.NumGC, Result.MaxGCSeconds * 1000.0, Result.TotalGCSeconds * 1000.0,
+			Result.BaselineP95Ms, Result.bRegressed ? TEXT("regressed") : Result.bMissingBaseline ? TEXT("no_baseline") : TEXT("ok"));
+	}
+
+	return FFileHelper::SaveStringToFile(Csv, *FilePath);
+}
+
+bool FCardHUDBenchmark::WriteBaselines(const FString& FilePath) const
+{
+	FString Ini = FString::Printf(TEXT("[%s]\n"), CardHUDBenchmark::BaselineSection);
+	for (const FSizeResult& Result : Results)
+	{
+		Ini += FString::Printf(TEXT("BaselineP95Ms_%d=%.3f\n"), Result.HandSize, Result.HUDFrame.GetPercentile(0.95) * 1000.0);
+	}
+
+	return FFileHelper::SaveStringToFile(Ini, *FilePath);
+}
+
+void FCardHUDBenchmark::OnSlatePreTick(float DeltaTime)
+{
+	SlateTickStartTime = FPlatformTime::Seconds();
+}
+
+void FCardHUDBenchmark::OnSlatePostTick(float DeltaTime)
+{
+	if (SlateTickStartTime > 0.0)
+	{
+		PendingSlateSeconds += FPlatformTime::Seconds() - SlateTickStartTime;
+		SlateTickStartTime = 0.0;
+	}
+}
+
+void FCardHUDBenchmark::OnWorldCleanup(UWorld* InWorld, bool bSessionEnded, bool bCleanupResources)
+{
+	if (InWorld != World.Get())
+	{
+		return;
+	}
+
+	if (!bFinished)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("CardHUDBenchmark: World is being cleaned up, aborting"));
+		Finish(true);
+	}
+
+	// 結束前 (例如 exit 後引擎關閉) Core Ticker 不一定還會執行，World 清除時直接釋放
+	if (CardHUDBenchmark::ActiveBenchmark.Get() == this)
+	{
+		CardHUDBenchmark::ActiveBenchmark.Reset();
+	}
+}
+
+void FCardHUDBenchmark::OnPreGarbageCollect()
+{
+	GCStartTime = FPlatformTime::Seconds();
+}
+
+void FCardHUDBenchmark::OnPostGarbageCollect()
+{
+	if (IsMeasuring() && GCStartTime > 0.0)
+	{
+		const double GCSeconds = FPlatformTime::Seconds() - GCStartTime;
+		FSizeResult& Result = Results.Last();
+		++Result.NumGC;
+		Result.MaxGCSeconds = FMath::Max(Result.MaxGCSeconds, GCSeconds);
+		Result.TotalGCSeconds += GCSeconds;
+	}
+	GCStartTime = 0.0;
+}
@@ -0,0 +1,144 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tickable.h"
+#include "Containers/Ticker.h"
+#include "CardGameHUD.h"
+#include "Sim/LatencySamples.h"
+
+/**
+ * FCardHUDBenchmarkSettings - HUD 效能測試參數
+ */
+struct FCardHUDBenchmarkSettings
+{
+	// 依序測試的手牌數
+	TArray<int32> HandSizes = { 10, 50, 200 };
+
+	// 每種手牌數先跑幾幀暖身 (不記錄)
+	int32 WarmupFrames = 30;
+
+	// 每種手牌數記錄的幀數
+	int32 MeasureFrames = 300;
+
+	// 腳本對戰的亂數種子
+	int32 Seed = 1;
+
+	// 結束後關閉程式 (有退步或缺少基準時結束代碼為 1，供 -nullrhi 的自動化流程使用)
+	bool bExitWhenDone = false;
+
+	// 在參考機器上記錄基準：不檢查，輸出可貼到 DefaultGame.ini 的 BaselineP95Ms_<手牌數>
+	bool bRecordBaselines = false;
+};
+
+/**
+ * FCardHUDBenchmark - 以腳本對戰驅動 UCardGameHUD 的效能測試
+ * 每種手牌數每幀打出一張牌並呼叫 UpdateUI，記錄 UpdateUI、Slate Tick、整幀時間、
+ * 卡牌 Widget 數與 GC 暫停，結果寫到 Saved/Benchmarks/，並以 DefaultGame.ini 的
+ * [CardGame.HUDBenchmark] 基準檢查 HUD 影格時間 (UpdateUI + Slate) 的 p95，沒有設定基準的手牌數視為失敗。
+ * 手牌超過 30 張時使用 Catalog 以外的不重複數值，與對戰一樣走以 CardValue 對應 Widget 的路徑
+ * (上限為 UCardGameHUD::MaxKeyedCardValue)。
+ */
+class CARDGAME_API FCardHUDBenchmark : public FTickableGameObject
+{
+public:
+	// 在 World 的 ACardBattle HUD 上開始測試 (已在執行或找不到 HUD 時回傳 false)
+	static bool Start(UWorld* World, const FCardHUDBenchmarkSettings& Settings);
+
+	static bool IsRunning();
+
+	// 最近一次完成的測試是否通過 (還沒有完成過時為 false)
+	static bool DidLastRunPass();
+
+	virtual ~FCardHUDBenchmark() override;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool IsTickable() const override { return !bFinished; }
+	virtual bool IsTickableWhenPaused() const override { return true; }
+
+private:
+	// 單一手牌數的結果
+	struct FSizeResult
+	{
+		int32 HandSize = 0;
+		FLatencySamples UpdateUI;
+		FLatencySamples Slate;
+		FLatencySamples HUDFrame;
+		FLatencySamples Frame;
+		int32 PeakCardWidgets = 0;
+		int32 WidgetsCreated = 0;
+		int32 NumGC = 0;
+		double MaxGCSeconds = 0.0;
+		double TotalGCSeconds = 0.0;
+		double BaselineP95Ms = 0.0;
+		bool bMissingBaseline = false;
+		bool bRegressed = false;
+	};
+
+	FCardHUDBenchmark(UWorld* InWorld, ACardBattle* InBattle, UCardGameHUD* InHUD, const FCardHUDBenchmarkSettings& InSettings);
+
+	// 開始下一種手牌數
+	void BeginSize();
+
+	// 發給雙方新的手牌並清空檯面
+	void DealHands();
+
+	// 輪到的玩家隨機打出一張牌
+	void PlayScriptedMove();
+
+	// 結束目前的手牌數並與基準比較
+	void FinishSize();
+
+	// 輸出結果並恢復 HUD，下一次 Core Ticker 時釋放測試物件
+	void Finish(bool bAborted);
+
+	// 解除所有委派並恢復 HUD (可重複呼叫)
+	void Unbind();
+
+	bool WriteCsv(const FString& FilePath) const;
+
+	// 以這次的 p95 寫出基準設定 (記錄模式)
+	bool WriteBaselines(const FString& FilePath) const;
+
+	void OnSlatePreTick(float DeltaTime);
+	void OnSlatePostTick(float DeltaTime);
+	void OnPreGarbageCollect();
+	void OnPostGarbageCollect();
+	void OnWorldCleanup(UWorld* InWorld, bool bSessionEnded, bool bCleanupResources);
+
+	bool IsMeasuring() const { return !bFinished && FrameIndex > Settings.WarmupFrames; }
+
+	FCardHUDBenchmarkSettings Settings;
+	TWeakObjectPtr<ACardBattle> Battle;
+	TWeakObjectPtr<UCardGameHUD> HUD;
+	TWeakObjectPtr<UWorld> World;
+
+	// HUD 顯示的腳本資料
+	FCardHUDDisplayOverride Display;
+	FRandomStream Random;
+
+	TArray<FSizeResult> Results;
+	int32 SizeIndex = INDEX_NONE;
+	int32 FrameIndex = 0;
+	int32 MoveIndex = 0;
+	int32 WidgetsCreatedAtStart = 0;
+
+	// 上一幀的量測 (在下一次 Tick 時記錄，才能包含該幀的 Slate 時間)
+	double LastTickTime = 0.0;
+	double PendingUpdateUISeconds = 0.0;
+	double PendingSlateSeconds = 0.0;
+	double SlateTickStartTime = 0.0;
+	double GCStartTime = 0.0;
+
+	bool bFinished = false;
+
+	FDelegateHandle SlatePreTickHandle;
+	FDelegateHandle SlatePostTickHandle;
+	FDelegateHandle PreGCHandle;
+	FDelegateHandle PostGCHandle;
+	FDelegateHandle WorldCleanupHandle;
+	FTSTicker::FDelegateHandle ReleaseTickerHandle;
+};
@@ -1,6 +1,7 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "CardWidget.h"
+#include "CardGame.h"
 #include "Engine/Texture2D.h"
 #include "Components/CanvasPanelSlot.h"
 #include "Components/PanelWidget.h"
@@ -9,7 +10,9 @@
 #include "Blueprint/WidgetBlueprintLibrary.h"
 #include "InputCoreTypes.h"
 #include "CardDragDropOperation.h"
+#include "CardWidgetPool.h"
 #include "Engine/Engine.h"
+#include "Sim/BattleTrace.h"
 
 void UCardWidget::NativeConstruct()
 {
@@ -17,8 +20,8 @@ void UCardWidget::NativeConstruct()
 
 	if (ClickButton)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("CardWidget: ClickButton found and bound!"));
-		ClickButton->OnClicked.AddDynamic(this, &UCardWidget::OnCardClicked);
+		FBattleTrace::Record(EBattleTraceEvent::CardWidgetBound, CardIndex);
+		ClickButton->OnClicked.AddUniqueDynamic(this, &UCardWidget::OnCardClicked);
 	}
 	else
 	{
@@ -68,7 +71,13 @@ void UCardWidget::NativeOnDragDetected(const FGeometry& InGeometry, const FPoint
 	DragOperation->Pivot = EDragPivot::CenterCenter;
 
 	UCardWidget* DragVisual = nullptr;
-	if (APlayerController* OwningPC = GetOwningPlayer())
+	if (UCardWidgetPool* Pool = OwningPool.Get())
+	{
+		// 拖曳結束時由 DragOperation 歸還
+		DragVisual = Pool->Acquire();
+		DragOperation->VisualPool = Pool;
+	}
+	else if (APlayerController* OwningPC = GetOwningPlayer())
 	{
 		DragVisual = CreateWidget<UCardWidget>(OwningPC, GetClass());
 	}
@@ -83,10 +92,15 @@ void UCardWidget::NativeOnDragDetected(const FGeometry& InGeometry, const FPoint
 		DragVisual->SetDraggable(false);
 		DragVisual->SetIsEnabled(false);
 		DragVisual->SetRenderOpacity(0.9f);
+		DragVisual->SetArtLoadPriority(ECardArtPriority::PlayerHand);
 
-		if (bHasCachedCardData)
+		if (DisplayedCardData == &OwnedCardData)
+		{
+			DragVisual->UpdateCardDisplay(OwnedCardData);
+		}
+		else
 		{
-			DragVisual->UpdateCardDisplay(CachedCardData);
+			DragVisual->SetCardData(DisplayedCardData);
 		}
 
 		DragOperation->DefaultDragVisual = DragVisual;
@@ -113,19 +127,37 @@ void UCardWidget::OnCardClicked()
 {
 	if (OnClicked.IsBound())
 	{
+		FBattleTrace::Record(EBattleTraceEvent::CardClicked, CardIndex, 1);
 		OnClicked.Execute(CardIndex);
-		UE_LOG(LogTemp, Warning, TEXT("CardWidget: Clicked! Index: %d"), CardIndex);
 	}
 	else
 	{
-		UE_LOG(LogTemp, Warning, TEXT("CardWidget: Clicked but no delegate bound! Index: %d"), CardIndex);
+		FBattleTrace::Record(EBattleTraceEvent::CardClicked, CardIndex, 0);
 	}
 }
 
 void UCardWidget::UpdateCardDisplay(const FCardData& CardData)
 {
-	CachedCardData = CardData;
-	bHasCachedCardData = true;
+	CARDGAME_SCOPE_CYCLE_COUNTER(UpdateCardDisplay);
+
+	OwnedCardData = CardData;
+	SetCardData(&OwnedCardData, true);
+}
+
+void UCardWidget::SetCardData(const FCardData* InCardData, bool bForceRefresh)
+{
+	if (!InCardData || (InCardData == DisplayedCardData && !bForceRefresh))
+	{
+		return;
+	}
+
+	DisplayedCardData = InCardData;
+	ApplyCardData();
+}
+
+void UCardWidget::ApplyCardData()
+{
+	const FCardData& CardData = *DisplayedCardData;
 
 	// 更新名稱
 	if (NameText)
@@ -145,37 +177,46 @@ void UCardWidget::UpdateCardDisplay(const FCardData& CardData)
 		DescriptionText->SetText(FText::FromString(CardData.Description));
 	}
 
-	// 更新卡牌圖片
+	// 更新卡牌圖片與背景 (非同步載入，完成前顯示佔位圖)
+	RequestCardArt();
+
+	// 每次更新資料後，重新套用目前的發光狀態（避免被重設）
+	ApplyGlowEffect();
+}
+
+void UCardWidget::RequestCardArt()
+{
+	// 取消上一份資料尚未完成的請求
+	CancelCardArtRequests();
+
+	const FCardData& CardData = *DisplayedCardData;
+	const uint32 RequestSerial = ++ArtRequestSerial;
+	TWeakObjectPtr<UCardWidget> WeakThis(this);
+
 	if (CardImage)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("CardWidget: CardImage widget found."));
 		if (!CardData.CardImage.IsNull())
 		{
-			UE_LOG(LogTemp, Warning, TEXT("CardWidget: Loading texture for card %s..."), *CardData.Name);
-			UTexture2D* Texture = CardData.CardImage.LoadSynchronous();
-			if (Texture)
+			// 尚未在記憶體中時，載入完成前先顯示佔位圖
+			if (!CardData.CardImage.Get())
 			{
-				CardImage->SetBrushFromTexture(Texture);
-				
+				CardImage->SetBrush(PlaceholderBrush);
 				ForceCardSize();
-
-				CardImage->SetBrushTintColor(FLinearColor::White);
-				CardImage->SetColorAndOpacity(FLinearColor::White);
-				CardImage->SetVisibility(ESlateVisibility::Visible);
-				
-				UE_LOG(LogTemp, Warning, TEXT("CardWidget: Texture loaded. Size: %dx%d."), 
-					Texture->GetSizeX(), 
-					Texture->GetSizeY()
-				);
-			}
-			else
-			{
-				UE_LOG(LogTemp, Error, TEXT("CardWidget: Failed to load texture!"));
 			}
+
+			CardImageLoadHandle = FCardArtLoader::RequestTexture(CardData.CardImage, ArtLoadPriority,
+				FCardArtLoader::FOnTextureLoaded::CreateLambda([WeakThis, RequestSerial](UTexture2D* Texture)
+				{
+					UCardWidget* Widget = WeakThis.Get();
+					if (Widget && Widget->ArtRequestSerial == RequestSerial)
+					{
+						Widget->OnCardImageLoaded(Texture);
+					}
+				}));
 		}
 		else
 		{
-			UE_LOG(LogTemp, Warning, TEXT("CardWidget: CardData.CardImage is NULL for card %s!"), *CardData.Name);
+			FBattleTrace::Record(EBattleTraceEvent::CardArtMissing, CardValue);
 		}
 	}
 	else
@@ -183,23 +224,82 @@ void UCardWidget::UpdateCardDisplay(const FCardData& CardData)
 		UE_LOG(LogTemp, Error, TEXT("CardWidget: CardImage widget NOT found! Check WBP_Card naming."));
 	}
 
-	// 更新背景圖片
-	if (BackgroundImage)
+	if (BackgroundImage && !CardData.BackgroundImage.IsNull())
 	{
-		if (!CardData.BackgroundImage.IsNull())
-		{
-			UTexture2D* BgTexture = CardData.BackgroundImage.LoadSynchronous();
-			if (BgTexture)
+		BackgroundLoadHandle = FCardArtLoader::RequestTexture(CardData.BackgroundImage, ArtLoadPriority,
+			FCardArtLoader::FOnTextureLoaded::CreateLambda([WeakThis, RequestSerial](UTexture2D* Texture)
 			{
-				BackgroundImage->SetBrushFromTexture(BgTexture);
-			}
-		}
+				UCardWidget* Widget = WeakThis.Get();
+				if (Widget && Widget->ArtRequestSerial == RequestSerial && Texture && Widget->BackgroundImage)
+				{
+					Widget->BackgroundImage->SetBrushFromTexture(Texture);
+				}
+			}));
 	}
+}
 
-	// 每次更新資料後，重新套用目前的發光狀態（避免被重設）
+void UCardWidget::OnCardImageLoaded(UTexture2D* Texture)
+{
+	if (!CardImage || !Texture)
+	{
+		// 載入失敗時保留佔位圖
+		return;
+	}
+
+	CardImage->SetBrushFromTexture(Texture);
+
+	ForceCardSize();
+
+	CardImage->SetBrushTintColor(FLinearColor::White);
+	CardImage->SetVisibility(ESlateVisibility::Visible);
+
+	// 重新套用發光狀態 (會設定 ColorAndOpacity)
 	ApplyGlowEffect();
 }
 
+void UCardWidget::CancelCardArtRequests()
+{
+	FCardArtLoader::CancelRequest(CardImageLoadHandle);
+	FCardArtLoader::CancelRequest(BackgroundLoadHandle);
+}
+
+void UCardWidget::ResetForPool()
+{
+	CancelCardArtRequests();
+	++ArtRequestSerial;
+
+	DisplayedCardData = nullptr;
+	CardIndex = -1;
+	CardValue = 0;
+	OnClicked.Unbind();
+	bIsDraggable = false;
+	ArtLoadPriority = ECardArtPriority::Board;
+
+	bLayoutTransitionPending = false;
+	LayoutTransitionElapsed = TNumericLimits<float>::Max();
+
+	SetRenderTransform(FWidgetTransform());
+	SetRenderTransformPivot(FVector2D(0.5f, 0.5f));
+	SetRenderOpacity(1.0f);
+	SetIsEnabled(true);
+	SetVisibility(ESlateVisibility::Visible);
+
+	bGlowEffectEnabled = false;
+	ApplyGlowEffect();
+}
+
+void UCardWidget::SetArtLoadPriority(ECardArtPriority InPriority)
+{
+	ArtLoadPriority = InPriority;
+}
+
+void UCardWidget::NativeDestruct()
+{
+	CancelCardArtRequests();
+
+	Super::NativeDestruct();
+}
+
 void UCardWidget::NativeOnMouseEnter(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent)
 {
 	Super::NativeOnMouseEnter(InGeometry, InMouseEvent);
@@ -212,6 +312,12 @@ void UCardWidget::NativeOnMouseLeave(const FPointerEvent& InMouseEvent)
 
 void UCardWidget::SetGlowEffectEnabled(bool bEnabled)
 {
+	// 狀態沒變時不重設顏色 (避免每次更新都讓 Slate 重繪)
+	if (bGlowEffectEnabled == bEnabled)
+	{
+		return;
+	}
+
 	bGlowEffectEnabled = bEnabled;
 	ApplyGlowEffect();
 }
@@ -257,6 +363,42 @@ void UCardWidget::ApplyGlowEffect()
 void UCardWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
 {
 	Super::NativeTick(MyGeometry, InDeltaTime);
+
+	if (bLayoutTransitionPending)
+	{
+		// 重新排版後的第一幀：把卡牌放回舊位置，再滑向新位置
+		bLayoutTransitionPending = false;
+
+		const FVector2D Offset = (LayoutTransitionFrom - MyGeometry.GetAbsolutePosition()) / MyGeometry.Scale;
+		if (!Offset.IsNearlyZero(0.5f))
+		{
+			LayoutTransitionOffset = Offset;
+			LayoutTransitionElapsed = 0.0f;
+			SetRenderTranslation(LayoutTransitionOffset);
+		}
+	}
+	else if (LayoutTransitionElapsed < LayoutTransitionDuration)
+	{
+		LayoutTransitionElapsed += InDeltaTime;
+
+		const float Alpha = FMath::Clamp(LayoutTransitionElapsed / LayoutTransitionDuration, 0.0f, 1.0f);
+		const float Remaining = 1.0f - FMath::InterpEaseOut(0.0f, 1.0f, Alpha, 2.0f);
+		SetRenderTranslation(LayoutTransitionOffset * Remaining);
+	}
+}
+
+void UCardWidget::BeginLayoutTransition()
+{
+	const FGeometry& Geometry = GetCachedGeometry();
+	if (Geometry.GetLocalSize().IsNearlyZero())
+	{
+		// 還沒排版過 (剛建立)，不需要動畫
+		return;
+	}
+
+	// 目前畫面上的位置 = 排版位置 + 尚未結束的位移
+	LayoutTransitionFrom = Geometry.GetAbsolutePosition() + GetRenderTransform().Translation * Geometry.Scale;
+	bLayoutTransitionPending = true;
 }
 
 void UCardWidget::ForceCardSize()
@@ -297,14 +439,14 @@ void UCardWidget::ForceCardSize()
 				SizeBox->SetHeightOverride(ImageHeight);
 				SizeBox->SetMinDesiredHeight(ImageHeight);
 				bIsInnerBox = false; // 下一個找到的 SizeBox 就是外層了
-				UE_LOG(LogTemp, Warning, TEXT("CardWidget: Inner SizeBox set to %fx%f"), CardWidth, ImageHeight);
+				FBattleTrace::Record(EBattleTraceEvent::CardResized, FMath::RoundToInt(CardWidth), FMath::RoundToInt(ImageHeight), 1);
 			}
 			else
 			{
 				// 外層 SizeBox (Root)：設定為完整卡牌高度
 				SizeBox->SetHeightOverride(CardHeight);
 				SizeBox->SetMinDesiredHeight(CardHeight);
-				UE_LOG(LogTemp, Warning, TEXT("CardWidget: Outer SizeBox set to %fx%f"), CardWidth, CardHeight);
+				FBattleTrace::Record(EBattleTraceEvent::CardResized, FMath::RoundToInt(CardWidth), FMath::RoundToInt(CardHeight), 0);
 			}
 
 			SizeBox->SetMinDesiredWidth(CardWidth);
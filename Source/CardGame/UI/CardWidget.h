@@ -8,6 +8,7 @@
 #include "Components/TextBlock.h"
 #include "Components/Image.h"
 #include "Components/Button.h"
+#include "CardArtLoader.h"
 #include "CardWidget.generated.h"
 
 DECLARE_DELEGATE_OneParam(FOnCardClicked, int32);
@@ -22,15 +23,35 @@ class CARDGAME_API UCardWidget : public UUserWidget
 	GENERATED_BODY()
 	
 public:
-	// 更新卡牌顯示
+	// 更新卡牌顯示 (Blueprint 用，會複製一份資料)
 	UFUNCTION(BlueprintCallable, Category = "Card")
 	void UpdateCardDisplay(const FCardData& CardData);
 
+	// 以 Catalog 中的穩定指標設定卡牌資料；與目前相同時不做任何事
+	void SetCardData(const FCardData* InCardData, bool bForceRefresh = false);
+
+	// 目前顯示的卡牌資料
+	const FCardData* GetCardData() const { return DisplayedCardData; }
+
 	// 強制設置卡牌大小
 	void ForceCardSize();
 
+	// 記錄目前位置，下次排版後從這裡滑到新位置 (手牌增減時使用)
+	void BeginLayoutTransition();
+
+	// 回到物件池前重設所有狀態
+	void ResetForPool();
+
+	// 建立這個 Widget 的物件池 (不是由池建立時為 nullptr)
+	class UCardWidgetPool* GetOwningPool() const { return OwningPool.Get(); }
+	void SetOwningPool(class UCardWidgetPool* InPool) { OwningPool = InPool; }
+
+	// 設定卡牌圖片的載入優先順序 (在 SetCardData 前設定才會套用到該次請求)
+	void SetArtLoadPriority(ECardArtPriority InPriority);
+
 	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
 	virtual void NativeConstruct() override;
+	virtual void NativeDestruct() override;
 	virtual FReply NativeOnPreviewMouseButtonDown(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent) override;
 	virtual FReply NativeOnMouseButtonDown(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent) override;
 	virtual void NativeOnDragDetected(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent, UDragDropOperation*& OutOperation) override;
@@ -78,13 +99,54 @@ protected:
 	// 實際套用發光外觀
 	void ApplyGlowEffect();
 
-	// 快取目前顯示資料，供拖曳視覺複製使用
-	FCardData CachedCardData;
-	bool bHasCachedCardData = false;
+	// 將卡牌資料套用到 UI 元件
+	void ApplyCardData();
+
+	// 非同步請求卡牌圖片與背景圖
+	void RequestCardArt();
+
+	// 卡牌圖片載入完成
+	void OnCardImageLoaded(class UTexture2D* Texture);
+
+	// 取消尚未完成的圖片請求
+	void CancelCardArtRequests();
+
+	// 圖片載入完成前顯示的佔位圖
+	UPROPERTY(EditAnywhere, Category = "Card")
+	FSlateBrush PlaceholderBrush;
+
+	// 圖片載入優先順序 (由 HUD 依卡牌位置設定)
+	ECardArtPriority ArtLoadPriority = ECardArtPriority::Board;
+
+	// 尚未完成的載入請求
+	TSharedPtr<FStreamableHandle> CardImageLoadHandle;
+	TSharedPtr<FStreamableHandle> BackgroundLoadHandle;
+
+	// 每次請求遞增，用來丟棄已過期的回調
+	uint32 ArtRequestSerial = 0;
+
+	// 排版位置改變時滑動到新位置的時間 (秒)
+	UPROPERTY(EditAnywhere, Category = "Card")
+	float LayoutTransitionDuration = 0.15f;
+
+	// 滑動動畫狀態
+	bool bLayoutTransitionPending = false;
+	FVector2D LayoutTransitionFrom = FVector2D::ZeroVector;
+	FVector2D LayoutTransitionOffset = FVector2D::ZeroVector;
+	float LayoutTransitionElapsed = TNumericLimits<float>::Max();
+
+	// 目前顯示的資料 (通常指向 UCardCatalogSubsystem 內的資料)
+	const FCardData* DisplayedCardData = nullptr;
+
+	// 由 Blueprint 傳入的資料拷貝
+	FCardData OwnedCardData;
 
 	// 是否啟用發光
 	bool bGlowEffectEnabled = false;
 
+	// 所屬的物件池 (拖曳顯示也從這裡取得)
+	TWeakObjectPtr<class UCardWidgetPool> OwningPool;
+
 public:
 	// 設定點擊回調
 	void SetOnClicked(FOnCardClicked InOnClicked);
@@ -95,6 +157,9 @@ public:
 	// 儲存卡牌索引，方便回傳
 	int32 CardIndex = -1;
 
+	// 顯示中的卡牌數值 (HUD 以此作為 Widget 的 key)
+	int32 CardValue = 0;
+
 	// 是否允許拖曳
 	bool bIsDraggable = false;
 };
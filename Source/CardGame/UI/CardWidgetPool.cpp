@@ -0,0 +1,156 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CardWidgetPool.h"
+#include "CardGame.h"
+#include "CardWidget.h"
+#include "Blueprint/UserWidget.h"
+#include "Components/PanelWidget.h"
+
+void UCardWidgetPool::Initialize(UUserWidget* InOwningWidget, TSubclassOf<UCardWidget> InWidgetClass)
+{
+	OwningWidget = InOwningWidget;
+
+	if (WidgetClass != InWidgetClass)
+	{
+		// 類別不同的舊 Widget 不能再使用；使用中的會在歸還時被丟棄
+		for (UCardWidget* Widget : FreeWidgets)
+		{
+			AllWidgets.Remove(Widget);
+		}
+		DEC_DWORD_STAT_BY(STAT_CardGame_WidgetsPooled, FreeWidgets.Num());
+		TRACE_COUNTER_SUBTRACT(CardGame_WidgetsPooled, FreeWidgets.Num());
+		FreeWidgets.Reset();
+		WidgetClass = InWidgetClass;
+	}
+}
+
+void UCardWidgetPool::BeginDestroy()
+{
+	// 閒置中的 Widget 隨著池一起釋放
+	DEC_DWORD_STAT_BY(STAT_CardGame_WidgetsPooled, FreeWidgets.Num());
+	TRACE_COUNTER_SUBTRACT(CardGame_WidgetsPooled, FreeWidgets.Num());
+	FreeWidgets.Reset();
+
+	Super::BeginDestroy();
+}
+
+void UCardWidgetPool::Prewarm(int32 Count)
+{
+	while (AllWidgets.Num() < Count)
+	{
+		UCardWidget* Widget = CreateCardWidget();
+		if (!Widget)
+		{
+			break;
+		}
+
+		FreeWidgets.Add(Widget);
+		INC_DWORD_STAT(STAT_CardGame_WidgetsPooled);
+		TRACE_COUNTER_INCREMENT(CardGame_WidgetsPooled);
+	}
+}
+
+UCardWidget* UCardWidgetPool::Acquire()
+{
+	UCardWidget* Widget = nullptr;
+	if (FreeWidgets.Num() > 0)
+	{
+		Widget = FreeWidgets.Pop(EAllowShrinking::No);
+		++Stats.NumHits;
+		INC_DWORD_STAT(STAT_CardGame_WidgetsReused);
+		TRACE_COUNTER_INCREMENT(CardGame_WidgetsReused);
+		DEC_DWORD_STAT(STAT_CardGame_WidgetsPooled);
+		TRACE_COUNTER_DECREMENT(CardGame_WidgetsPooled);
+	}
+	else
+	{
+		Widget = CreateCardWidget();
+		if (!Widget)
+		{
+			return nullptr;
+		}
+		++Stats.NumMisses;
+	}
+
+	++Stats.NumInUse;
+	Stats.PeakInUse = FMath::Max(Stats.PeakInUse, Stats.NumInUse);
+	return Widget;
+}
+
+void UCardWidgetPool::Release(UCardWidget* Widget)
+{
+	if (!Widget)
+	{
+		return;
+	}
+
+	Widget->RemoveFromParent();
+
+	// 不是這個池建立的，或是類別已經換掉的 Widget 直接丟棄
+	if (Widget->GetOwningPool() != this || Widget->GetClass() != WidgetClass.Get())
+	{
+		AllWidgets.Remove(Widget);
+		return;
+	}
+
+	if (FreeWidgets.Contains(Widget))
+	{
+		return;
+	}
+
+	Widget->ResetForPool();
+	FreeWidgets.Add(Widget);
+	INC_DWORD_STAT(STAT_CardGame_WidgetsPooled);
+	TRACE_COUNTER_INCREMENT(CardGame_WidgetsPooled);
+
+	++Stats.NumReleases;
+	Stats.NumInUse = FMath::Max(Stats.NumInUse - 1, 0);
+}
+
+void UCardWidgetPool::ReleaseChildren(UPanelWidget* Panel, int32 FirstIndex)
+{
+	if (!Panel)
+	{
+		return;
+	}
+
+	for (int32 i = Panel->GetChildrenCount() - 1; i >= FMath::Max(FirstIndex, 0); --i)
+	{
+		UWidget* Child = Panel->GetChildAt(i);
+		if (UCardWidget* Widget = Cast<UCardWidget>(Child))
+		{
+			Release(Widget);
+		}
+		else
+		{
+			Panel->RemoveChildAt(i);
+		}
+	}
+}
+
+void UCardWidgetPool::LogStats() const
+{
+	UE_LOG(LogTemp, Display, TEXT("CardWidgetPool: %d hits, %d misses, %d releases, %d created, %d in use (peak %d), %d free."),
+		Stats.NumHits, Stats.NumMisses, Stats.NumReleases, Stats.NumCreated, Stats.NumInUse, Stats.PeakInUse, FreeWidgets.Num());
+}
+
+UCardWidget* UCardWidgetPool::CreateCardWidget()
+{
+	UUserWidget* Owner = OwningWidget.Get();
+	if (!Owner || !WidgetClass)
+	{
+		return nullptr;
+	}
+
+	UCardWidget* Widget = CreateWidget<UCardWidget>(Owner, WidgetClass);
+	if (Widget)
+	{
+		Widget->SetOwningPool(this);
+		AllWidgets.Add(Widget);
+		++Stats.NumCreated;
+		INC_DWORD_STAT(STAT_CardGame_WidgetsCreated);
+		TRACE_COUNTER_INCREMENT(CardGame_WidgetsCreated);
+	}
+
+	return Widget;
+}
@@ -0,0 +1,87 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "CardWidgetPool.generated.h"
+
+class UCardWidget;
+class UPanelWidget;
+class UUserWidget;
+
+/**
+ * FCardWidgetPoolStats - Widget 池使用統計
+ */
+struct FCardWidgetPoolStats
+{
+	// 從池中取得 (不需建立) 的次數
+	int32 NumHits = 0;
+
+	// 池中沒有可用 Widget、必須 CreateWidget 的次數
+	int32 NumMisses = 0;
+
+	// 歸還次數
+	int32 NumReleases = 0;
+
+	// 建立過的 Widget 總數 (含預熱)
+	int32 NumCreated = 0;
+
+	// 目前使用中 / 最高同時使用數
+	int32 NumInUse = 0;
+	int32 PeakInUse = 0;
+};
+
+/**
+ * UCardWidgetPool - UCardWidget 物件池
+ * 由 UCardGameHUD 擁有，手牌、檯面與拖曳顯示共用同一批 Widget。
+ * 所有 Widget 都被池保留引用，對戰期間不會產生卡牌 Widget 的垃圾。
+ */
+UCLASS()
+class CARDGAME_API UCardWidgetPool : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	// 設定建立 Widget 用的擁有者與類別 (類別改變時會丟棄池中閒置的 Widget)
+	void Initialize(UUserWidget* InOwningWidget, TSubclassOf<UCardWidget> InWidgetClass);
+
+	// 預先建立 Widget，直到池中總數達到 Count
+	void Prewarm(int32 Count);
+
+	// 取得一個已重設的 Widget (池空時才建立新的)
+	UCardWidget* Acquire();
+
+	// 歸還 Widget (會從父容器移除並重設狀態)
+	void Release(UCardWidget* Widget);
+
+	// 歸還容器中從 FirstIndex 開始的所有子元件 (卡牌 Widget 回到池中)
+	void ReleaseChildren(UPanelWidget* Panel, int32 FirstIndex = 0);
+
+	int32 GetNumFree() const { return FreeWidgets.Num(); }
+	const FCardWidgetPoolStats& GetStats() const { return Stats; }
+
+	// 輸出到日誌
+	void LogStats() const;
+
+	virtual void BeginDestroy() override;
+
+private:
+	UCardWidget* CreateCardWidget();
+
+	// 建立 Widget 時的擁有者 (HUD)
+	TWeakObjectPtr<UUserWidget> OwningWidget;
+
+	UPROPERTY()
+	TSubclassOf<UCardWidget> WidgetClass;
+
+	// 閒置的 Widget
+	UPROPERTY()
+	TArray<TObjectPtr<UCardWidget>> FreeWidgets;
+
+	// 池建立過的所有 Widget (保持引用，避免被 GC)
+	UPROPERTY()
+	TArray<TObjectPtr<UCardWidget>> AllWidgets;
+
+	FCardWidgetPoolStats Stats;
+};